@@ -9,14 +9,18 @@
 #ifndef _BKLLeftNormalForm_h_
 #define _BKLLeftNormalForm_h_
 
+#include <list>
+#include <set>
+#include <unordered_map>
+#include <utility>
+
 #include "tuples.h"
-#include "Permutation.h"
+#include "bkl_simple_element.h"
+#include "braid_group.h"
 
-// #include "vector"
-#include "list"
 using namespace std ;
+using crag::braidgroup::BKLSimpleElement;
 
-class BraidGroup;
 class Word;
 
 
@@ -28,7 +32,8 @@ class Word;
 //! Birman-Ko-Lee left normal form. 
 /*! 
   The standard presentation for BKL is a pair \f$(p,(\xi_1,\ldots,\xi_m))\f$, where \f$p\in \mathbb{Z}\f$ and
-  each \f$\xi_i \in S_n\f$ is a permutation.
+  each \f$\xi_i\f$ is a simple element of the BKL structure, a product of parallel descending cycles
+  (see BKLSimpleElement).
 */
 
 class BKLLeftNormalForm
@@ -42,7 +47,7 @@ class BKLLeftNormalForm
     The second component specifies  the power of the twist.
     The third component specifies the list of braid permutations.
   */
-  typedef triple< int , int , list< Permutation > > NF;
+  typedef triple< int , int , list< BKLSimpleElement > > NF;
   
   /////////////////////////////////////////////////////////
   //                                                     //
@@ -52,7 +57,8 @@ class BKLLeftNormalForm
 
 
   //! Create trivial normal form  
-  BKLLeftNormalForm( ) :
+  BKLLeftNormalForm( int rank=0 ) :
+    theRank( rank ) ,
     theOmegaPower( 0 ) { }
     
     
@@ -63,7 +69,7 @@ class BKLLeftNormalForm
     theDecomposition( bkl.theDecomposition ) { }
     
   //! Create normal form by its presentation (no check that given presentation is correct, use adjustDecomposition if the presentation is incorrect).
-  BKLLeftNormalForm( int rank , int p , const list< Permutation >& d ) : 
+  BKLLeftNormalForm( int rank , int p , const list< BKLSimpleElement >& d ) : 
     theRank( rank ) ,
     theOmegaPower( p ) ,
     theDecomposition( d ) { }
@@ -76,7 +82,10 @@ class BKLLeftNormalForm
 
 
   //! Create a normal form of a braid word.
-  BKLLeftNormalForm( const BraidGroup& G , const Word& w );
+  BKLLeftNormalForm( const crag::braidgroup::BraidGroup& G , const Word& w );
+
+  //! Create a normal form of a simple element.
+  explicit BKLLeftNormalForm( const BKLSimpleElement& s );
 
 
   //! Assignment operator.
@@ -84,6 +93,7 @@ class BKLLeftNormalForm
     theRank = bkl.theRank;
     theOmegaPower = bkl.theOmegaPower;
     theDecomposition = bkl.theDecomposition;
+    return *this;
   }
   
   
@@ -92,6 +102,7 @@ class BKLLeftNormalForm
     theRank = bkl.first;
     theOmegaPower = bkl.second;
     theDecomposition = bkl.third;
+    return *this;
   }
   
   
@@ -123,29 +134,41 @@ class BKLLeftNormalForm
   //! Get the power of omega.  
   int getPower( ) const { return theOmegaPower; }
   //! Get the decomposition.
-  const list< Permutation >& getDecomposition( ) const { return theDecomposition; }
+  const list< BKLSimpleElement >& getDecomposition( ) const { return theDecomposition; }
 
   //! Get the presentation of the normal form
   operator NF( ) const { return NF( theRank , theOmegaPower , theDecomposition ); }
 
+  //! Get the rank of the braid group.
+  int getRank( ) const { return theRank; }
+
   //! Check if the normal form os trivial.
   bool isTrivial( ) const { return theOmegaPower==0 && theDecomposition.size()==0; }
 
   //! Returns a cyclic permutation \f$\delta = (1,2,3,\ldots,n-1,0)\f$.
-  static Permutation getTinyTwistPermutation( int theIndex ) {
-    Permutation result( theIndex );
-    for( int i=0 ; i<theIndex ; ++i )
-      result[i] = (i+theIndex-1)%theIndex;
-    return result;
+  static BKLSimpleElement getTinyTwistPermutation( int theIndex ) {
+    return BKLSimpleElement::getTinyTwist( theIndex );
   }
 
+  //! Hash of the normal form composed from the hashes of its factors (see BKLSimpleElement::hash).
+  size_t hash( ) const;
+
 
   //! Return a word represented by the normal form.
   Word getWord( ) const;
   
   
   //! Check if two normal forms are conjugate.
-  pair< bool , Word > areConjugate( const BKLLeftNormalForm& bkl ) const;
+  /*!
+    Constructs the super summit sets of both braids (moving between their elements by minimal simple summit
+    conjugators) until they meet, at most 1000000 elements of each set are processed.
+    @return - a pair (R,C), where R is true if braids are conjugate, and C is a conjugator, i.e., \f$C^{-1} \cdot this \cdot C = bkl\f$.
+    R is also false if the sets have not met within time_sec_bound seconds or within the bound on the elements.
+  */
+  pair< bool , BKLLeftNormalForm > areConjugate( const BKLLeftNormalForm& bkl , int time_sec_bound=999999 ) const;
+
+  //! Conjugate the normal form by a simple element, i.e., compute \f$s^{-1} \cdot this \cdot s\f$.
+  BKLLeftNormalForm conjugate( const BKLSimpleElement& s ) const;
   
   //! Cycle operation.
   pair< BKLLeftNormalForm , BKLLeftNormalForm > cycle( ) const;
@@ -168,7 +191,7 @@ class BKLLeftNormalForm
     { theOmegaPower = p; }
 
   //! Set the decomposition \f$(\xi_1,\ldots,\xi_m)\f$. The result might be an incorrect form (not satisfying some gready conditions of this BKL form).
-  inline void setDecomposition( const list< Permutation >& d )
+  inline void setDecomposition( const list< BKLSimpleElement >& d )
     { theDecomposition = d; }
   
   /////////////////////////////////////////////////////////
@@ -191,21 +214,27 @@ class BKLLeftNormalForm
   //! The result of the transformation.
   enum transformationResult { TWO_MULTIPLIERS , ONE_MULTIPLIER , NO_CHANGE };
   //! Main function for computing the normal form of the word.
-  static transformationResult transform ( int theIndex , Permutation& p1 , Permutation& p2 );
+  static transformationResult transform ( int theIndex , BKLSimpleElement& p1 , BKLSimpleElement& p2 );
 
 
-  //! Function returns a set of permutation braids (well, permutations) such that ... Must be checked
-  static set<Permutation> getSimpleConjugators( const NF& bkl );
+  //! Returns the minimal simple element c divisible by start such that \f$\inf(c^{-1} \cdot this \cdot c) \geq \inf(this)\f$.
+  BKLSimpleElement getSimpleConjugator( const BKLSimpleElement& start ) const;
+
+
+  //! Returns the minimal simple element c divisible by start such that \f$c^{-1} \cdot this \cdot c\f$ belongs to the super summit set (*this must belong to it).
+  BKLSimpleElement getSimpleSummitConjugator( const BKLSimpleElement& start ) const;
+
+
+  //! Returns the minimal simple summit conjugators for all band generators (*this must belong to the super summit set).
+  set<BKLSimpleElement> getSimpleSummitConjugators( ) const;
 
 
-  //! Function returns a set of permutation braids (well, permutations) such that ... Must be checked
-  static set<Permutation> getSimpleSummitConjugators( const NF& bkl );
 
   
   //! Function adjusting the decomposition in a normal form.
   static void adjustDecomposition( int rank ,
 				   int& power ,
-				   list<Permutation>& decomp );
+				   list<BKLSimpleElement>& decomp );
   // this function transforms any (reasonable) decomposition
   // to a decomposition of a normal form 
 
@@ -224,11 +253,21 @@ class BKLLeftNormalForm
   int theOmegaPower;
 
   //! Sequence of permutations.
-  list< Permutation > theDecomposition;
+  list< BKLSimpleElement > theDecomposition;
   
 };
 
 
 ostream& operator << ( ostream& os, const BKLLeftNormalForm& bkl );
 
+
+namespace std {
+template <>
+struct hash< BKLLeftNormalForm > {
+  size_t operator()( const BKLLeftNormalForm& bkl ) const {
+    return bkl.hash( );
+  }
+};
+}
+
 #endif
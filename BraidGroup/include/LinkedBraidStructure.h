@@ -3,52 +3,53 @@
 #ifndef CRAG_LINKED_BRAID_STRUCTURE_H
 #define CRAG_LINKED_BRAID_STRUCTURE_H
 
+#include <cstdint>
 #include <list>
-#include <map>
 #include <ostream>
-#include <set>
 #include <tuple>
 #include <vector>
 
 #include "Word.h"
 
+//! A crossing of a LinkedBraidStructure.
+/*!
+  Nodes live in an arena of the structure (a vector indexed by the node numbers), so the links to the neighbouring
+  crossings are indices in the arena (kNone if there is no neighbour) rather than pointers.
+  The numbers of erased nodes are reused by the new ones in the LIFO order, so undoing transforms
+  in the reverse order (see LinkedBraidStructure::undo) restores the same numbers.
+*/
 struct BraidNode {
 public:
+  using Index = std::int32_t;
+
+  static const Index kNone = -1;
+
   BraidNode(
-      int64_t num = 0, bool tp = true, BraidNode* l = nullptr, BraidNode* a = nullptr, BraidNode* r = nullptr,
-      BraidNode* bl = nullptr, BraidNode* b = nullptr, BraidNode* br = nullptr)
+      bool tp = true, Index l = kNone, Index a = kNone, Index r = kNone, Index bl = kNone, Index b = kNone,
+      Index br = kNone)
       : left(l)
       , ahead(a)
       , right(r)
       , back_left(bl)
       , back(b)
       , back_right(br)
-      , type(tp)
-      , link(nullptr)
-      , weight(0)
-      , theNumber(num) {}
+      , heap_index(kNone)
+      , type(tp) {}
 
 public:
-  BraidNode* left;
-  BraidNode* ahead;
-  BraidNode* right;
+  Index left;
+  Index ahead;
+  Index right;
+
+  Index back_left;
+  Index back;
+  Index back_right;
 
-  BraidNode* back_left;
-  BraidNode* back;
-  BraidNode* back_right;
+  // auxiliary member, the position of the node in the queue of nodes to check in remove Handle functions
+  Index heap_index;
 
   // shows whether a crossing positive or negative
   bool type;
-
-  // auxiliary member, used in LinkedBraidStructure copy constructor and in
-  // translateIntoWord
-  mutable BraidNode* link;
-
-  // auxiliary member, used in remove Handle functions
-  mutable int64_t weight;
-
-  // a unique number associated with the node in a LBS
-  int64_t theNumber;
 };
 
 std::ostream& operator<<(std::ostream& os, const BraidNode& bn);
@@ -95,9 +96,6 @@ public:
   LinkedBraidStructure(size_t N);
   LinkedBraidStructure(size_t N, const Word& w);
 
-  LinkedBraidStructure(const LinkedBraidStructure& LBS);
-  LinkedBraidStructure& operator=(const LinkedBraidStructure& LBS);
-
 public:
   // function check if the braid-word represented by *this is shortlex smaller
   // than the one given by lbs, usually the computation of the words is not
@@ -105,7 +103,7 @@ public:
   bool operator<(const LinkedBraidStructure& lbs) const;
 
   size_t size() const {
-    return the_nodes_.size();
+    return size_;
   }
 
   void clear();
@@ -122,52 +120,58 @@ public:
   void undo(const LinkedBraidStructureTransform& lbst);
 
 private:
-  using NODE = std::tuple<int64_t, int64_t, BraidNode*>;
+  using Index = BraidNode::Index;
 
-  struct NodeCompare {
-    using int64_triple = std::tuple<int64_t, int64_t, int64_t>;
+  //! A node which may start a handle, nodes are checked in the order of (weight, position, number).
+  struct NODE {
+    int64_t weight;
+    int64_t pos;
+    Index node;
 
-    bool operator()(const NODE& lhs, const NODE& rhs) const {
-      return std::less<int64_triple>()(toInt64Triple_(lhs), toInt64Triple_(rhs));
-    }
-
-    int64_triple toInt64Triple_(const NODE& n) const {
-      return std::make_tuple(std::get<0>(n), std::get<1>(n), std::get<2>(n)->theNumber);
+    bool operator<(const NODE& n) const {
+      return std::tie(weight, pos, node) < std::tie(n.weight, n.pos, n.node);
     }
   };
 
-  using node_set = std::set<NODE, NodeCompare>;
+  //! Priority queue of NODEs, every node keeps its position in the queue (BraidNode::heap_index).
+  class NodeHeap;
 
-  LinkedBraidStructureTransform make_EraseTransform(BraidNode* bn, int64_t pos) const;
-  LinkedBraidStructureTransform make_AddTransform(BraidNode* bn, int64_t pos) const;
-  LinkedBraidStructureTransform make_ChangeType(BraidNode* bn, int64_t pos) const;
+  LinkedBraidStructureTransform make_EraseTransform(Index bn, int64_t pos) const;
+  LinkedBraidStructureTransform make_AddTransform(Index bn, int64_t pos) const;
+  LinkedBraidStructureTransform make_ChangeType(Index bn, int64_t pos) const;
 
-  int64_t checkIfStartsLeftHandle(int64_t pos, BraidNode* bn);
-  int64_t checkIfStartsRightHandle(int64_t pos, BraidNode* bn);
+  int64_t checkIfStartsLeftHandle(int64_t pos, Index bn) const;
+  int64_t checkIfStartsRightHandle(int64_t pos, Index bn) const;
 
-  void removeLeftHandle(NODE node, node_set& to_check, std::list<LinkedBraidStructureTransform>* lst);
-  void removeRightHandle(NODE node, node_set& to_check, std::list<LinkedBraidStructureTransform>* lst);
+  void removeLeftHandle(const NODE& node, NodeHeap& to_check, std::list<LinkedBraidStructureTransform>* lst);
+  void removeRightHandle(const NODE& node, NodeHeap& to_check, std::list<LinkedBraidStructureTransform>* lst);
 
-  LinkedBraidStructureTransform removeNode(BraidNode* bn, int64_t pos);
+  LinkedBraidStructureTransform removeNode(Index bn, int64_t pos);
 
-  BraidNode* insertBackRight(BraidNode* bn, int64_t pos, bool type);
-  BraidNode* insertBackLeft(BraidNode* bn, int64_t pos, bool type);
-  BraidNode* insert(const LinkedBraidStructureTransform& lbst);
+  //! Places a new node into the last freed slot of the arena or appends it.
+  Index newNode(const BraidNode& node);
 
-  void processTree(int al, BraidNode* node, Word& result) const;
+  Index insertBackRight(Index bn, int64_t pos, bool type);
+  Index insertBackLeft(Index bn, int64_t pos, bool type);
+  Index insert(const LinkedBraidStructureTransform& lbst);
 
-  void clearLinks() const;
+  void processTree(int al, Index node, std::vector<bool>& visited, Word& result) const;
 
 private:
   //! Number of generators!!!
   size_t the_index_;
 
-  std::vector<BraidNode*> front_nodes_;
-  std::vector<BraidNode*> back_nodes_;
+  std::vector<Index> front_nodes_;
+  std::vector<Index> back_nodes_;
+
+  //! All nodes, indexed by their numbers.
+  std::vector<BraidNode> the_nodes_;
 
-  std::map<int64_t, BraidNode> the_nodes_;
+  //! Numbers of erased nodes, the last one is reused first.
+  std::vector<Index> free_nodes_;
 
-  int64_t max_node_number_;
+  //! Number of alive nodes.
+  size_t size_;
 };
 
 //! Compares two braids using LinkedBraidStructure.
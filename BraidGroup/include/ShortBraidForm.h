@@ -12,6 +12,12 @@ class LinkedBraidStructure;
 Word shortenBraid(int N, const Word &w);
 //! Attempt to reduce |w| using Dehornoy handle free form (for longer words)
 Word shortenBraid2(int n, const Word &w);
+//! Same as shortenBraid2, but the segments of each level are shortened in parallel.
+/*!
+  If adaptive is false, the result is the same as the one of shortenBraid2. Otherwise
+  the levels following the ones where shortening stopped paying off are skipped.
+*/
+Word parallelShortenBraid2(int n, const Word &w, bool adaptive = false);
 //! Compute normal form for w and then shorten the result
 Word shortBraidForm( int N , const Word& w );
 
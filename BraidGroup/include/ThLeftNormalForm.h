@@ -13,6 +13,7 @@
 #include <vector>
 #include <list>
 #include <set>
+#include <unordered_map>
 
 #include "tuples.h"
 #include "Permutation.h"
@@ -50,9 +51,9 @@ class ThLeftNormalForm
   /*!
     The first  component specifies the rank  of a braid group.
     The second component specifies the power of the half twist.
-    The third  component specifies the list  of braid permutations.
+    The third  component specifies the sequence of braid permutations (stored contiguously).
   */
-  typedef triple< int , int , list< Permutation > > NF;
+  typedef triple< int , int , vector< Permutation > > NF;
   
   /////////////////////////////////////////////////////////
   //                                                     //
@@ -85,7 +86,7 @@ class ThLeftNormalForm
     There is no check that the pair (p,d) defines a correct normal form representation.
     If you are not sure if (p,d) is correct apply static function adjustDecomposition first.
   */
-  ThLeftNormalForm( int rank , int p , const list< Permutation >& d ) : 
+  ThLeftNormalForm( int rank , int p , const vector< Permutation >& d ) : 
     theRank( rank ),
     theOmegaPower( p ) ,
     theDecomposition( d ) { }
@@ -203,7 +204,11 @@ public:
   //! Get half-twist power.
   inline int getPower( ) const { return theOmegaPower; }
   //! Get a list of permutations.
-  inline const list< Permutation >& getDecomposition( ) const { return theDecomposition; }
+  inline const vector< Permutation >& getDecomposition( ) const { return theDecomposition; }
+
+
+  //! Hash of the normal form composed from the hashes of its factors (see Permutation::hash).
+  size_t hash( ) const;
   
   
   //! Check if a normal form is trivial
@@ -235,7 +240,7 @@ public:
   Word getReducedWord2() const;
 
 
-  static void adjustDecomposition( int rank , int& power , list<Permutation>& decomp );
+  static void adjustDecomposition( int rank , int& power , vector<Permutation>& decomp );
   
   void adjust( ) { adjustDecomposition( theRank , theOmegaPower , theDecomposition ); }
   
@@ -324,21 +329,15 @@ public:
 
  private:
 
-  //! (Aux, USS)
-  pair< bool , ThLeftNormalForm > 
-    ussConstructionIteration( map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_new1 , 
-			      map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_checked1 , 
-			      const map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_new2 , 
-			      const map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_checked2 ) const;
 
 
   //! (Aux, USS)
   pair< bool , ThLeftNormalForm > 
     ussAddTrajectory( const ThLeftNormalForm& new_elt , const ThLeftNormalForm& new_conjugator , 
-		      map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_new1 , 
-		      map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_checked1 , 
-		      const map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_new2 , 
-		      const map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_checked2 ) const;
+		      unordered_map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_new1 , 
+		      unordered_map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_checked1 , 
+		      const unordered_map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_new2 , 
+		      const unordered_map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_checked2 ) const;
 
   
   /////////////////////////////////////////////////////////
@@ -351,7 +350,7 @@ public:
   
   inline void setPower( int p )
     { theOmegaPower = p; }
-  inline void setDecomposition( const list< Permutation >& d )
+  inline void setDecomposition( const vector< Permutation >& d )
     { theDecomposition = d; }
 
   /////////////////////////////////////////////////////////
@@ -463,7 +462,7 @@ public:
   int theOmegaPower;
 
   //! Sequence of permutations.
-  list< Permutation > theDecomposition;
+  vector< Permutation > theDecomposition;
   
 };
 
@@ -471,4 +470,14 @@ public:
 ostream& operator << ( ostream& os, const ThLeftNormalForm& rep );
 
 
+namespace std {
+
+template <>
+struct hash< ThLeftNormalForm > {
+  size_t operator()( const ThLeftNormalForm& nf ) const {
+    return nf.hash( );
+  }
+};
+} // namespace std
+
 #endif
@@ -12,6 +12,7 @@
 #include <vector>
 #include <list>
 #include <set>
+#include <unordered_map>
 
 #include "tuples.h"
 #include "Permutation.h"
@@ -46,9 +47,9 @@ public:
   /*!
     The first  component specifies the rank  of a braid group.
     The second component specifies the power of the half twist.
-    The third  component specifies the list  of braid permutations.
+    The third  component specifies the sequence of braid permutations (stored contiguously).
   */
-  typedef triple< int , int , list< Permutation > > NF;
+  typedef triple< int , int , vector< Permutation > > NF;
   
   /////////////////////////////////////////////////////////
   //                                                     //
@@ -66,7 +67,8 @@ public:
   ThRightNormalForm( int rank=0 ) : 
     theRank( rank ) ,
     theOmegaPower( 0 ) ,
-    theDecomposition( ) { }
+    theDecomposition( ) ,
+    theFlipped( false ) { }
     
     
   //! Constructor (rank specifies the rank of a braid group the form belongs to, p - a power of a half twist, and d - a list of permutations. So the pair (p,d) is a presentation)
@@ -74,17 +76,19 @@ public:
     There is no check that the pair (p,d) defines a correct normal form representation.
     If you are not sure if (p,d) is correct apply static function adjustDecomposition first.
   */
-  ThRightNormalForm( int rank , int p , const list< Permutation >& d ) : 
+  ThRightNormalForm( int rank , int p , const vector< Permutation >& d ) : 
     theRank( rank ),
     theOmegaPower( p ) ,
-    theDecomposition( d ) { }
+    theDecomposition( d ) ,
+    theFlipped( false ) { }
 
 
   //! Constructor (tr specifies a presentation of the normal form)
   ThRightNormalForm( const NF& tr ) : 
     theRank( tr.first ),
     theOmegaPower( tr.second ) ,
-    theDecomposition( tr.third ) { }
+    theDecomposition( tr.third ) ,
+    theFlipped( false ) { }
     
     
   //! Constructs the normal form of a braid word w.
@@ -92,7 +96,8 @@ public:
   
   
   //! Construct a positive braid from a permutation
-  ThRightNormalForm( const Permutation& p ) {
+  ThRightNormalForm( const Permutation& p ) : 
+    theFlipped( false ) {
     theRank = p.size( );
     Permutation omega = Permutation::getHalfTwistPermutation( theRank );
     if( p.isTrivial( ) ) {
@@ -111,6 +116,7 @@ public:
     theRank = tr.first;
     theOmegaPower = tr.second;
     theDecomposition = tr.third;
+    theFlipped = false;
     return *this;
   }
   
@@ -125,12 +131,15 @@ public:
 
   //! Cast operator (returns a representation of a normal form)
   operator NF( ) const {
+    applyFlip_( );
     return NF( theRank , theOmegaPower , theDecomposition );
   }
   
   
   //! Compare (check if equal)
   bool operator == ( const ThRightNormalForm& rep ) const {
+    applyFlip_( );
+    rep.applyFlip_( );
     return 
       theRank==rep.theRank && 
       theOmegaPower==rep.theOmegaPower && 
@@ -140,6 +149,8 @@ public:
   
   //! Compare (check if not equal)
   bool operator != ( const ThRightNormalForm& rep ) const {
+    applyFlip_( );
+    rep.applyFlip_( );
     return 
       theRank!=rep.theRank ||
       theOmegaPower!=rep.theOmegaPower || 
@@ -148,6 +159,8 @@ public:
   
   //! Compare (check if less, performed componentwise)
   bool operator < ( const ThRightNormalForm& rep ) const {
+    applyFlip_( );
+    rep.applyFlip_( );
     if( theRank<rep.theRank )
       return true;
     if( theRank>rep.theRank )
@@ -192,7 +205,11 @@ public:
   //! Get half-twist power.
   inline int getPower( ) const { return theOmegaPower; }
   //! Get a list of permutations.
-  inline const list< Permutation >& getDecomposition( ) const { return theDecomposition; }
+  inline const vector< Permutation >& getDecomposition( ) const { applyFlip_( ); return theDecomposition; }
+
+
+  //! Hash of the normal form composed from the hashes of its factors (see Permutation::hash).
+  size_t hash( ) const;
   
 
   //! Check if a normal form is trivial
@@ -248,7 +265,7 @@ public:
   /*!
     Use this function if the triple of arguments does not satisfy "greedy conditions".
    */
-  static void adjustDecomposition( int rank , int& power , list<Permutation>& decomp );
+  static void adjustDecomposition( int rank , int& power , vector<Permutation>& decomp );
 
   //! Adjust a normal form
   /*!
@@ -258,6 +275,7 @@ public:
     This function uses adjustDecomposition( ... ).
   */
   void adjust( ) {
+    applyFlip_( );
     adjustDecomposition( theRank , theOmegaPower , theDecomposition );
   }
 
@@ -421,8 +439,50 @@ public:
 
   //! Set a power of a half-twist.
   inline void setPower( int p ) { theOmegaPower = p; }
+  
+  
   //! Set a decomposition of a normal form (without any check of "greedy conditions"). 
-  inline void setDecomposition( const list< Permutation >& d ) { theDecomposition = d; }
+  inline void setDecomposition( const vector< Permutation >& d ) { theDecomposition = d; theFlipped = false; }
+  
+  
+  /////////////////////////////////////////////////////////
+  //                                                     //
+  //  Incremental multiplication:                        //
+  //                                                     //
+  /////////////////////////////////////////////////////////
+public:
+
+  //! Multiply the braid by a generator on the right (negative gen stands for the inverse generator).
+  /*!
+    The normal form is updated incrementally: the time is proportional to the number of factors that change
+    (usually a few) rather than to the length of the normal form.
+   */
+  void push_back( int gen );
+  
+  
+  //! Multiply the braid by a generator on the left (negative gen stands for the inverse generator).
+  /*!
+    Only the affected factors change. For an inverse generator a half twist is moved through all
+    the factors, which only toggles a flag: the factors are flipped when the decomposition is read.
+   */
+  void push_front( int gen );
+  
+  
+  //! Multiply the braid by a simple element (permutation braid) on the right, see push_back( ).
+  void multiplyRight( const Permutation& s );
+  
+  
+  //! Multiply the braid by a simple element (permutation braid) on the left, see push_front( ).
+  void multiplyLeft( const Permutation& s );
+  
+  
+  //! Conjugate the braid by a simple element: \f$a \mapsto s^{-1} a s\f$.
+  void conjugate( const Permutation& s );
+  
+  
+  //! Conjugate the braid by a generator: \f$a \mapsto x_{gen}^{-1} a x_{gen}\f$.
+  void conjugate( int gen );
+  
   
   /////////////////////////////////////////////////////////
   //                                                     //
@@ -440,16 +500,35 @@ private:
   NF multiply( const ThRightNormalForm& rep ) const;
   
   
+  //! Multiply by the inverse of a simple element on the right.
+  void multiplyRightByInverse_( const Permutation& s );
+  
+  
+  //! Multiply by the inverse of a simple element on the left.
+  void multiplyLeftByInverse_( const Permutation& s );
+
+
+  //! Flip the stored factors if a half twist was moved through them (see theFlipped).
+  void applyFlip_( ) const {
+    if( !theFlipped )
+      return;
+    for( vector< Permutation >::iterator it=theDecomposition.begin( ) ; it!=theDecomposition.end( ) ; ++it )
+      *it = (*it).flip( );
+    theFlipped = false;
+  }
+
+
+  //! Get the i-th factor without flipping the whole decomposition.
+  Permutation factor_( size_t i ) const {
+    return theFlipped ? theDecomposition[i].flip( ) : theDecomposition[i];
+  }
+  
+  
   //! The main function which "canonify" a product of two permutations.
   enum transformationResult { TWO_MULTIPLIERS , ONE_MULTIPLIER , NO_CHANGE };
   static transformationResult transform ( int theIndex , Permutation& p1 , Permutation& p2 );
   
 
-  //! I think function processes a vertex in a Super Summit Set graph.
-  pair< bool , ThRightNormalForm > sssConstructionIteration( map< ThRightNormalForm , ThRightNormalForm >& sss_new1 ,
-							     map< ThRightNormalForm , ThRightNormalForm >& sss_checked1 ,
-							     const map< ThRightNormalForm , ThRightNormalForm >& sss_new2 ,
-							     const map< ThRightNormalForm , ThRightNormalForm >& sss_checked2 ) const;
   
   /////////////////////////////////////////////////////////
   //                                                     //
@@ -465,8 +544,16 @@ private:
   //! Power of omega.
   int theOmegaPower;
 
-  //! Sequence of permutations.
-  list< Permutation > theDecomposition;
+  //! Sequence of permutations (flipped if theFlipped is set, mutable for applyFlip_).
+  mutable vector< Permutation > theDecomposition;
+
+  //! True if the actual factors are the flips of the stored ones.
+  /*!
+    Moving a half twist through the decomposition flips every factor. The incremental multiplication
+    only toggles this flag and works with the stored factors (the transformations commute with flips),
+    all other functions call applyFlip_( ) before reading the factors.
+   */
+  mutable bool theFlipped;
   
 };
 
@@ -474,4 +561,14 @@ private:
 ostream& operator << ( ostream& os, const ThRightNormalForm& nf );
 
 
+namespace std {
+
+template <>
+struct hash< ThRightNormalForm > {
+  size_t operator()( const ThRightNormalForm& nf ) const {
+    return nf.hash( );
+  }
+};
+} // namespace std
+
 #endif
@@ -0,0 +1,165 @@
+#pragma once
+
+#ifndef CRAG_BATCH_IDENTITY_CHECK_H
+#define CRAG_BATCH_IDENTITY_CHECK_H
+
+#include <boost/container/vector.hpp>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "LinkedBraidStructure.h"
+#include "fast_identity_check.h"
+#include "parallel.h"
+
+namespace crag {
+namespace braidgroup {
+
+//! Counters of the stages of BatchIdentityChecker.
+struct IdentityCheckStats {
+  //! Number of words passed through the colored Burau filter.
+  size_t filtered = 0;
+
+  //! Number of words found non-trivial by the filter.
+  size_t filter_rejected = 0;
+
+  //! Number of words passed through handle reduction.
+  size_t reduced = 0;
+
+  //! Number of words found non-trivial by handle reduction.
+  size_t reduction_rejected = 0;
+};
+
+//! Exact identity checker for batches of braid words.
+/*!
+  Runs FastIdentityChecker on all words of a batch in parallel first and handle reduction (see isTrivialBraid)
+  only on the words that passed the filter, the latter is exact but much slower.
+  Words are grouped, a group is trivial iff all its words are, once one word of a group is rejected
+  the remaining words of the group are skipped.
+
+  The checker can be shared by several threads, the counters are accumulated over all calls.
+*/
+template <typename T>
+class BatchIdentityChecker {
+public:
+  explicit BatchIdentityChecker(size_t n)
+      : n_(n)
+      , filter_(n) {}
+
+  BatchIdentityChecker(size_t n, size_t seed)
+      : n_(n)
+      , filter_(n, seed) {}
+
+  //! Returns the vector r with r[i] == true iff words[i] is the trivial braid.
+  boost::container::vector<bool> areTrivial(const std::vector<Word>& words) const {
+    std::vector<size_t> groups(words.size());
+
+    for (size_t i = 0; i < groups.size(); ++i) {
+      groups[i] = i;
+    }
+
+    return check_(words, groups, words.size());
+  }
+
+  //! Returns the vector r with r[i] == true iff all words of batches[i] are trivial braids.
+  boost::container::vector<bool> areAllTrivial(const std::vector<std::vector<Word>>& batches) const {
+    std::vector<Word> words;
+    std::vector<size_t> groups;
+
+    for (size_t i = 0; i < batches.size(); ++i) {
+      words.insert(words.end(), batches[i].begin(), batches[i].end());
+      groups.insert(groups.end(), batches[i].size(), i);
+    }
+
+    return check_(words, groups, batches.size());
+  }
+
+  //! Checks if all words are trivial braids.
+  bool areAllTrivial(const std::vector<Word>& words) const {
+    return check_(words, std::vector<size_t>(words.size(), 0), 1)[0];
+  }
+
+  IdentityCheckStats stats() const {
+    IdentityCheckStats result;
+    result.filtered = filtered_;
+    result.filter_rejected = filter_rejected_;
+    result.reduced = reduced_;
+    result.reduction_rejected = reduction_rejected_;
+    return result;
+  }
+
+  void resetStats() {
+    filtered_ = 0;
+    filter_rejected_ = 0;
+    reduced_ = 0;
+    reduction_rejected_ = 0;
+  }
+
+private:
+  size_t n_;
+  FastIdentityChecker<T> filter_;
+
+  mutable std::atomic<size_t> filtered_{0};
+  mutable std::atomic<size_t> filter_rejected_{0};
+  mutable std::atomic<size_t> reduced_{0};
+  mutable std::atomic<size_t> reduction_rejected_{0};
+
+  //! groups[i] is the index of the group of words[i].
+  boost::container::vector<bool>
+  check_(const std::vector<Word>& words, const std::vector<size_t>& groups, size_t groups_count) const {
+    // value-initialized, i.e., false
+    std::unique_ptr<std::atomic<bool>[]> rejected(new std::atomic<bool>[groups_count]());
+
+    // 1. colored Burau filter
+    const auto passed = parallel::bmap(words.size(), [&](size_t i) {
+      if (rejected[groups[i]]) {
+        return false;
+      }
+
+      ++filtered_;
+
+      if (filter_.isNonTrivial(words[i])) {
+        ++filter_rejected_;
+        rejected[groups[i]] = true;
+        return false;
+      }
+
+      return true;
+    });
+
+    // 2. handle reduction of the survivors
+    std::vector<size_t> survivors;
+
+    for (size_t i = 0; i < words.size(); ++i) {
+      if (passed[i] && !rejected[groups[i]]) {
+        survivors.push_back(i);
+      }
+    }
+
+    parallel::forEach(survivors, [&](size_t, size_t i) {
+      if (rejected[groups[i]]) {
+        return;
+      }
+
+      ++reduced_;
+
+      if (!isTrivialBraid(n_, words[i])) {
+        ++reduction_rejected_;
+        rejected[groups[i]] = true;
+      }
+    });
+
+    boost::container::vector<bool> result(groups_count);
+
+    for (size_t i = 0; i < groups_count; ++i) {
+      result[i] = !rejected[i];
+    }
+
+    return result;
+  }
+};
+} // namespace braidgroup
+} // namespace crag
+
+#endif // CRAG_BATCH_IDENTITY_CHECK_H
@@ -0,0 +1,138 @@
+#pragma once
+
+#ifndef CRAG_BKL_SIMPLE_ELEMENT_H
+#define CRAG_BKL_SIMPLE_ELEMENT_H
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <vector>
+
+#include "Permutation.h"
+
+namespace crag {
+namespace braidgroup {
+
+//! Simple element of the Birman-Ko-Lee (dual) Garside structure of the braid group.
+/*!
+  A simple element is a product of parallel descending cycles, i.e., a non-crossing partition of {0,...,n-1}:
+  the block \f$\{a_1 < \ldots < a_k\}\f$ stands for the cycle \f$a_k \to a_{k-1} \to \ldots \to a_1 \to a_k\f$
+  (the permutation convention is the one of Permutation, the tiny twist \f$\delta\f$ maps i to i-1 mod n).
+  The partition is kept as an array of block minima, which is canonical, so equality and hashing are linear.
+
+  Left and right divisibility of simple elements both coincide with the refinement of partitions,
+  so meet (gcd) and join (lcm) are computed directly on the partitions in O(n alpha(n)) time without lookup tables.
+  Products and quotients go through permutations and take O(n) time, they throw if the result is not simple.
+*/
+class BKLSimpleElement {
+public:
+  //! Maximal rank, block minima are kept as 16-bit numbers.
+  static const size_t kMaxRank = 1 << 16;
+
+  //! Creates the trivial element of rank 0.
+  BKLSimpleElement()
+    : BKLSimpleElement(0) {}
+
+  //! Creates the trivial element of the specified rank. Throws if rank > kMaxRank.
+  explicit BKLSimpleElement(size_t rank);
+
+  //! Creates the element by a permutation, throws if it is not a product of parallel descending cycles.
+  explicit BKLSimpleElement(const Permutation& p);
+
+  //! The band generator \f$a_{ts}\f$ (the transposition of s and t, s != t).
+  static BKLSimpleElement band(size_t rank, size_t s, size_t t);
+
+  //! The tiny twist \f$\delta\f$ (the partition with one block).
+  static BKLSimpleElement getTinyTwist(size_t rank);
+
+  size_t size() const {
+    return min_.size();
+  }
+
+  //! The smallest point of the block containing i.
+  size_t blockMin(size_t i) const {
+    return min_[i];
+  }
+
+  bool isTrivial() const;
+
+  bool isTinyTwist() const;
+
+  //! Length in band generators (n minus the number of blocks).
+  size_t length() const;
+
+  Permutation toPermutation() const;
+
+  bool operator==(const BKLSimpleElement& s) const {
+    return min_ == s.min_;
+  }
+
+  bool operator!=(const BKLSimpleElement& s) const {
+    return min_ != s.min_;
+  }
+
+  //! Compares sizes first, then block minima lexicographically.
+  bool operator<(const BKLSimpleElement& s) const;
+
+  //! Product as permutations, (p * q)[i] = q[p[i]]. Throws if the product is not simple.
+  BKLSimpleElement operator*(const BKLSimpleElement& s) const;
+
+  BKLSimpleElement& operator*=(const BKLSimpleElement& s) {
+    return *this = *this * s;
+  }
+
+  //! Returns \f$d^{-1} \cdot this\f$. Throws if d is not a divisor of *this.
+  BKLSimpleElement leftQuotient(const BKLSimpleElement& d) const;
+
+  //! Returns \f$this^{-1} \cdot \delta\f$ (the Kreweras complement).
+  BKLSimpleElement rightComplement() const;
+
+  //! Returns \f$\delta \cdot this^{-1}\f$.
+  BKLSimpleElement leftComplement() const;
+
+  //! Conjugates by the tiny twist, the same as Permutation::tinyFlip (rotates the partition by sh).
+  BKLSimpleElement tinyFlip(int sh) const;
+
+  //! The greatest common divisor (the common refinement of the partitions).
+  BKLSimpleElement meet(const BKLSimpleElement& s) const;
+
+  //! The least common multiple (the finest non-crossing partition coarser than both).
+  BKLSimpleElement join(const BKLSimpleElement& s) const;
+
+  //! Checks if *this divides s (i.e., *this refines s).
+  bool divides(const BKLSimpleElement& s) const {
+    return meet(s) == *this;
+  }
+
+  //! A word in Artin generators, see Permutation::getWordPresentation.
+  std::vector<int> getWordPresentation() const {
+    return toPermutation().getWordPresentation();
+  }
+
+  size_t hash() const;
+
+private:
+  //! Permutation values of the element.
+  std::vector<int> values_() const;
+
+  //! Creates the element by the values of a permutation, if check is true throws if it is not simple.
+  static BKLSimpleElement fromValues_(const std::vector<int>& values, bool check);
+
+  std::vector<std::uint16_t> min_;
+};
+
+std::ostream& operator<<(std::ostream& os, const BKLSimpleElement& s);
+
+} // namespace braidgroup
+} // namespace crag
+
+namespace std {
+template <>
+struct hash<crag::braidgroup::BKLSimpleElement> {
+  size_t operator()(const crag::braidgroup::BKLSimpleElement& s) const {
+    return s.hash();
+  }
+};
+} // namespace std
+
+#endif // CRAG_BKL_SIMPLE_ELEMENT_H
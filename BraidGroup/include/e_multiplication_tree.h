@@ -0,0 +1,268 @@
+#pragma once
+
+#ifndef CRAG_E_MULTIPLICATION_TREE_H
+#define CRAG_E_MULTIPLICATION_TREE_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Word.h"
+#include "packed_colored_burau.h"
+
+namespace crag {
+namespace coloredburau {
+
+//! Segment tree of E-multiplications by the blocks of a braid word w, used to project local modifications of w.
+/*!
+  The word is split into blocks of letters (the leaves). A node stores the segment (E, id) * u of its subword u
+  (see PackedCBProjectionElement::operator*=(const PackedCBProjectionElement&)) computed with the t-values
+  permuted by the letters preceding u, so the root is the projection (E, id) * w.
+
+  The letters are kept as they are, i.e., the sequence is not freely reduced after replacements
+  (the projection does not depend on it), and all positions refer to this sequence.
+
+  Replacing a subword by a word with the same permutation (e.g., a letter by its inverse) recomputes
+  the affected blocks and their ancestors, i.e., takes O(b n + log(|w| / b) n^3) time for blocks of size b.
+  Other replacements change the t-values of all segments to the right, so these segments are recomputed too.
+*/
+template <typename T>
+class EMultiplicationTree {
+public:
+  //! Builds the tree for the word w, block_size == 0 stands for n^2 letters.
+  EMultiplicationTree(std::vector<T> t_values, const Word& w, size_t block_size = 0)
+      : t_values_(std::move(t_values))
+      , block_size_(block_size ? block_size : t_values_.size() * t_values_.size()) {
+    build_(w.toVector());
+  }
+
+  const std::vector<T>& tValues() const {
+    return t_values_;
+  }
+
+  //! Number of letters (of the sequence returned by letters()).
+  size_t length() const {
+    return lengths_[1];
+  }
+
+  //! The current sequence of letters, not necessarily freely reduced.
+  std::vector<int> letters() const {
+    std::vector<int> result;
+    result.reserve(length());
+
+    for (const auto& block : blocks_) {
+      result.insert(result.end(), block.begin(), block.end());
+    }
+
+    return result;
+  }
+
+  //! Returns (E, id) * w.
+  const PackedCBProjectionElement<T>& projection() const {
+    return nodes_[1];
+  }
+
+  //! Returns (E, id) * w' for w' = w[0, pos) * u * w[pos + len, |w|), the tree is not modified.
+  /*!
+    Takes O(b n + log(|w| / b) n^3) time if u has the same permutation as w[pos, pos + len), and O(|w| n) otherwise.
+  */
+  PackedCBProjectionElement<T> projectReplaced(size_t pos, size_t len, const Word& u) const {
+    checkRange_(pos, len);
+
+    const auto first = findBlock_(pos);
+    const auto last = findBlock_(pos + len);
+
+    const auto& first_block = blocks_[first.first];
+    const auto& last_block = blocks_[last.first];
+
+    PackedCBProjectionElement<T> result(t_values_);
+
+    // 1. the blocks to the left are not changed
+    forEachNode_(0, first.first, [&](size_t node) { result *= nodes_[node]; });
+
+    // 2. the changed blocks
+    result.multiply(first_block.begin(), first_block.begin() + first.second);
+    result *= u;
+    result.multiply(last_block.begin() + last.second, last_block.end());
+
+    // 3. the blocks to the right are reused while the permutation agrees with the one of w
+    bool agrees = true;
+
+    forEachNode_(last.first + 1, leaves_, [&](size_t node) {
+      agrees = agrees && result.isContinuedBy(nodes_[node]);
+
+      if (agrees) {
+        result *= nodes_[node];
+      } else {
+        forEachBlock_(node, [&](const std::vector<int>& block) { result.multiply(block.begin(), block.end()); });
+      }
+    });
+
+    return result;
+  }
+
+  //! Replaces w[pos, pos + len) by u.
+  void replace(size_t pos, size_t len, const Word& u) {
+    checkRange_(pos, len);
+
+    const auto first = findBlock_(pos);
+    const auto last = findBlock_(pos + len);
+
+    // the new letters go to the first block, the other affected blocks become empty
+    std::vector<int> block(blocks_[first.first].begin(), blocks_[first.first].begin() + first.second);
+    const auto& u_letters = u.toVector();
+    block.insert(block.end(), u_letters.begin(), u_letters.end());
+    block.insert(block.end(), blocks_[last.first].begin() + last.second, blocks_[last.first].end());
+
+    for (auto i = first.first + 1; i <= last.first; ++i) {
+      blocks_[i].clear();
+      markDirty_(leaves_ + i);
+    }
+
+    blocks_[first.first] = std::move(block);
+    markDirty_(leaves_ + first.first);
+
+    // keep the blocks balanced
+    if (blocks_[first.first].size() > 4 * block_size_) {
+      build_(letters());
+      return;
+    }
+
+    update_(1, t_values_);
+  }
+
+private:
+  std::vector<T> t_values_;
+  size_t block_size_;
+
+  //! Number of leaves, a power of 2.
+  size_t leaves_;
+
+  std::vector<std::vector<int>> blocks_;
+
+  //! Nodes of the tree, the root is nodes_[1], the children of i are 2i and 2i + 1, leaves start at leaves_.
+  std::vector<PackedCBProjectionElement<T>> nodes_;
+
+  //! Number of letters in the subtree of a node.
+  std::vector<size_t> lengths_;
+
+  std::vector<char> dirty_;
+
+  void build_(const std::vector<int>& letters) {
+    const auto blocks_count = std::max<size_t>(1, (letters.size() + block_size_ - 1) / block_size_);
+
+    leaves_ = 1;
+    while (leaves_ < blocks_count) {
+      leaves_ *= 2;
+    }
+
+    blocks_.assign(leaves_, std::vector<int>());
+
+    for (size_t i = 0; i < blocks_count; ++i) {
+      const auto begin = letters.begin() + std::min(letters.size(), i * block_size_);
+      const auto end = letters.begin() + std::min(letters.size(), (i + 1) * block_size_);
+      blocks_[i].assign(begin, end);
+    }
+
+    nodes_.assign(2 * leaves_, PackedCBProjectionElement<T>(t_values_));
+    lengths_.assign(2 * leaves_, 0);
+    dirty_.assign(2 * leaves_, true);
+
+    update_(1, t_values_);
+  }
+
+  void markDirty_(size_t node) {
+    for (; node > 0; node /= 2) {
+      dirty_[node] = true;
+    }
+  }
+
+  //! Recomputes the nodes which are dirty or were computed with other t-values.
+  void update_(size_t node, const std::vector<T>& t_values) {
+    if (!dirty_[node] && nodes_[node].tValues() == t_values) {
+      return;
+    }
+
+    if (node >= leaves_) {
+      const auto& block = blocks_[node - leaves_];
+
+      nodes_[node] = PackedCBProjectionElement<T>(t_values);
+      nodes_[node].multiply(block.begin(), block.end());
+      lengths_[node] = block.size();
+    } else {
+      update_(2 * node, t_values);
+      update_(2 * node + 1, nodes_[2 * node].currentTValues());
+
+      nodes_[node] = nodes_[2 * node];
+      nodes_[node] *= nodes_[2 * node + 1];
+      lengths_[node] = lengths_[2 * node] + lengths_[2 * node + 1];
+    }
+
+    dirty_[node] = false;
+  }
+
+  void checkRange_(size_t pos, size_t len) const {
+    if (pos + len > length()) {
+      throw std::out_of_range("The replaced subword is out of the word.");
+    }
+  }
+
+  //! Returns (block, offset) of the letter at position pos (the end of the word is the end of the last block).
+  std::pair<size_t, size_t> findBlock_(size_t pos) const {
+    size_t node = 1;
+
+    while (node < leaves_) {
+      if (pos < lengths_[2 * node] || lengths_[2 * node + 1] == 0) {
+        node = 2 * node;
+      } else {
+        pos -= lengths_[2 * node];
+        node = 2 * node + 1;
+      }
+    }
+
+    return std::make_pair(node - leaves_, pos);
+  }
+
+  //! Invokes fn for the nodes covering the blocks [from, to) from left to right.
+  template <typename Function>
+  void forEachNode_(size_t from, size_t to, Function fn) const {
+    forEachNode_(1, 0, leaves_, from, to, fn);
+  }
+
+  template <typename Function>
+  void forEachNode_(size_t node, size_t begin, size_t end, size_t from, size_t to, Function& fn) const {
+    if (to <= begin || end <= from || lengths_[node] == 0) {
+      return;
+    }
+
+    if (from <= begin && end <= to) {
+      fn(node);
+      return;
+    }
+
+    const auto middle = (begin + end) / 2;
+    forEachNode_(2 * node, begin, middle, from, to, fn);
+    forEachNode_(2 * node + 1, middle, end, from, to, fn);
+  }
+
+  //! Invokes fn for the blocks of the subtree of a node from left to right.
+  template <typename Function>
+  void forEachBlock_(size_t node, Function fn) const {
+    size_t begin = node;
+    size_t end = node + 1;
+
+    while (begin < leaves_) {
+      begin *= 2;
+      end *= 2;
+    }
+
+    for (auto i = begin; i < end; ++i) {
+      fn(blocks_[i - leaves_]);
+    }
+  }
+};
+} // namespace coloredburau
+} // namespace crag
+
+#endif // CRAG_E_MULTIPLICATION_TREE_H
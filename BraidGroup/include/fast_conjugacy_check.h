@@ -7,6 +7,7 @@
 
 #include "colored_burau.h"
 #include "matrix.h"
+#include "packed_colored_burau.h"
 
 namespace crag {
 namespace braidgroup {
@@ -31,20 +32,20 @@ public:
   }
 
 private:
-  coloredburau::CBProjectionElement<T> unit_;
+  coloredburau::PackedCBProjectionElement<T> unit_;
 
   template <typename URNG>
-  coloredburau::CBProjectionElement<T> getUnitEl_(size_t n, URNG& g) const {
+  coloredburau::PackedCBProjectionElement<T> getUnitEl_(size_t n, URNG& g) const {
     if (n < 3) {
       throw std::invalid_argument("Expect n to be greater or equal to 3.");
     }
 
     std::vector<T> t_values(n, finitefield::generateNonZeroNonUnit<T>(g));
 
-    return coloredburau::CBProjectionElement<T>(std::move(t_values));
+    return coloredburau::PackedCBProjectionElement<T>(std::move(t_values));
   }
 
-  coloredburau::CBProjectionElement<T> getUnitEl_(size_t n, size_t seed) const {
+  coloredburau::PackedCBProjectionElement<T> getUnitEl_(size_t n, size_t seed) const {
     std::mt19937_64 g(seed);
     return getUnitEl_(n, g);
   }
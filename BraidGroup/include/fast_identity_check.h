@@ -6,6 +6,8 @@
 #include <boost/functional/hash.hpp>
 
 #include "colored_burau.h"
+#include "e_multiplication_tree.h"
+#include "packed_colored_burau.h"
 
 namespace crag {
 namespace braidgroup {
@@ -31,11 +33,22 @@ public:
     return unit_ != (unit_ * w);
   }
 
+  //! Prepares w for checking its local modifications, see isNonTrivial(tree, pos, len, u).
+  coloredburau::EMultiplicationTree<T> tree(const Word& w) const {
+    return coloredburau::EMultiplicationTree<T>(unit_.tValues(), w);
+  }
+
+  //! The same as isNonTrivial(w[0, pos) * u * w[pos + len, |w|)), where w is the word of the tree,
+  //! the tree must be made by this checker.
+  bool isNonTrivial(const coloredburau::EMultiplicationTree<T>& tree, size_t pos, size_t len, const Word& u) const {
+    return unit_ != tree.projectReplaced(pos, len, u);
+  }
+
 private:
-  coloredburau::CBProjectionElement<T> unit_;
+  coloredburau::PackedCBProjectionElement<T> unit_;
 
   template <typename URNG>
-  coloredburau::CBProjectionElement<T> getUnitEl_(size_t n, URNG& g) const {
+  coloredburau::PackedCBProjectionElement<T> getUnitEl_(size_t n, URNG& g) const {
     if (n < 3) {
       throw std::invalid_argument("Expect n to be greater or equal to 3.");
     }
@@ -47,10 +60,10 @@ private:
       t_values.push_back(finitefield::generateNonZeroNonUnit<T>(g));
     }
 
-    return coloredburau::CBProjectionElement<T>(std::move(t_values));
+    return coloredburau::PackedCBProjectionElement<T>(std::move(t_values));
   }
 
-  coloredburau::CBProjectionElement<T> getUnitEl_(size_t n, size_t seed) const {
+  coloredburau::PackedCBProjectionElement<T> getUnitEl_(size_t n, size_t seed) const {
     std::mt19937_64 g(seed);
     return getUnitEl_(n, g);
   }
@@ -59,7 +72,7 @@ private:
 //! Computes the hash of CBProjectionElement<T> corresponding to a word w.
 template <typename T>
 size_t projectionHash(const Word& w, const std::vector<T>& t_values) {
-  return std::hash<coloredburau::CBProjectionElement<T>>()(coloredburau::project(w, t_values));
+  return std::hash<coloredburau::PackedCBProjectionElement<T>>()(coloredburau::projectPacked(w, t_values));
 }
 
 template <typename T>
@@ -84,6 +97,17 @@ public:
     return projectionHash(w, t_values);
   }
 
+  //! Prepares w for hashing its local modifications, see operator()(tree, pos, len, u).
+  coloredburau::EMultiplicationTree<T> tree(const Word& w) const {
+    return coloredburau::EMultiplicationTree<T>(t_values, w);
+  }
+
+  //! Returns the hash of w[0, pos) * u * w[pos + len, |w|), where w is the word of the tree,
+  //! the tree must be made by this hasher.
+  braid_hash_t operator()(const coloredburau::EMultiplicationTree<T>& tree, size_t pos, size_t len, const Word& u) const {
+    return std::hash<coloredburau::PackedCBProjectionElement<T>>()(tree.projectReplaced(pos, len, u));
+  }
+
   braid_hash_t operator()(const std::vector<Word>& words) const {
     std::vector<braid_hash_t> hashes;
     hashes.reserve(words.size());
@@ -0,0 +1,103 @@
+#pragma once
+
+#ifndef CRAG_GARSIDE_NORMAL_FORM_H
+#define CRAG_GARSIDE_NORMAL_FORM_H
+
+#include <utility>
+#include <vector>
+
+namespace crag {
+namespace braidgroup {
+namespace garside {
+
+//! Core of the right Garside normal form algorithm, parametrized by the type of simple factors.
+/*!
+  Factor is Permutation or crag::PackedPermutation (for ranks up to 32), it must provide
+  getHalfTwistPermutation, multiplication, inversion (unary minus), RightGCD, isTrivial, equality,
+  and the starting and finishing sets as bitmasks (used for ranks up to 64).
+*/
+
+//! The result of a transformation of two adjacent factors.
+enum class Transformation { TwoFactors, OneFactor, NoChange };
+
+//! Moves the longest head of p2 that can be multiplied by p1 on the left into p1.
+template <typename Factor>
+Transformation transform(int rank, Factor& p1, Factor& p2) {
+  // the pair is already right-weighted iff the finishing set of p1 is contained in the starting set of p2
+  if (rank <= 64 && (p1.finishingSet() & ~p2.startingSet()) == 0) {
+    return Transformation::NoChange;
+  }
+
+  auto result = Transformation::TwoFactors;
+  const auto omega = Factor::getHalfTwistPermutation(rank);
+
+  const auto p3 = p1.RightGCD(omega * -p2);
+
+  if (p3 == p1) {
+    result = Transformation::OneFactor;
+  }
+
+  if (p3.isTrivial()) {
+    result = Transformation::NoChange;
+  }
+
+  p2 = p3 * p2;
+  p1 *= -p3;
+
+  return result;
+}
+
+//! Transforms a sequence of simple factors times \f$\Delta^{power}\f$ into the right normal form.
+/*!
+  Works in place in one pass over decomp: the normalized prefix grows by one factor at a time,
+  each new factor is moved to the end of the prefix and pushed to the left while it changes its neighbour.
+  The first normalized factors of decomp are assumed to be already right-weighted and different from \f$\Delta\f$
+  (for instance, when the decomposition of a normal form is extended on the right), so they are skipped.
+*/
+template <typename Factor>
+void adjustDecomposition(int rank, int& power, std::vector<Factor>& decomp, size_t normalized = 0) {
+  const auto omega = Factor::getHalfTwistPermutation(rank);
+
+  bool flip = false;
+  size_t size = normalized;
+
+  for (size_t i = normalized; i < decomp.size(); ++i) {
+    if (flip) {
+      decomp[size] = omega * decomp[i] * omega;
+    } else if (size != i) {
+      decomp[size] = std::move(decomp[i]);
+    }
+
+    ++size;
+
+    for (size_t j = size - 1; j > 0;) {
+      const auto result = transform(rank, decomp[j - 1], decomp[j]);
+
+      if (result == Transformation::NoChange) {
+        break;
+      }
+
+      if (result == Transformation::OneFactor) {
+        // the left factor became trivial
+        std::move(decomp.begin() + j, decomp.begin() + size, decomp.begin() + j - 1);
+        --size;
+      }
+
+      --j;
+    }
+
+    if (decomp[size - 1] == omega) {
+      ++power;
+      --size;
+      flip = !flip;
+    }
+  }
+
+  decomp.erase(decomp.begin() + size, decomp.end());
+}
+
+} // namespace garside
+} // namespace braidgroup
+} // namespace crag
+
+#endif // CRAG_GARSIDE_NORMAL_FORM_H
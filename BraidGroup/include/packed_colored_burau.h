@@ -0,0 +1,310 @@
+#pragma once
+
+#ifndef CRAG_PACKED_COLORED_BURAU_H
+#define CRAG_PACKED_COLORED_BURAU_H
+
+#include <cstdlib>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Permutation.h"
+#include "Word.h"
+#include "colored_burau.h"
+#include "matrix.h"
+#include "row_operations.h"
+
+namespace crag {
+namespace coloredburau {
+
+//! The same element as CBProjectionElement, laid out for fast E-multiplication by braid words.
+/*!
+  The matrix is stored column-major in one contiguous array, since E-multiplication by a generator
+  updates 3 adjacent columns. The values -t_{sigma(k)} and -t_{sigma(k)}^{-1} are precomputed once
+  and permuted together with sigma, so a generator costs 2n additions and n multiplications,
+  without permutation lookups and without inverting field elements. Columns are updated
+  by the row operations (see row_operations.h), which are vectorized for finitefield::Fp.
+*/
+template <typename T>
+class PackedCBProjectionElement {
+public:
+  //! Constructs a unit, i.e. (unit matrix, unit permutation)
+  explicit PackedCBProjectionElement(std::vector<T> t_values)
+      : n_(t_values.size())
+      , t_values_(std::move(t_values))
+      , columns_(n_ * n_, T(0))
+      , permutation_(n_) {
+    if (n_ < 2) {
+      throw std::invalid_argument("Require at least 2 t-values.");
+    }
+
+    for (size_t i = 0; i < n_; ++i) {
+      columns_[i * n_ + i] = T(1);
+      permutation_[i] = i;
+    }
+
+    initTables_();
+  }
+
+  explicit PackedCBProjectionElement(const CBProjectionElement<T>& el)
+      : n_(el.n())
+      , t_values_(el.tValues())
+      , columns_(n_ * n_)
+      , permutation_(el.permutation().getVector()) {
+    for (size_t j = 0; j < n_; ++j) {
+      for (size_t i = 0; i < n_; ++i) {
+        columns_[j * n_ + i] = el.matrix()(i, j);
+      }
+    }
+
+    initTables_();
+  }
+
+  CBProjectionElement<T> toProjectionElement() const {
+    return CBProjectionElement<T>(t_values_, matrix(), permutation());
+  }
+
+  const std::vector<T>& tValues() const {
+    return t_values_;
+  }
+
+  size_t n() const {
+    return n_;
+  }
+
+  //! Entry (i, j) of the matrix.
+  const T& operator()(size_t i, size_t j) const {
+    return columns_[j * n_ + i];
+  }
+
+  Matrix<T> matrix() const {
+    Matrix<T> result(n_);
+
+    for (size_t i = 0; i < n_; ++i) {
+      for (size_t j = 0; j < n_; ++j) {
+        result(i, j) = (*this)(i, j);
+      }
+    }
+
+    return result;
+  }
+
+  Permutation permutation() const {
+    return Permutation(permutation_);
+  }
+
+  //! E-multiplication by a braid word w, see CBProjectionElement::operator*=(const Word&).
+  PackedCBProjectionElement& operator*=(const Word& w) {
+    return multiply(w.begin(), w.end());
+  }
+
+  //! E-multiplication by the sequence of letters [begin, end) (it does not have to be freely reduced).
+  template <typename InputIterator>
+  PackedCBProjectionElement& multiply(InputIterator begin, InputIterator end) {
+    for (auto it = begin; it != end; ++it) {
+      const int i = *it;
+      const size_t index = std::abs(i);
+
+      if ((index < 1) || (index + 1 > n_)) {
+        throw std::invalid_argument("Cannot perform E-multiplication by w, generator's index is out of range.");
+      }
+
+      if (i > 0) {
+        multiplyPositive_(index);
+      } else {
+        multiplyNegative_(index);
+      }
+
+      std::swap(permutation_[index - 1], permutation_[index]);
+      std::swap(minus_t_[index - 1], minus_t_[index]);
+      std::swap(minus_t_inverse_[index - 1], minus_t_inverse_[index]);
+    }
+
+    return *this;
+  }
+
+  //! Returns (t_{sigma(0)}, ..., t_{sigma(n-1)}), where sigma is the permutation of the element.
+  std::vector<T> currentTValues() const {
+    std::vector<T> result;
+    result.reserve(n_);
+
+    for (size_t k = 0; k < n_; ++k) {
+      result.push_back(t_values_[permutation_[k]]);
+    }
+
+    return result;
+  }
+
+  //! Checks if segment.tValues() == currentTValues(), see operator*=(const PackedCBProjectionElement&).
+  bool isContinuedBy(const PackedCBProjectionElement& segment) const {
+    if (segment.n_ != n_) {
+      return false;
+    }
+
+    for (size_t k = 0; k < n_; ++k) {
+      if (segment.t_values_[k] != t_values_[permutation_[k]]) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  //! E-multiplication by a word u given by its segment (E, id) * u computed with t-values currentTValues().
+  /*!
+    The segment does not depend on the matrix of *this, so E-multiplication by a fixed word can be computed once
+    for all elements with the same permutation. Takes O(n^3) time. Throws if !isContinuedBy(segment).
+  */
+  PackedCBProjectionElement& operator*=(const PackedCBProjectionElement& segment) {
+    if (!isContinuedBy(segment)) {
+      throw std::invalid_argument("The segment was computed for another permutation.");
+    }
+
+    using matrix::addScaledRow;
+
+    std::vector<T> columns(n_ * n_, T(0));
+
+    for (size_t j = 0; j < n_; ++j) {
+      const auto result = columns.data() + j * n_;
+
+      for (size_t k = 0; k < n_; ++k) {
+        const auto& coef = segment.columns_[j * n_ + k];
+
+        if (coef == T(0)) {
+          continue;
+        }
+
+        addScaledRow(result, columns_.data() + k * n_, coef, n_);
+      }
+    }
+
+    columns_ = std::move(columns);
+
+    // the segment starts from the trivial permutation, so it permutes the positions of *this
+    std::vector<int> permutation(n_);
+    std::vector<T> minus_t(n_);
+    std::vector<T> minus_t_inverse(n_);
+
+    for (size_t k = 0; k < n_; ++k) {
+      const auto p = segment.permutation_[k];
+      permutation[k] = permutation_[p];
+      minus_t[k] = minus_t_[p];
+      minus_t_inverse[k] = minus_t_inverse_[p];
+    }
+
+    permutation_ = std::move(permutation);
+    minus_t_ = std::move(minus_t);
+    minus_t_inverse_ = std::move(minus_t_inverse);
+
+    return *this;
+  }
+
+  bool operator==(const PackedCBProjectionElement& other) const {
+    return (permutation_ == other.permutation_) && (columns_ == other.columns_) && (t_values_ == other.t_values_);
+  }
+
+  bool operator!=(const PackedCBProjectionElement& other) const {
+    return !(*this == other);
+  }
+
+private:
+  size_t n_;
+  std::vector<T> t_values_;
+  std::vector<T> columns_;
+  std::vector<int> permutation_;
+
+  //! minus_t_[k] = -t_{sigma(k)}
+  std::vector<T> minus_t_;
+
+  //! minus_t_inverse_[k] = -t_{sigma(k)}^{-1} (or 0 if t_{sigma(k)} = 0)
+  std::vector<T> minus_t_inverse_;
+
+  void initTables_() {
+    minus_t_.clear();
+    minus_t_inverse_.clear();
+    minus_t_.reserve(n_);
+    minus_t_inverse_.reserve(n_);
+
+    for (size_t k = 0; k < n_; ++k) {
+      const auto& t = t_values_[permutation_[k]];
+      minus_t_.push_back(-t);
+
+      // zero has no inverse, it is reported only if the inverse is actually used
+      minus_t_inverse_.push_back(t == T(0) ? T(0) : -t.inverse());
+    }
+  }
+
+  T* column_(size_t j) {
+    return columns_.data() + j * n_;
+  }
+
+  void multiplyPositive_(size_t index) {
+    using matrix::addRow;
+    using matrix::scaleRow;
+    using matrix::subtractRow;
+
+    const auto prev = column_(index - 1);
+
+    addRow(column_(index), prev, n_);
+    scaleRow(prev, minus_t_[index - 1], n_);
+
+    if (index > 1) {
+      subtractRow(column_(index - 2), prev, n_);
+    }
+  }
+
+  void multiplyNegative_(size_t index) {
+    const auto m = minus_t_inverse_[index];
+
+    if (m == T(0)) {
+      throw std::logic_error("Division by zero");
+    }
+
+    using matrix::addRow;
+    using matrix::scaleRow;
+    using matrix::subtractRow;
+
+    const auto prev = column_(index - 1);
+
+    if (index > 1) {
+      addRow(column_(index - 2), prev, n_);
+    }
+
+    scaleRow(prev, m, n_);
+    subtractRow(column_(index), prev, n_);
+  }
+};
+
+template <typename T>
+PackedCBProjectionElement<T> operator*(PackedCBProjectionElement<T> lhs, const Word& w) {
+  return lhs *= w;
+}
+
+template <typename T>
+std::ostream& operator<<(std::ostream& out, const PackedCBProjectionElement<T>& el) {
+  return out << el.toProjectionElement();
+}
+
+//! Acts on the trivial pair (E, id) by w using provided t-values, the result is packed.
+template <typename T>
+PackedCBProjectionElement<T> projectPacked(const Word& w, std::vector<T> t_values) {
+  PackedCBProjectionElement<T> result(std::move(t_values));
+  return result *= w;
+}
+} // namespace coloredburau
+} // namespace crag
+
+namespace std {
+
+//! Has the same value as the hash of the corresponding CBProjectionElement.
+template <typename T>
+struct hash<crag::coloredburau::PackedCBProjectionElement<T>> {
+public:
+  size_t operator()(const crag::coloredburau::PackedCBProjectionElement<T>& element) const {
+    return std::hash<crag::coloredburau::CBProjectionElement<T>>()(element.toProjectionElement());
+  }
+};
+} // namespace std
+
+#endif // CRAG_PACKED_COLORED_BURAU_H
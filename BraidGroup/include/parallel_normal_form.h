@@ -0,0 +1,31 @@
+#pragma once
+
+#ifndef CRAG_PARALLEL_NORMAL_FORM_H
+#define CRAG_PARALLEL_NORMAL_FORM_H
+
+#include "ThLeftNormalForm.h"
+#include "ThRightNormalForm.h"
+#include "braid_group.h"
+
+namespace crag {
+namespace braidgroup {
+
+//! Computes ThRightNormalForm(G, w) for long words using crag::parallel.
+/*!
+  The word is split into the given number of chunks of equal length (by default, one chunk per hardware thread),
+  the chunks are normalized concurrently, then the normal forms are multiplied pairwise in a balanced tree,
+  each level of the tree concurrently as well.
+*/
+ThRightNormalForm parallelRightNormalForm(const BraidGroup& G, const Word& w);
+
+ThRightNormalForm parallelRightNormalForm(const BraidGroup& G, const Word& w, size_t chunks);
+
+//! Same as parallelRightNormalForm, computes ThLeftNormalForm(G, w).
+ThLeftNormalForm parallelLeftNormalForm(const BraidGroup& G, const Word& w);
+
+ThLeftNormalForm parallelLeftNormalForm(const BraidGroup& G, const Word& w, size_t chunks);
+
+} // namespace braidgroup
+} // namespace crag
+
+#endif // CRAG_PARALLEL_NORMAL_FORM_H
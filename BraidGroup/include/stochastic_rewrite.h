@@ -7,6 +7,7 @@
 #include <map>
 #include <vector>
 
+#include "FreeReduction.h"
 #include "Word.h"
 
 namespace crag {
@@ -80,13 +81,9 @@ std::vector<size_t> selectSubwords(const std::vector<size_t>& blocks, URNG& g) {
 // v = v * u
 template <typename Iter>
 void append(std::vector<int>& v, Iter b, Iter e) {
-  for (auto i = b; i != e; ++i) {
-    if (v.size() > 0 && v.back() == -*i) {
-      v.pop_back();
-    } else {
-      v.push_back(*i);
-    }
-  }
+  const auto reduced = v.size();
+  v.insert(v.end(), b, e);
+  v.resize(crag::reduction::freelyReduce(v.data(), reduced, v.size()));
 }
 
 
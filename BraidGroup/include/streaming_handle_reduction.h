@@ -0,0 +1,95 @@
+#pragma once
+
+#ifndef CRAG_STREAMING_HANDLE_REDUCTION_H
+#define CRAG_STREAMING_HANDLE_REDUCTION_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "Word.h"
+
+namespace crag {
+namespace braidgroup {
+
+//! Handle reduction of a braid word fed letter by letter, the memory used is bounded by the window size.
+/*!
+  Letters are collected in a buffer of at most window letters. When the buffer is full it is reduced, the last
+  window / 2 letters of the result stay in the buffer, and the rest is considered stable: it is passed to the sink
+  and never revisited. So handles which reach back beyond the emitted prefix are not removed, and the result may
+  differ from the one computed on the whole word (see compareStreamingReduction).
+*/
+class StreamingHandleReduction {
+public:
+  //! The reduction applied to the buffer.
+  enum class Mode {
+    //! dehornoy(), removes left handles.
+    DEHORNOY,
+    //! shortenBraid(), alternately removes right and left handles.
+    SHORTEN
+  };
+
+  //! Receives the stable pieces of the result in order.
+  using Sink = std::function<void(const Word&)>;
+
+  //! Throws if n < 2 or window < 2.
+  StreamingHandleReduction(int n, size_t window, Sink sink, Mode mode = Mode::DEHORNOY);
+
+  void push_back(int g);
+
+  void push_back(const Word& w);
+
+  //! Reduces and emits the rest of the word, after that the reduction starts over with an empty word.
+  void finish();
+
+  //! Number of letters pushed so far.
+  size_t consumed() const {
+    return consumed_;
+  }
+
+  //! Number of letters passed to the sink so far.
+  size_t emitted() const {
+    return emitted_;
+  }
+
+private:
+  //! Reduces the buffer, emits everything but the last keep letters of the result.
+  void reduce_(size_t keep);
+
+  int n_;
+  size_t window_;
+  Sink sink_;
+  Mode mode_;
+
+  std::vector<int> buffer_;
+
+  size_t consumed_ = 0;
+  size_t emitted_ = 0;
+};
+
+//! Reduces w by StreamingHandleReduction in the mode DEHORNOY, the result represents the same braid.
+Word streamingDehornoy(int n, const Word& w, size_t window);
+
+//! Reduces w by StreamingHandleReduction in the mode SHORTEN, the result represents the same braid.
+Word streamingShortenBraid(int n, const Word& w, size_t window);
+
+//! Lengths of the results of the streaming and the full reduction of a word.
+struct StreamingReductionReport {
+  size_t input_length;
+  size_t streaming_length;
+  size_t full_length;
+
+  //! How much shortening was lost by streaming. May be negative, since handle reduction does not minimize the length.
+  std::int64_t lost() const {
+    return static_cast<std::int64_t>(streaming_length) - static_cast<std::int64_t>(full_length);
+  }
+};
+
+//! Reduces w both with the given window and as a whole, to choose the window size.
+StreamingReductionReport compareStreamingReduction(
+    int n, const Word& w, size_t window, StreamingHandleReduction::Mode mode = StreamingHandleReduction::Mode::DEHORNOY);
+
+} // namespace braidgroup
+} // namespace crag
+
+#endif // CRAG_STREAMING_HANDLE_REDUCTION_H
@@ -0,0 +1,183 @@
+#pragma once
+
+#ifndef CRAG_SUMMIT_SET_SEARCH_H
+#define CRAG_SUMMIT_SET_SEARCH_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "parallel.h"
+
+namespace crag {
+namespace braidgroup {
+namespace summit {
+
+//! Simultaneous construction of the summit sets (super summit or ultra summit) of two elements until they meet.
+/*!
+  A vertex of a summit set graph is a normal form NF paired with a Value (the conjugator to it, possibly with
+  some other data). Each set is kept as two maps: the processed vertices and the frontier of unprocessed ones.
+  The frontiers are expanded concurrently in chunks, and the chunks of the two sets alternate.
+*/
+
+using Clock = std::chrono::steady_clock;
+
+//! The number of frontier vertices expanded in one round.
+const size_t chunk_size = 1024;
+
+//! Read-only access to the summit sets while the frontier of the first one is expanded.
+template <typename NF, typename Value>
+class SummitSets {
+ public:
+  using Map = std::unordered_map<NF, Value>;
+
+  SummitSets(const Map& checked, const Map& other_new, const Map& other_checked)
+      : checked_(checked)
+      , other_new_(other_new)
+      , other_checked_(other_checked) {}
+
+  //! Check if x is a processed vertex of the set being expanded.
+  bool isChecked(const NF& x) const {
+    return checked_.find(x) != checked_.end();
+  }
+
+  //! Check if x belongs to the other set.
+  bool isInOther(const NF& x) const {
+    return other_new_.find(x) != other_new_.end() || other_checked_.find(x) != other_checked_.end();
+  }
+
+ private:
+  const Map& checked_;
+  const Map& other_new_;
+  const Map& other_checked_;
+};
+
+//! The result of a search, if the sets met then first and second are the values of a common vertex in them.
+template <typename Value>
+struct Meeting {
+  enum class Status { Met, NotMet, Expired };
+
+  Status status;
+  Value first;
+  Value second;
+};
+
+//! Expands at most max_vertices vertices of the frontier new1 of the first set.
+/*!
+  Function expand is of type
+      bool expand(const std::pair<NF, Value>& v, const SummitSets<NF, Value>& sets, std::vector<std::vector<std::pair<NF, Value>>>& paths)
+  it appends the paths of new vertices starting at the neighbours of v (single neighbours for super summit sets,
+  trajectories for ultra summit sets) and returns true once the last vertex appended belongs to the other set.
+  The maps are not modified until all threads finish, so they can be read by all of them. Once a vertex
+  of the other set is met, the frontier vertices after it are skipped, and the paths are merged in the
+  order of the frontier, so the result does not depend on the threads.
+  @return the meeting and the number of the frontier vertices taken
+ */
+template <typename NF, typename Value, typename Expand>
+std::pair<Meeting<Value>, size_t> expandFrontier(
+    std::unordered_map<NF, Value>& new1,
+    std::unordered_map<NF, Value>& checked1,
+    const std::unordered_map<NF, Value>& new2,
+    const std::unordered_map<NF, Value>& checked2,
+    size_t max_vertices,
+    Clock::time_point deadline,
+    const Expand& expand) {
+  using Vertex = std::pair<NF, Value>;
+  using Status = typename Meeting<Value>::Status;
+
+  std::vector<Vertex> frontier;
+  frontier.reserve(std::min(max_vertices, new1.size()));
+  for (auto it = new1.begin(); it != new1.end() && frontier.size() < max_vertices;) {
+    checked1.insert(*it);
+    frontier.push_back(*it);
+    it = new1.erase(it);
+  }
+
+  // 1. expand the frontier concurrently, the deadline is checked before each vertex
+  const SummitSets<NF, Value> sets(checked1, new2, checked2);
+  std::atomic<size_t> first_met(frontier.size());
+  std::atomic<bool> expired(false);
+  const auto paths = crag::parallel::map<std::vector<std::vector<Vertex>>>(frontier.size(), [&](size_t i) {
+    std::vector<std::vector<Vertex>> result;
+    if (i > first_met || expired) {
+      return result;
+    }
+
+    if (Clock::now() > deadline) {
+      expired = true;
+      return result;
+    }
+
+    if (expand(frontier[i], sets, result)) {
+      for (size_t j = first_met; i < j && !first_met.compare_exchange_weak(j, i);)
+        ;
+    }
+    return result;
+  });
+
+  // 2. merge the new vertices in the order of the frontier
+  for (const auto& vertex_paths : paths) {
+    for (const auto& path : vertex_paths) {
+      // skip the path if it is already in the frontier
+      if (path.empty() || new1.find(path.front().first) != new1.end()) {
+        continue;
+      }
+
+      for (const auto& v : path) {
+        auto other = new2.find(v.first);
+        if (other == new2.end()) {
+          other = checked2.find(v.first);
+          if (other == checked2.end()) {
+            new1.insert(v);
+            continue;
+          }
+        }
+        return {Meeting<Value>{Status::Met, v.second, other->second}, frontier.size()};
+      }
+    }
+  }
+
+  return {Meeting<Value>{expired ? Status::Expired : Status::NotMet, Value(), Value()}, frontier.size()};
+}
+
+//! Expands the frontiers of two summit sets by turns until they meet, one of them is exhausted,
+//! max_vertices vertices of each set are processed, or the deadline passes.
+template <typename NF, typename Value, typename Expand>
+Meeting<Value> findMeeting(
+    std::unordered_map<NF, Value>& new1,
+    std::unordered_map<NF, Value>& checked1,
+    std::unordered_map<NF, Value>& new2,
+    std::unordered_map<NF, Value>& checked2,
+    size_t max_vertices,
+    Clock::time_point deadline,
+    const Expand& expand) {
+  using Status = typename Meeting<Value>::Status;
+
+  for (size_t processed = 0; processed < max_vertices && !new1.empty() && !new2.empty();) {
+    const auto chunk = std::min(chunk_size, max_vertices - processed);
+
+    const auto result1 = expandFrontier(new1, checked1, new2, checked2, chunk, deadline, expand);
+    if (result1.first.status != Status::NotMet) {
+      return result1.first;
+    }
+
+    const auto result2 = expandFrontier(new2, checked2, new1, checked1, chunk, deadline, expand);
+    if (result2.first.status != Status::NotMet) {
+      return {result2.first.status, result2.first.second, result2.first.first};
+    }
+
+    processed += std::max(result1.second, result2.second);
+  }
+
+  return {Status::NotMet, Value(), Value()};
+}
+
+} // namespace summit
+} // namespace braidgroup
+} // namespace crag
+
+#endif // CRAG_SUMMIT_SET_SEARCH_H
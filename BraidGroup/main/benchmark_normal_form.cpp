@@ -0,0 +1,195 @@
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "ThLeftNormalForm.h"
+#include "ThRightNormalForm.h"
+#include "braid_group.h"
+#include "parallel_normal_form.h"
+#include "random_word.h"
+
+// All benchmarks take a pair (rank, word length).
+static void NormalFormArguments(benchmark::internal::Benchmark* b) {
+  for (const int rank : {8, 16, 32}) {
+    for (const int length : {1000, 10000, 100000}) {
+      b->Args({rank, length});
+    }
+  }
+}
+
+// Benchmarks of the parallel normal forms take a triple (rank, word length, number of chunks).
+static void ParallelNormalFormArguments(benchmark::internal::Benchmark* b) {
+  for (const int rank : {8, 16, 32}) {
+    for (const int length : {100000, 300000}) {
+      for (const int chunks : {1, 8, 32}) {
+        b->Args({rank, length, chunks});
+      }
+    }
+  }
+}
+
+static Word randomBraidWord(const benchmark::State& state, std::mt19937& g) {
+  return crag::random::randomWord(state.range(0) - 1, state.range(1), g);
+}
+
+static void BM_RightNormalForm(benchmark::State& state) {
+  std::mt19937 g(1233);
+  const crag::braidgroup::BraidGroup B(state.range(0));
+  const auto w = randomBraidWord(state, g);
+
+  while (state.KeepRunning()) {
+    ThRightNormalForm nf(B, w);
+    benchmark::DoNotOptimize(nf);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+static void BM_LeftNormalForm(benchmark::State& state) {
+  std::mt19937 g(1233);
+  const crag::braidgroup::BraidGroup B(state.range(0));
+  const auto w = randomBraidWord(state, g);
+
+  while (state.KeepRunning()) {
+    ThLeftNormalForm nf(B, w);
+    benchmark::DoNotOptimize(nf);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+static void BM_RightNormalFormParallel(benchmark::State& state) {
+  std::mt19937 g(1233);
+  const crag::braidgroup::BraidGroup B(state.range(0));
+  const auto w = randomBraidWord(state, g);
+
+  while (state.KeepRunning()) {
+    auto nf = crag::braidgroup::parallelRightNormalForm(B, w, state.range(2));
+    benchmark::DoNotOptimize(nf);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+static void BM_RightNormalFormMultiply(benchmark::State& state) {
+  std::mt19937 g(1233);
+  const crag::braidgroup::BraidGroup B(state.range(0));
+  const ThRightNormalForm u(B, randomBraidWord(state, g));
+  const ThRightNormalForm v(B, randomBraidWord(state, g));
+
+  while (state.KeepRunning()) {
+    auto uv = u * v;
+    benchmark::DoNotOptimize(uv);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+static void BM_RightNormalFormInverse(benchmark::State& state) {
+  std::mt19937 g(1233);
+  const crag::braidgroup::BraidGroup B(state.range(0));
+  const ThRightNormalForm u(B, randomBraidWord(state, g));
+
+  while (state.KeepRunning()) {
+    auto inv = -u;
+    benchmark::DoNotOptimize(inv);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+static void BM_RightNormalFormCycle(benchmark::State& state) {
+  std::mt19937 g(1233);
+  const crag::braidgroup::BraidGroup B(state.range(0));
+  const ThRightNormalForm u(B, randomBraidWord(state, g));
+
+  while (state.KeepRunning()) {
+    auto c = u.cycle();
+    benchmark::DoNotOptimize(c);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+static void BM_RightNormalFormDecycle(benchmark::State& state) {
+  std::mt19937 g(1233);
+  const crag::braidgroup::BraidGroup B(state.range(0));
+  const ThRightNormalForm u(B, randomBraidWord(state, g));
+
+  while (state.KeepRunning()) {
+    auto c = u.decycle();
+    benchmark::DoNotOptimize(c);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+static void BM_RightNormalFormPushBack(benchmark::State& state) {
+  std::mt19937 g(1233);
+  const auto w = randomBraidWord(state, g);
+
+  while (state.KeepRunning()) {
+    ThRightNormalForm nf(state.range(0));
+
+    for (const auto x : w) {
+      nf.push_back(x);
+    }
+
+    benchmark::DoNotOptimize(nf);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+static void BM_RightNormalFormConjugateByGenerator(benchmark::State& state) {
+  std::mt19937 g(1233);
+  const crag::braidgroup::BraidGroup B(state.range(0));
+  const ThRightNormalForm u(B, randomBraidWord(state, g));
+
+  int x = 1;
+
+  while (state.KeepRunning()) {
+    auto c = u;
+    c.conjugate(x);
+    benchmark::DoNotOptimize(c);
+
+    x = x % (state.range(0) - 1) + 1;
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+static void BM_RightNormalFormConjugateByProduct(benchmark::State& state) {
+  std::mt19937 g(1233);
+  const crag::braidgroup::BraidGroup B(state.range(0));
+  const ThRightNormalForm u(B, randomBraidWord(state, g));
+
+  int x = 1;
+
+  while (state.KeepRunning()) {
+    const ThRightNormalForm nf_x(B, Word(x));
+    auto c = -nf_x * u * nf_x;
+    benchmark::DoNotOptimize(c);
+
+    x = x % (state.range(0) - 1) + 1;
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+BENCHMARK(BM_RightNormalForm)->Apply(NormalFormArguments)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LeftNormalForm)->Apply(NormalFormArguments)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RightNormalFormParallel)
+    ->Apply(ParallelNormalFormArguments)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_RightNormalFormMultiply)->Apply(NormalFormArguments)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RightNormalFormInverse)->Apply(NormalFormArguments)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RightNormalFormCycle)->Apply(NormalFormArguments)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RightNormalFormDecycle)->Apply(NormalFormArguments)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_RightNormalFormPushBack)->Apply(NormalFormArguments)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RightNormalFormConjugateByGenerator)->Apply(NormalFormArguments)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RightNormalFormConjugateByProduct)->Apply(NormalFormArguments)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -1,14 +1,15 @@
 
 #include "BKLLeftNormalForm.h"
-#include "braid_group.h"
+
 #include "Word.h"
+#include "summit_set_search.h"
 
 
 ostream& operator << ( ostream& os, const BKLLeftNormalForm& bkl )
 {
-  const list< Permutation >& decomposition = bkl.getDecomposition( );
+  const list< BKLSimpleElement >& decomposition = bkl.getDecomposition( );
   
-  list< Permutation >::const_iterator it = decomposition.begin( );
+  list< BKLSimpleElement >::const_iterator it = decomposition.begin( );
   for( ; it!=decomposition.end( ) ; ++it )
     os << (*it) << endl;
 
@@ -19,9 +20,7 @@ ostream& operator << ( ostream& os, const BKLLeftNormalForm& bkl )
 
 bool BKLLeftNormalForm::operator !=( const BKLLeftNormalForm& bkl ) const
 {
-  if( theOmegaPower!=bkl.theOmegaPower )
-    return false;
-  return theDecomposition!=bkl.theDecomposition;
+  return !( *this==bkl );
 }
 
 
@@ -46,12 +45,10 @@ bool BKLLeftNormalForm::operator < ( const BKLLeftNormalForm& bkl ) const
 //---------------------------------------------------------------------------//
 
 
-BKLLeftNormalForm::BKLLeftNormalForm( const BraidGroup& G , const Word& w ) :
+BKLLeftNormalForm::BKLLeftNormalForm( const crag::braidgroup::BraidGroup& G , const Word& w ) :
   theRank( G.getRank( ) ),
   theOmegaPower( 0 )
 {
-  const Permutation omega = getTinyTwistPermutation( theRank );
-
   // 1. compute reverse permutation decomposition of a given braid word
   int shift = 0;
   for( Word::const_iterator w_it=w.end( ) ; w_it!=w.begin( ) ; ) {
@@ -62,20 +59,15 @@ BKLLeftNormalForm::BKLLeftNormalForm( const BraidGroup& G , const Word& w ) :
       int strand1 = (letter+shift  )%theRank;
       int strand2 = (letter+shift+1)%theRank;
       
-      Permutation transvection( theRank );
-      transvection.change( strand1 , strand2 );
-      
-      theDecomposition.push_front( transvection );
+      theDecomposition.push_front( BKLSimpleElement::band( theRank , strand1 , strand2 ) );
     } else {
       int letter = -g-1;
       shift = (shift+1)%theRank;
       int strand1 = (letter+shift  )%theRank;
       int strand2 = (letter+shift+1)%theRank;
       
-      Permutation transvection( theRank );
-      transvection.change( strand1 , strand2 );
-      
-      theDecomposition.push_front( transvection*omega );
+      // a transposition is an involution, so transvection*omega is its complement
+      theDecomposition.push_front( BKLSimpleElement::band( theRank , strand1 , strand2 ).rightComplement( ) );
       theOmegaPower -= 1;
     }
   }
@@ -84,23 +76,34 @@ BKLLeftNormalForm::BKLLeftNormalForm( const BraidGroup& G , const Word& w ) :
 }
 
 
+BKLLeftNormalForm::BKLLeftNormalForm( const BKLSimpleElement& s ) :
+  theRank( s.size( ) ),
+  theOmegaPower( 0 )
+{
+  if( s.isTinyTwist( ) )
+    theOmegaPower = 1;
+  else if( !s.isTrivial( ) )
+    theDecomposition.push_back( s );
+}
+
+
 //---------------------------------------------------------------------------//
 //------------------------------- transform ---------------------------------//
 //---------------------------------------------------------------------------//
 
 
 BKLLeftNormalForm::transformationResult 
-BKLLeftNormalForm::transform( int rank , Permutation& p1 , Permutation& p2 )
+BKLLeftNormalForm::transform( int rank , BKLSimpleElement& p1 , BKLSimpleElement& p2 )
 {
   transformationResult res = TWO_MULTIPLIERS;
-  const Permutation omega = getTinyTwistPermutation( rank );
   
-  Permutation p3 = p2.meet2( p1.inverse( )*omega );
+  // the longest head of p2 which can be absorbed by p1
+  BKLSimpleElement p3 = p2.meet( p1.rightComplement( ) );
   if( p3==p2 )
     res = ONE_MULTIPLIER;
   if( p3.isTrivial( ) )
-    res = NO_CHANGE;
-  p2 = p3.inverse( )*p2;
+    return NO_CHANGE;
+  p2 = p2.leftQuotient( p3 );
   p1 *= p3;
 
   return res;
@@ -128,13 +131,12 @@ BKLLeftNormalForm::NF BKLLeftNormalForm::inverse( ) const
   int dec_size = theDecomposition.size( );
   
   int power = -theOmegaPower-dec_size;
-  const Permutation omega = getTinyTwistPermutation( theRank );
-  list<Permutation> result;
+  list<BKLSimpleElement> result;
   
   int flip = theOmegaPower+1;
-  list<Permutation>::const_iterator it = theDecomposition.begin( );
+  list<BKLSimpleElement>::const_iterator it = theDecomposition.begin( );
   for( ; it!=theDecomposition.end( ) ; ++it ) {
-    Permutation p = (*it).inverse( ) * omega;
+    BKLSimpleElement p = (*it).rightComplement( );
     result.push_front( p.tinyFlip( flip ) );
     // cout << -flip << "," << (*it) << " : " << p << " => " << p.tinyFlip( -flip ) << endl;
     flip++;
@@ -174,14 +176,12 @@ BKLLeftNormalForm::multiply( const BKLLeftNormalForm& bkl ) const
 {
   int theRank = bkl.theRank;
   
-  const Permutation omega = getTinyTwistPermutation( theRank );
-  
   // 1. shift omegas to the left
   int power = theOmegaPower + bkl.theOmegaPower;
 
   // 2. create initial decomposition
-  list< Permutation > blocks;
-  list< Permutation >::const_iterator it = theDecomposition.begin( );
+  list< BKLSimpleElement > blocks;
+  list< BKLSimpleElement >::const_iterator it = theDecomposition.begin( );
   for( ; it!=theDecomposition.end( ) ; ++it )
     blocks.push_back( (*it).tinyFlip( -bkl.theOmegaPower ) );
   it = bkl.theDecomposition.begin( );
@@ -201,20 +201,18 @@ BKLLeftNormalForm::multiply( const BKLLeftNormalForm& bkl ) const
 
 void 
 BKLLeftNormalForm::adjustDecomposition
-( int rank , int& power , list<Permutation>& decomp )
+( int rank , int& power , list<BKLSimpleElement>& decomp )
 {
-  const Permutation omega = getTinyTwistPermutation( rank );
-  
   int shift = 0;
-  list< Permutation >::iterator it1 = decomp.end( );
+  list< BKLSimpleElement >::iterator it1 = decomp.end( );
   while( it1!=decomp.begin( ) ) {
     --it1;
 
     *it1 = (*it1).tinyFlip( shift );
-    list< Permutation >::iterator it2 = it1;
+    list< BKLSimpleElement >::iterator it2 = it1;
     for( ; it2!=decomp.end( ) ; ++it2 ) {
       
-      list< Permutation >::iterator it3 = it2;
+      list< BKLSimpleElement >::iterator it3 = it2;
       if( ++it3==decomp.end( ) )
 	continue;
       
@@ -236,10 +234,12 @@ BKLLeftNormalForm::adjustDecomposition
 	it2 = decomp.end( );
 	it2--;
 	break;
+      default:
+	break;
       }
     }
     
-    if( *it1==omega ) {
+    if( (*it1).isTinyTwist( ) ) {
       power++;
       it1 = decomp.erase( it1 );
       shift = (shift+rank-1)%rank;
@@ -259,10 +259,10 @@ Word BKLLeftNormalForm::getWord( ) const
 
   if( theOmegaPower ) {
     Word omegaWord;
-    const Permutation omega = getTinyTwistPermutation( theRank );
+    const Permutation omega = getTinyTwistPermutation( theRank ).toPermutation( );
     vector< int > geodesic = omega.geodesic( );
-    for( int i=0 ; i<geodesic.size( ) ; ++i )
-      omegaWord *= Generator( geodesic[i]+1 );
+    for( size_t i=0 ; i<geodesic.size( ) ; ++i )
+      omegaWord *= Word( geodesic[i]+1 );
     
     if( theOmegaPower<0 )
       omegaWord = omegaWord.inverse( );
@@ -271,10 +271,10 @@ Word BKLLeftNormalForm::getWord( ) const
   }
   
   vector< int > geodesic;
-  for( list< Permutation >::const_iterator d_it = theDecomposition.begin( ) ; d_it!=theDecomposition.end( ) ; ++d_it ) {
+  for( list< BKLSimpleElement >::const_iterator d_it = theDecomposition.begin( ) ; d_it!=theDecomposition.end( ) ; ++d_it ) {
     geodesic = (*d_it).getWordPresentation( );
-    for( int j=0 ; j<geodesic.size( ) ; ++j )
-      result *= Generator( geodesic[j] );
+    for( size_t j=0 ; j<geodesic.size( ) ; ++j )
+      result *= Word( geodesic[j] );
   }
   
   return result;
@@ -292,18 +292,18 @@ BKLLeftNormalForm::cycle( ) const
   typedef pair< BKLLeftNormalForm , BKLLeftNormalForm > PNF;
   
   if( theDecomposition.empty( ) )
-    return PNF( *this , BKLLeftNormalForm( ) );
+    return PNF( *this , BKLLeftNormalForm( theRank ) );
   
   BKLLeftNormalForm result = *this;
   
   // create initial decomposition of a result
-  Permutation conj = (*result.theDecomposition.begin( )).tinyFlip( result.theOmegaPower );
+  BKLSimpleElement conj = (*result.theDecomposition.begin( )).tinyFlip( result.theOmegaPower );
   result.theDecomposition.push_back( conj );
   result.theDecomposition.pop_front( );
   
   // transform to a normal form
   adjustDecomposition( result.theRank , result.theOmegaPower , result.theDecomposition );
-  return PNF( result , BKLLeftNormalForm( theRank , 0 , list<Permutation>( 1 , conj ) ) );
+  return PNF( result , BKLLeftNormalForm( theRank , 0 , list<BKLSimpleElement>( 1 , conj ) ) );
 }
 
 
@@ -318,16 +318,16 @@ BKLLeftNormalForm::decycle( ) const
   typedef pair< BKLLeftNormalForm , BKLLeftNormalForm > PNF;
 
   if( theDecomposition.empty( ) )
-    return PNF( *this , BKLLeftNormalForm( ) );
+    return PNF( *this , BKLLeftNormalForm( theRank ) );
 
   BKLLeftNormalForm result = *this;
 
   // create initial decomposition of a result
-  Permutation conj = *--result.theDecomposition.end( );
+  BKLSimpleElement conj = *--result.theDecomposition.end( );
   result.theDecomposition.push_front( conj.tinyFlip( -theOmegaPower ) );
   result.theDecomposition.pop_back( );
   
-  BKLLeftNormalForm conjugator( theRank , 0 , list<Permutation>( 1 , conj ) );
+  BKLLeftNormalForm conjugator( theRank , 0 , list<BKLSimpleElement>( 1 , conj ) );
   conjugator = -conjugator;
   
   // transform to a normal form
@@ -345,8 +345,8 @@ pair< BKLLeftNormalForm , BKLLeftNormalForm >
 BKLLeftNormalForm::findSSSRepresentative( ) const
 {
   typedef pair< BKLLeftNormalForm , BKLLeftNormalForm > PNF;
-  BKLLeftNormalForm cur_conj;
-  BKLLeftNormalForm conjugator;
+  BKLLeftNormalForm cur_conj( theRank );
+  BKLLeftNormalForm conjugator( theRank );
   
   BKLLeftNormalForm result = *this;
   BKLLeftNormalForm cur_nf = *this;
@@ -382,160 +382,162 @@ BKLLeftNormalForm::findSSSRepresentative( ) const
     }
   }
 
-  return pair< BKLLeftNormalForm::NF , BKLLeftNormalForm >( result , conjugator );
+  return PNF( result , conjugator );
 }
 
 
 //---------------------------------------------------------------------------//
-//--------------------------- getSimpleConjugators --------------------------//
+//----------------------------------- hash ----------------------------------//
 //---------------------------------------------------------------------------//
 
 
-set<Permutation> BKLLeftNormalForm::getSimpleConjugators( const NF& bkl )
+size_t BKLLeftNormalForm::hash( ) const
 {
-  int theRank = bkl.first;
-  const list< Permutation >& decomp = bkl.third;
-  
-  set<Permutation> result;
-  
-  for( int i=0 ; i<theRank-1 ; ++i ) {
-    Permutation c = Permutation( theRank );
-    c.change( i , i+1 );
-
-    // cout << "i = " << i << endl;
-    
-    bool done = false;
-    if( bkl.second>0 )
-      done = true;
-    
-    Permutation v = c;
-    list< Permutation >::const_iterator it = decomp.begin( );
-    while( !done ) {
-      for( ; it!=decomp.end( ) ; ++it ) {
-	v = (*it).inverse() * v.join2( *it );
-	if( v.isTrivial( ) ) {
-	  done = true;
-	  break;
-	}
-      }
-      if( !done ) {
-	v = v.join2( c );
-	if( v==c )
-	  done = true;
-	else
-	  c = v;
-      }
-      // cout << c << endl;
-    }
-    
-    result.insert( c );
-  }
-  
+  size_t result = theRank;
+  result ^= theOmegaPower + 0x9e3779b9 + ( result<<6 ) + ( result>>2 );
+  for( list< BKLSimpleElement >::const_iterator it=theDecomposition.begin( ) ; it!=theDecomposition.end( ) ; ++it )
+    result ^= (*it).hash( ) + 0x9e3779b9 + ( result<<6 ) + ( result>>2 );
   return result;
 }
 
 
 //---------------------------------------------------------------------------//
-//------------------------- getSimpleSummitConjugators ----------------------//
+//-------------------------------- conjugate --------------------------------//
 //---------------------------------------------------------------------------//
 
 
-// Is it finished?
-set<Permutation> BKLLeftNormalForm::getSimpleSummitConjugators( const NF& bkl )
+BKLLeftNormalForm BKLLeftNormalForm::conjugate( const BKLSimpleElement& s ) const
 {
-  set<Permutation> result;
-  
-  set<Permutation> conjs = getSimpleConjugators( bkl );
-  
-  
-  return conjs;
+  const BKLLeftNormalForm c( s );
+  return -c * *this * c;
 }
 
-  
+
 //---------------------------------------------------------------------------//
-//------------------------------- areConjugate ------------------------------//
+//--------------------------- getSimpleConjugator ---------------------------//
 //---------------------------------------------------------------------------//
 
 
-pair<bool,Word>
-BKLLeftNormalForm::areConjugate( const BKLLeftNormalForm& bkl ) const
+BKLSimpleElement BKLLeftNormalForm::getSimpleConjugator( const BKLSimpleElement& start ) const
 {
-  pair<bool,Word> result;
+  // For *this = d^p x and a simple c, d^p <= c^{-1} d^p x c iff tau(c) <= x c, where tau(c) = d^{-p} c d^p.
+  // The latter holds iff x^{-1} (tau(c) v x) <= c, the left part is computed factor by factor.
+  // Since it grows together with c, the minimal c is obtained by joining them until c stabilizes.
+  BKLSimpleElement c = start;
+  
+  while( 1 ) {
+    
+    BKLSimpleElement v = c.tinyFlip( -theOmegaPower );
+    list< BKLSimpleElement >::const_iterator it = theDecomposition.begin( );
+    for( ; it!=theDecomposition.end( ) && !v.isTrivial( ) ; ++it )
+      v = v.join( *it ).leftQuotient( *it );
+    
+    v = v.join( c );
+    if( v==c )
+      return c;
+    c = v;
+  }
+}
 
-  // typedef pair< int , vector< Permutation > > NF;
 
-  // 1. find representative of SSS1
-  pair< NF , BKLLeftNormalForm > pr1 = findSSSRepresentative( );
-  NF nf1 = pr1.first;
-  pair< NF , BKLLeftNormalForm > pr2 = bkl.findSSSRepresentative( );
-  NF nf2 = pr2.first;
-  
-  if( nf1.second!=nf2.second || nf1.third.size( )!=nf2.third.size( ) )
-    return pair<bool,Word>( false , Word( ) );
+//---------------------------------------------------------------------------//
+//------------------------ getSimpleSummitConjugator ------------------------//
+//---------------------------------------------------------------------------//
+
+
+BKLSimpleElement BKLLeftNormalForm::getSimpleSummitConjugator( const BKLSimpleElement& start ) const
+{
+  // sup(c^{-1} x c) = -inf(c^{-1} x^{-1} c), so both conditions are of the same kind.
+  // Both maps c -> getSimpleConjugator( c ) only grow c, so alternating them converges to the minimal c satisfying both.
+  const BKLLeftNormalForm inv = -*this;
   
-  if( nf1==nf2 ) {
-    cout << "Equal" << endl;
-    return pair<bool,Word>( true , Word( ) );
-  }
+  BKLSimpleElement c = start;
   
-  // 2. multiply by the n-th power of omega
-  if( nf1.first<0 ) {
-    int power = (1-nf1.first/theRank)*theRank;
-    nf1.first += power;
-    nf2.first += power;
+  while( 1 ) {
+    BKLSimpleElement v = inv.getSimpleConjugator( getSimpleConjugator( c ) );
+    if( v==c )
+      return c;
+    c = v;
   }
+}
+
+
+//---------------------------------------------------------------------------//
+//------------------------- getSimpleSummitConjugators ----------------------//
+//---------------------------------------------------------------------------//
+
+
+set<BKLSimpleElement> BKLLeftNormalForm::getSimpleSummitConjugators( ) const
+{
+  set<BKLSimpleElement> result;
   
-  // 3. construct super summit sets
-  set< NF > sss_new1;
-  set< NF > sss_checked1;
-  set< NF > sss_new2;
-  set< NF > sss_checked2;
-  
-  sss_new1.insert( nf1 );
-  sss_new2.insert( nf2 );
+  for( int t=1 ; t<theRank ; ++t )
+    for( int s=0 ; s<t ; ++s )
+      result.insert( getSimpleSummitConjugator( BKLSimpleElement::band( theRank , s , t ) ) );
   
-  for( int i=0 ; i<1 && sss_new1.size( ) && sss_new2.size( ) ; ++i ) {
-    
-    // 4. select unchecked element of SSS1
-    NF el1 = *sss_new1.begin( );
-    sss_checked1.insert( el1 );
-    sss_new1.erase( sss_new1.begin( ) );
-    
-    BKLLeftNormalForm tmp_nf = el1;
-    cout << "====================================" << endl;
-    cout << tmp_nf << endl;
-    cout << "====================================" << endl;
+  return result;
+}
 
-    // 5. compute the set of simple summit conjugators 
-    set<Permutation> conj1 = getSimpleSummitConjugators( el1 );
-    
-    // 6. conjugate selected element by conjugators
-    set<Permutation>:: iterator it = conj1.begin( );
-    for( ; it!=conj1.end( ) ; ++it ) {
-      BKLLeftNormalForm r_mult( theRank , 0 , list<Permutation>( 1 , *it ) );
-      BKLLeftNormalForm l_mult = r_mult.inverse( );
-      BKLLeftNormalForm new_el1 = l_mult.multiply( el1 );
-      new_el1 = new_el1.multiply( r_mult );
-      
-      if( sss_new1.find( new_el1 )!=sss_new1.end( ) )
-	continue;
-      if( sss_checked1.find( new_el1 )!=sss_checked1.end( ) )
-	continue;
-      
-      if( sss_new2.find( new_el1 )!=sss_new2.end( ) )
-	return pair<bool,Word>( true , Word( ) );
-      if( sss_checked2.find( new_el1 )!=sss_checked2.end( ) )
-	return pair<bool,Word>( true , Word( ) );
-
-      cout << "====================================" << endl;
-      cout << "N = " << i << endl;
-      cout << new_el1 << endl;
-      cout << "====================================" << endl;
-      
-      sss_new1.insert( new_el1 );
+
+//---------------------------------------------------------------------------//
+//------------------------------- areConjugate ------------------------------//
+//---------------------------------------------------------------------------//
+
+
+pair< bool , BKLLeftNormalForm >
+BKLLeftNormalForm::areConjugate( const BKLLeftNormalForm& bkl , int time_sec_bound ) const
+{
+  if( theRank!=bkl.theRank )
+    return pair< bool , BKLLeftNormalForm >( false , BKLLeftNormalForm( theRank ) );
+
+  const auto deadline = crag::braidgroup::summit::Clock::now( ) + std::chrono::seconds( time_sec_bound );
+
+  // 1. find representatives of the super summit sets
+  pair< BKLLeftNormalForm , BKLLeftNormalForm > pr1 =     findSSSRepresentative( );
+  pair< BKLLeftNormalForm , BKLLeftNormalForm > pr2 = bkl.findSSSRepresentative( );
+  
+  // Infimum and supremum of the representatives must be the same
+  if( pr1.first.theOmegaPower           !=pr2.first.theOmegaPower || 
+      pr1.first.theDecomposition.size( )!=pr2.first.theDecomposition.size( ) )
+    return pair< bool , BKLLeftNormalForm >( false , BKLLeftNormalForm( theRank ) );
+  
+  // If they are equal then we are lucky and can stop
+  if( pr1.first==pr2.first )
+    return pair< bool , BKLLeftNormalForm >( true , pr1.second.multiply( -pr2.second ) );
+  
+  // 2. construct super summit sets until they meet
+  unordered_map< BKLLeftNormalForm , BKLLeftNormalForm > sss_new1;
+  unordered_map< BKLLeftNormalForm , BKLLeftNormalForm > sss_checked1;
+  unordered_map< BKLLeftNormalForm , BKLLeftNormalForm > sss_new2;
+  unordered_map< BKLLeftNormalForm , BKLLeftNormalForm > sss_checked2;
+  
+  sss_new1[pr1.first] = pr1.second;
+  sss_new2[pr2.first] = pr2.second;
+  
+  // a vertex is expanded by conjugating it by its simple summit conjugators
+  typedef pair< BKLLeftNormalForm , BKLLeftNormalForm > Vertex;
+  const auto expand = []( const Vertex& pr , const crag::braidgroup::summit::SummitSets< BKLLeftNormalForm , BKLLeftNormalForm >& sets , vector< vector< Vertex > >& paths ) {
+    const set< BKLSimpleElement > conj = pr.first.getSimpleSummitConjugators( );
+    for( set< BKLSimpleElement >::const_iterator it=conj.begin( ) ; it!=conj.end( ) ; ++it ) {
+
+      // Conjugate the current element
+      const BKLLeftNormalForm res = pr.first.conjugate( *it );
+      if( sets.isChecked( res ) )
+        continue;
+
+      // Compute new conjugator
+      const BKLLeftNormalForm new_conjugator = pr.second.multiply( BKLLeftNormalForm( *it ) );
+
+      paths.push_back( vector< Vertex >( 1 , Vertex( res , new_conjugator ) ) );
+      if( sets.isInOther( res ) )
+        return true;
     }
-  }
+    return false;
+  };
+
+  const auto meeting = crag::braidgroup::summit::findMeeting( sss_new1 , sss_checked1 , sss_new2 , sss_checked2 , 1000000 , deadline , expand );
+  if( meeting.status==crag::braidgroup::summit::Meeting< BKLLeftNormalForm >::Status::Met )
+    return pair< bool , BKLLeftNormalForm >( true , meeting.first.multiply( -meeting.second ) );
   
-  cout << "Similar" << endl;
-  return pair<bool,Word>( true , Word( ) );
+  return pair< bool , BKLLeftNormalForm >( false , BKLLeftNormalForm( theRank ) );
 }
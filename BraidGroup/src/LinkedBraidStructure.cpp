@@ -2,280 +2,266 @@
 
 #include "LinkedBraidStructure.h"
 
-std::ostream& operator<<(std::ostream& os, const BraidNode& bn) {
-  os << &bn << "{ " << bn.type << "| " << bn.left << ", " << bn.ahead << ", " << bn.right << ", " << bn.back_left
-     << ", " << bn.back << ", " << bn.back_right << " }";
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
 
-  return os;
-}
+const BraidNode::Index BraidNode::kNone;
 
-LinkedBraidStructureTransform LinkedBraidStructure::make_EraseTransform(BraidNode* bn, int64_t pos) const {
-  return LinkedBraidStructureTransform(
-      bn->theNumber, pos, LinkedBraidStructureTransform::ERASED, bn->type, bn->left ? bn->left->theNumber : -1,
-      bn->ahead ? bn->ahead->theNumber : -1, bn->right ? bn->right->theNumber : -1,
-      bn->back_left ? bn->back_left->theNumber : -1, bn->back ? bn->back->theNumber : -1,
-      bn->back_right ? bn->back_right->theNumber : -1);
-}
+std::ostream& operator<<(std::ostream& os, const BraidNode& bn) {
+  os << "{ " << bn.type << "| " << bn.left << ", " << bn.ahead << ", " << bn.right << ", " << bn.back_left << ", "
+     << bn.back << ", " << bn.back_right << " }";
 
-LinkedBraidStructureTransform LinkedBraidStructure::make_AddTransform(BraidNode* bn, int64_t pos) const {
-  return LinkedBraidStructureTransform(bn->theNumber, pos, LinkedBraidStructureTransform::ADDED, bn->type);
+  return os;
 }
 
-LinkedBraidStructureTransform LinkedBraidStructure::make_ChangeType(BraidNode* bn, int64_t pos) const {
-  return LinkedBraidStructureTransform(bn->theNumber, pos, LinkedBraidStructureTransform::CHANGE_TYPE, bn->type);
-}
+class LinkedBraidStructure::NodeHeap {
+public:
+  explicit NodeHeap(std::vector<BraidNode>& nodes)
+      : nodes_(nodes) {}
 
-bool LinkedBraidStructure::operator<(const LinkedBraidStructure& lbs) const {
-  if (size() < lbs.size()) {
-    return true;
+  bool empty() const {
+    return heap_.empty();
   }
 
-  if (size() > lbs.size()) {
-    return false;
+  //! Removes and returns the smallest entry.
+  NODE pop() {
+    const auto result = heap_.front();
+    erase(result.node);
+    return result;
   }
 
-  if (the_index_ < lbs.the_index_) {
-    return true;
+  void insert(const NODE& n) {
+    heap_.push_back(n);
+    nodes_[n.node].heap_index = heap_.size() - 1;
+    siftUp_(heap_.size() - 1);
   }
 
-  if (the_index_ > lbs.the_index_) {
-    return false;
-  }
-
-  return translateIntoWord() < lbs.translateIntoWord();
-}
-
-LinkedBraidStructure::LinkedBraidStructure(size_t N)
-    : max_node_number_(0)
-    , the_index_(N)
-    , back_nodes_(std::vector<BraidNode*>(N, nullptr))
-    , front_nodes_(std::vector<BraidNode*>(N, nullptr)) {}
+  //! Removes the entry of the node (if any).
+  void erase(Index node) {
+    const auto i = nodes_[node].heap_index;
 
-LinkedBraidStructure::LinkedBraidStructure(size_t N, const Word& w)
-    : max_node_number_(0)
-    , the_index_(N)
-    , back_nodes_(std::vector<BraidNode*>(N, nullptr))
-    , front_nodes_(std::vector<BraidNode*>(N, nullptr)) {
-  for (auto w_it = w.begin(); w_it != w.end(); ++w_it) {
-    push_back(*w_it);
-  }
-}
+    if (i == BraidNode::kNone) {
+      return;
+    }
 
-LinkedBraidStructure& LinkedBraidStructure::operator=(const LinkedBraidStructure& LBS) {
-  // cout << "   #" << endl;
+    nodes_[node].heap_index = BraidNode::kNone;
 
-  the_index_ = LBS.the_index_;
-  the_nodes_ = LBS.the_nodes_;
-  max_node_number_ = LBS.max_node_number_;
-  back_nodes_ = LBS.back_nodes_;
-  front_nodes_ = LBS.front_nodes_;
+    if (i + 1 == static_cast<Index>(heap_.size())) {
+      heap_.pop_back();
+      return;
+    }
 
-  auto n_it1 = LBS.the_nodes_.begin();
-  auto n_it2 = the_nodes_.begin();
+    heap_[i] = heap_.back();
+    heap_.pop_back();
+    nodes_[heap_[i].node].heap_index = i;
 
-  for (; n_it1 != LBS.the_nodes_.end(); ++n_it1, ++n_it2) {
-    (*n_it1).second.link = &(*n_it2).second;
+    siftUp_(i);
+    siftDown_(nodes_[heap_[i].node].heap_index);
   }
 
-  n_it2 = the_nodes_.begin();
-
-  for (; n_it2 != the_nodes_.end(); ++n_it2) {
-    BraidNode& cur = (*n_it2).second;
-
-    if (cur.left) {
-      cur.left = cur.left->link;
+private:
+  void siftUp_(size_t i) {
+    for (; i > 0 && heap_[i] < heap_[(i - 1) / 2]; i = (i - 1) / 2) {
+      swap_(i, (i - 1) / 2);
     }
+  }
 
-    if (cur.ahead) {
-      cur.ahead = cur.ahead->link;
-    }
+  void siftDown_(size_t i) {
+    while (true) {
+      auto smallest = i;
 
-    if (cur.right) {
-      cur.right = cur.right->link;
-    }
+      for (const auto child : {2 * i + 1, 2 * i + 2}) {
+        if (child < heap_.size() && heap_[child] < heap_[smallest]) {
+          smallest = child;
+        }
+      }
 
-    if (cur.back_left) {
-      cur.back_left = cur.back_left->link;
-    }
+      if (smallest == i) {
+        return;
+      }
 
-    if (cur.back) {
-      cur.back = cur.back->link;
+      swap_(i, smallest);
+      i = smallest;
     }
+  }
 
-    if (cur.back_right) {
-      cur.back_right = cur.back_right->link;
-    }
+  void swap_(size_t i, size_t j) {
+    std::swap(heap_[i], heap_[j]);
+    nodes_[heap_[i].node].heap_index = i;
+    nodes_[heap_[j].node].heap_index = j;
   }
 
-  for (size_t i = 0; i < the_index_; ++i) {
-    if (back_nodes_[i]) {
-      back_nodes_[i] = back_nodes_[i]->link;
-    }
+  std::vector<BraidNode>& nodes_;
+  std::vector<NODE> heap_;
+};
 
-    if (front_nodes_[i]) {
-      front_nodes_[i] = front_nodes_[i]->link;
-    }
-  }
+LinkedBraidStructureTransform LinkedBraidStructure::make_EraseTransform(Index bn, int64_t pos) const {
+  const BraidNode& node = the_nodes_[bn];
 
-  LBS.clearLinks();
+  // kNone links are stored as -1
+  return LinkedBraidStructureTransform(
+      bn, pos, LinkedBraidStructureTransform::ERASED, node.type, node.left, node.ahead, node.right, node.back_left,
+      node.back, node.back_right);
+}
 
-  return *this;
+LinkedBraidStructureTransform LinkedBraidStructure::make_AddTransform(Index bn, int64_t pos) const {
+  return LinkedBraidStructureTransform(bn, pos, LinkedBraidStructureTransform::ADDED, the_nodes_[bn].type);
 }
 
-LinkedBraidStructure::LinkedBraidStructure(const LinkedBraidStructure& LBS)
-    : the_index_(LBS.the_index_)
-    , the_nodes_(LBS.the_nodes_)
-    , max_node_number_(LBS.max_node_number_)
-    , back_nodes_(LBS.back_nodes_)
-    , front_nodes_(LBS.front_nodes_) {
-  // cout << "   &" << endl;
-  auto n_it1 = LBS.the_nodes_.begin();
-  auto n_it2 = the_nodes_.begin();
+LinkedBraidStructureTransform LinkedBraidStructure::make_ChangeType(Index bn, int64_t pos) const {
+  return LinkedBraidStructureTransform(bn, pos, LinkedBraidStructureTransform::CHANGE_TYPE, the_nodes_[bn].type);
+}
 
-  for (; n_it1 != LBS.the_nodes_.end(); ++n_it1, ++n_it2) {
-    (*n_it1).second.link = &(*n_it2).second;
+bool LinkedBraidStructure::operator<(const LinkedBraidStructure& lbs) const {
+  if (size() < lbs.size()) {
+    return true;
   }
 
-  n_it2 = the_nodes_.begin();
-
-  for (; n_it2 != the_nodes_.end(); ++n_it2) {
-    BraidNode& cur = (*n_it2).second;
+  if (size() > lbs.size()) {
+    return false;
+  }
 
-    if (cur.left) {
-      cur.left = cur.left->link;
-    }
+  if (the_index_ < lbs.the_index_) {
+    return true;
+  }
 
-    if (cur.ahead) {
-      cur.ahead = cur.ahead->link;
-    }
+  if (the_index_ > lbs.the_index_) {
+    return false;
+  }
 
-    if (cur.right) {
-      cur.right = cur.right->link;
-    }
+  return translateIntoWord() < lbs.translateIntoWord();
+}
 
-    if (cur.back_left) {
-      cur.back_left = cur.back_left->link;
-    }
+LinkedBraidStructure::LinkedBraidStructure(size_t N)
+    : the_index_(N)
+    , front_nodes_(N, BraidNode::kNone)
+    , back_nodes_(N, BraidNode::kNone)
+    , size_(0) {}
 
-    if (cur.back) {
-      cur.back = cur.back->link;
-    }
+LinkedBraidStructure::LinkedBraidStructure(size_t N, const Word& w)
+    : LinkedBraidStructure(N) {
+  the_nodes_.reserve(w.length());
 
-    if (cur.back_right) {
-      cur.back_right = cur.back_right->link;
-    }
+  for (auto w_it = w.begin(); w_it != w.end(); ++w_it) {
+    push_back(*w_it);
   }
+}
 
-  for (size_t i = 0; i < the_index_; ++i) {
-    if (back_nodes_[i]) {
-      back_nodes_[i] = back_nodes_[i]->link;
-    }
+LinkedBraidStructure::Index LinkedBraidStructure::newNode(const BraidNode& node) {
+  ++size_;
 
-    if (front_nodes_[i]) {
-      front_nodes_[i] = front_nodes_[i]->link;
-    }
+  if (!free_nodes_.empty()) {
+    const auto n = free_nodes_.back();
+    free_nodes_.pop_back();
+    the_nodes_[n] = node;
+
+    return n;
   }
 
-  LBS.clearLinks();
+  if (the_nodes_.size() >= static_cast<size_t>(std::numeric_limits<Index>::max())) {
+    throw std::length_error("Too many nodes in LinkedBraidStructure.");
+  }
+
+  the_nodes_.push_back(node);
+
+  return the_nodes_.size() - 1;
 }
 
 LinkedBraidStructureTransform LinkedBraidStructure::push_back(int g) {
   int ag = std::abs(g);
-  BraidNode* left = (ag > 1) ? back_nodes_[ag - 2] : nullptr;
-  BraidNode* ahead = back_nodes_[ag - 1];
-  BraidNode* right = (ag < the_index_) ? back_nodes_[ag] : nullptr;
-
-  BraidNode& newNode = the_nodes_[max_node_number_] = BraidNode(max_node_number_, g > 0);
+  const Index left = (ag > 1) ? back_nodes_[ag - 2] : BraidNode::kNone;
+  const Index ahead = back_nodes_[ag - 1];
+  const Index right = (ag < the_index_) ? back_nodes_[ag] : BraidNode::kNone;
 
-  max_node_number_++;
+  const Index n = newNode(BraidNode(g > 0));
+  BraidNode& node = the_nodes_[n];
 
-  newNode.ahead = ahead;
+  node.ahead = ahead;
 
-  if (ahead) {
-    ahead->back = &newNode;
+  if (ahead != BraidNode::kNone) {
+    the_nodes_[ahead].back = n;
   }
 
-  if (!ahead || ahead && ahead->back_left) {
-    newNode.left = left;
+  if (ahead == BraidNode::kNone || the_nodes_[ahead].back_left != BraidNode::kNone) {
+    node.left = left;
 
-    if (left) {
-      left->back_right = &newNode;
+    if (left != BraidNode::kNone) {
+      the_nodes_[left].back_right = n;
     }
   }
 
-  if (!ahead || ahead && ahead->back_right) {
-    newNode.right = right;
+  if (ahead == BraidNode::kNone || the_nodes_[ahead].back_right != BraidNode::kNone) {
+    node.right = right;
 
-    if (right) {
-      right->back_left = &newNode;
+    if (right != BraidNode::kNone) {
+      the_nodes_[right].back_left = n;
     }
   }
 
-  if (!front_nodes_[ag - 1]) {
-    front_nodes_[ag - 1] = &newNode;
+  if (front_nodes_[ag - 1] == BraidNode::kNone) {
+    front_nodes_[ag - 1] = n;
   }
 
-  back_nodes_[ag - 1] = &newNode;
+  back_nodes_[ag - 1] = n;
 
-  return make_AddTransform(&newNode, ag - 1);
+  return make_AddTransform(n, ag - 1);
 }
 
 LinkedBraidStructureTransform LinkedBraidStructure::push_front(int g) {
   int ag = std::abs(g);
 
-  BraidNode* left = (ag > 1) ? front_nodes_[ag - 2] : 0;
-  BraidNode* ahead = front_nodes_[ag - 1];
-  BraidNode* right = (ag < the_index_) ? front_nodes_[ag] : 0;
+  const Index left = (ag > 1) ? front_nodes_[ag - 2] : BraidNode::kNone;
+  const Index ahead = front_nodes_[ag - 1];
+  const Index right = (ag < the_index_) ? front_nodes_[ag] : BraidNode::kNone;
 
-  BraidNode& newNode = the_nodes_[max_node_number_] = BraidNode(max_node_number_, g > 0);
+  const Index n = newNode(BraidNode(g > 0));
+  BraidNode& node = the_nodes_[n];
 
-  max_node_number_++;
+  node.back = ahead;
 
-  newNode.back = ahead;
-
-  if (ahead) {
-    ahead->ahead = &newNode;
+  if (ahead != BraidNode::kNone) {
+    the_nodes_[ahead].ahead = n;
   }
 
-  if (!ahead || ahead && ahead->left) {
-    newNode.back_left = left;
+  if (ahead == BraidNode::kNone || the_nodes_[ahead].left != BraidNode::kNone) {
+    node.back_left = left;
 
-    if (left) {
-      left->right = &newNode;
+    if (left != BraidNode::kNone) {
+      the_nodes_[left].right = n;
     }
   }
 
-  if (!ahead || ahead && ahead->right) {
-    newNode.back_right = right;
+  if (ahead == BraidNode::kNone || the_nodes_[ahead].right != BraidNode::kNone) {
+    node.back_right = right;
 
-    if (right) {
-      right->left = &newNode;
+    if (right != BraidNode::kNone) {
+      the_nodes_[right].left = n;
     }
   }
 
-  if (!back_nodes_[ag - 1]) {
-    back_nodes_[ag - 1] = &newNode;
+  if (back_nodes_[ag - 1] == BraidNode::kNone) {
+    back_nodes_[ag - 1] = n;
   }
 
-  front_nodes_[ag - 1] = &newNode;
+  front_nodes_[ag - 1] = n;
 
-  return make_AddTransform(&newNode, ag - 1);
+  return make_AddTransform(n, ag - 1);
 }
 
 void LinkedBraidStructure::removeLeftHandles(list<LinkedBraidStructureTransform>* result) {
-  // set of nodes to check (1st value = number of uppercrossings, 2nd value =
-  // -position in the Linked Structure)
-  node_set to_check;
+  // nodes to check (ordered by the number of uppercrossings, then by the
+  // position in the Linked Structure)
+  NodeHeap to_check(the_nodes_);
 
   // form the initial set of nodes to check (all nodes from the Linked
   // Structure)
   for (size_t i = 0; i < the_index_; ++i) {
-    for (BraidNode* c = front_nodes_[i]; c != back_nodes_[i]; c = c->back) {
+    for (Index c = front_nodes_[i]; c != back_nodes_[i]; c = the_nodes_[c].back) {
       const auto weight = checkIfStartsLeftHandle(i, c);
 
       if (weight != -1) {
-        c->weight = weight;
-        to_check.insert(NODE(weight, i, c));
+        to_check.insert(NODE{weight, static_cast<int64_t>(i), c});
       }
     }
   }
@@ -283,11 +269,10 @@ void LinkedBraidStructure::removeLeftHandles(list<LinkedBraidStructureTransform>
   // check the nodes one by one starting from the rightmost
   for (; !to_check.empty();) {
     // a. choose the node and remove it from to_check
-    NODE cur_node = *to_check.begin();
-    to_check.erase(to_check.begin());
+    const NODE cur_node = to_check.pop();
 
     // b. remove the handle
-    const auto weight = checkIfStartsLeftHandle(std::get<1>(cur_node), std::get<2>(cur_node));
+    const auto weight = checkIfStartsLeftHandle(cur_node.pos, cur_node.node);
 
     if (weight != -1) {
       removeLeftHandle(cur_node, to_check, result);
@@ -295,36 +280,37 @@ void LinkedBraidStructure::removeLeftHandles(list<LinkedBraidStructureTransform>
   }
 }
 
-int64_t LinkedBraidStructure::checkIfStartsLeftHandle(int64_t pos, BraidNode* bn) {
-  BraidNode* back = bn->back;
+int64_t LinkedBraidStructure::checkIfStartsLeftHandle(int64_t pos, Index bn) const {
+  const BraidNode& node = the_nodes_[bn];
+  const Index back = node.back;
 
   // if there is no more x_i
-  if (!back) {
+  if (back == BraidNode::kNone) {
     return -1;
   }
 
   // if there is an obstacle for handle
-  if (bn->back_right) {
+  if (node.back_right != BraidNode::kNone) {
     return -1;
   }
 
   // if crossings have the same orientation
-  if (bn->type == back->type) {
+  if (node.type == the_nodes_[back].type) {
     return -1;
   }
 
   // compute the number of upper crossings
-  BraidNode* l1 = bn->back_left;
-  BraidNode* l2 = back->left;
+  Index l1 = node.back_left;
+  const Index l2 = the_nodes_[back].left;
 
   int64_t counter = 0;
   bool crossingType;
 
-  for (; l1; l1 = l1->back) {
+  for (; l1 != BraidNode::kNone; l1 = the_nodes_[l1].back) {
     if (counter == 0) {
-      crossingType = l1->type;
+      crossingType = the_nodes_[l1].type;
     } else {
-      if (crossingType != l1->type) {
+      if (crossingType != the_nodes_[l1].type) {
         return -1;
       }
     }
@@ -339,61 +325,46 @@ int64_t LinkedBraidStructure::checkIfStartsLeftHandle(int64_t pos, BraidNode* bn
   return counter;
 }
 
-namespace {
-struct PairCmp {
-  using pair_t = std::pair<int64_t, BraidNode*>;
-  using int64_pair = std::pair<int64_t, int64_t>;
-
-  bool operator()(const pair_t& lhs, const pair_t& rhs) const {
-    return std::less<int64_pair>()(toInt64Pair(lhs), toInt64Pair(rhs));
-  }
-
-  int64_pair toInt64Pair(const pair_t& p) const {
-    return std::make_pair(p.first, p.second->theNumber);
-  }
-};
-} // namespace
-
 void LinkedBraidStructure::removeLeftHandle(
-    NODE node, node_set& to_check, std::list<LinkedBraidStructureTransform>* lst) {
-  const auto pos = std::get<1>(node);
+    const NODE& node, NodeHeap& to_check, std::list<LinkedBraidStructureTransform>* lst) {
+  const auto pos = node.pos;
 
-  BraidNode* n1 = std::get<2>(node);
-  BraidNode* n2 = n1->back;
+  const Index n1 = node.node;
+  const Index n2 = the_nodes_[n1].back;
 
-  bool type = n1->type;
+  bool type = the_nodes_[n1].type;
 
-  BraidNode* l1 = n1->back_left;
-  BraidNode* l2 = n2->left;
+  Index l1 = the_nodes_[n1].back_left;
+  const Index l2 = the_nodes_[n2].left;
 
   // Removal of a handle can introduce new handles. Here we store some nodes to
   // check. A few will be added later.
-  std::set<std::pair<int64_t, BraidNode*>, PairCmp> to_check2;
+  std::vector<std::pair<int64_t, Index>> to_check2;
 
-  if (n1->ahead) {
-    to_check2.insert(std::make_pair(pos, n1->ahead));
+  if (the_nodes_[n1].ahead != BraidNode::kNone) {
+    to_check2.emplace_back(pos, the_nodes_[n1].ahead);
   }
 
-  if (n1->left) {
-    to_check2.insert(std::make_pair(pos - 1, n1->left));
+  if (the_nodes_[n1].left != BraidNode::kNone) {
+    to_check2.emplace_back(pos - 1, the_nodes_[n1].left);
   }
 
-  for (BraidNode* cn = n1; cn; cn = cn->ahead) {
-    if (!cn->right) {
+  for (Index cn = n1; cn != BraidNode::kNone; cn = the_nodes_[cn].ahead) {
+    if (the_nodes_[cn].right == BraidNode::kNone) {
       continue;
     }
 
-    to_check2.insert(std::make_pair(pos + 1, cn->right));
+    to_check2.emplace_back(pos + 1, the_nodes_[cn].right);
 
     break;
   }
 
   // A. process left nodes
 
-  for (; l1;) {
-    BraidNode* l3 = l1->back;
-    BraidNode* new_node = insertBackRight(l1, pos, l1->type);
-    BraidNode* new_node2 = insertBackLeft(new_node, pos - 1, type);
+  for (; l1 != BraidNode::kNone;) {
+    const Index l3 = the_nodes_[l1].back;
+    const Index new_node = insertBackRight(l1, pos, the_nodes_[l1].type);
+    const Index new_node2 = insertBackLeft(new_node, pos - 1, type);
 
     if (lst) {
       lst->push_back(make_AddTransform(new_node, pos));
@@ -401,11 +372,11 @@ void LinkedBraidStructure::removeLeftHandle(
       lst->push_back(make_ChangeType(l1, pos));
     }
 
-    l1->type = !type;
-    to_check2.insert(std::make_pair(pos - 1, new_node2));
+    the_nodes_[l1].type = !type;
+    to_check2.emplace_back(pos - 1, new_node2);
 
     if (l1 == l2) {
-      to_check2.insert(std::make_pair(pos, new_node));
+      to_check2.emplace_back(pos, new_node);
       break;
     }
 
@@ -413,8 +384,8 @@ void LinkedBraidStructure::removeLeftHandle(
   }
 
   // B. Remove "boundary" crossings that formed a handle.
-  to_check.erase(NODE(n1->weight, pos, n1));
-  to_check.erase(NODE(n2->weight, pos, n2));
+  to_check.erase(n1);
+  to_check.erase(n2);
 
   if (lst) {
     lst->push_back(removeNode(n1, pos));
@@ -425,36 +396,30 @@ void LinkedBraidStructure::removeLeftHandle(
   }
 
   // Check if new handles were introduced.
-  for (auto c_it = to_check2.begin(); c_it != to_check2.end(); ++c_it) {
-    const auto pos = c_it->first;
-    BraidNode* bn = c_it->second;
-
-    const auto weight = checkIfStartsLeftHandle(pos, bn);
+  for (const auto& c : to_check2) {
+    const auto weight = checkIfStartsLeftHandle(c.first, c.second);
 
     if (weight != -1) {
-      // remove old version
-      to_check.erase(NODE(bn->weight, pos, bn));
-      // add a new
-      bn->weight = weight;
-      to_check.insert(NODE(weight, pos, bn));
+      // replace the old version
+      to_check.erase(c.second);
+      to_check.insert(NODE{weight, c.first, c.second});
     }
   }
 }
 
 void LinkedBraidStructure::removeRightHandles(list<LinkedBraidStructureTransform>* result) {
-  // set of nodes to check (1st value = number of uppercrossings, 2nd value =
+  // nodes to check (ordered by the number of uppercrossings, then by the
   // position in the Linked Structure)
-  node_set to_check;
+  NodeHeap to_check(the_nodes_);
 
   // form the initial set of nodes to check (all nodes from the Linked
   // Structure)
   for (size_t i = 0; i < the_index_; ++i) {
-    for (BraidNode* c = front_nodes_[i]; c != back_nodes_[i]; c = c->back) {
+    for (Index c = front_nodes_[i]; c != back_nodes_[i]; c = the_nodes_[c].back) {
       const auto weight = checkIfStartsRightHandle(i, c);
 
       if (weight != -1) {
-        c->weight = weight;
-        to_check.insert(NODE(weight, i, c));
+        to_check.insert(NODE{weight, static_cast<int64_t>(i), c});
       }
     }
   }
@@ -462,11 +427,10 @@ void LinkedBraidStructure::removeRightHandles(list<LinkedBraidStructureTransform
   // check the nodes one by one starting from the rightmost
   for (; !to_check.empty();) {
     // choose the node and remove it from to_check
-    NODE cur_node = *to_check.begin();
-    to_check.erase(to_check.begin());
+    const NODE cur_node = to_check.pop();
 
     // b. remove the handle
-    const auto weight = checkIfStartsRightHandle(std::get<1>(cur_node), std::get<2>(cur_node));
+    const auto weight = checkIfStartsRightHandle(cur_node.pos, cur_node.node);
 
     if (weight != -1) {
       removeRightHandle(cur_node, to_check, result);
@@ -474,36 +438,37 @@ void LinkedBraidStructure::removeRightHandles(list<LinkedBraidStructureTransform
   }
 }
 
-int64_t LinkedBraidStructure::checkIfStartsRightHandle(int64_t pos, BraidNode* bn) {
-  BraidNode* back = bn->back;
+int64_t LinkedBraidStructure::checkIfStartsRightHandle(int64_t pos, Index bn) const {
+  const BraidNode& node = the_nodes_[bn];
+  const Index back = node.back;
 
   // if there is no more x_i
-  if (!back) {
+  if (back == BraidNode::kNone) {
     return -1;
   }
 
   // if there is an obstacle for handle
-  if (bn->back_left) {
+  if (node.back_left != BraidNode::kNone) {
     return -1;
   }
 
   // if crossings have the same orientation
-  if (bn->type == back->type) {
+  if (node.type == the_nodes_[back].type) {
     return -1;
   }
 
   // compute the number of upper crossings
-  BraidNode* l1 = bn->back_right;
-  BraidNode* l2 = back->right;
+  Index l1 = node.back_right;
+  const Index l2 = the_nodes_[back].right;
 
   int64_t counter = 0;
   bool crossingType;
 
-  for (; l1; l1 = l1->back) {
+  for (; l1 != BraidNode::kNone; l1 = the_nodes_[l1].back) {
     if (counter == 0) {
-      crossingType = l1->type;
+      crossingType = the_nodes_[l1].type;
     } else {
-      if (crossingType != l1->type) {
+      if (crossingType != the_nodes_[l1].type) {
         return -1;
       }
     }
@@ -518,45 +483,45 @@ int64_t LinkedBraidStructure::checkIfStartsRightHandle(int64_t pos, BraidNode* b
   return counter;
 }
 
-void LinkedBraidStructure::removeRightHandle(NODE node, node_set& to_check, list<LinkedBraidStructureTransform>* lst) {
-  const auto pos = std::get<1>(node);
+void LinkedBraidStructure::removeRightHandle(
+    const NODE& node, NodeHeap& to_check, list<LinkedBraidStructureTransform>* lst) {
+  const auto pos = node.pos;
 
-  BraidNode* n1 = std::get<2>(node);
-  BraidNode* n2 = n1->back;
+  const Index n1 = node.node;
+  const Index n2 = the_nodes_[n1].back;
 
-  bool type = n1->type;
+  bool type = the_nodes_[n1].type;
 
-  BraidNode* r1 = n1->back_right;
-  BraidNode* r2 = n2->right;
+  Index r1 = the_nodes_[n1].back_right;
+  const Index r2 = the_nodes_[n2].right;
 
   // Removal of a handle can introduce new handles. Here we store some nodes to
   // check. A few will be added later.
-  std::set<std::pair<int64_t, BraidNode*>, PairCmp> to_check2;
+  std::vector<std::pair<int64_t, Index>> to_check2;
 
-  if (n1->ahead) {
-    to_check2.insert(std::make_pair(pos, n1->ahead));
+  if (the_nodes_[n1].ahead != BraidNode::kNone) {
+    to_check2.emplace_back(pos, the_nodes_[n1].ahead);
   }
 
-  if (n1->right) {
-    to_check2.insert(std::make_pair(pos + 1, n1->right));
+  if (the_nodes_[n1].right != BraidNode::kNone) {
+    to_check2.emplace_back(pos + 1, the_nodes_[n1].right);
   }
 
-  for (BraidNode* cn = n1; cn; cn = cn->ahead) {
-    if (!cn->left) {
+  for (Index cn = n1; cn != BraidNode::kNone; cn = the_nodes_[cn].ahead) {
+    if (the_nodes_[cn].left == BraidNode::kNone) {
       continue;
     }
 
-    to_check2.insert(std::make_pair(pos - 1, cn->left));
+    to_check2.emplace_back(pos - 1, the_nodes_[cn].left);
 
     break;
   }
 
   // B. process right nodes
-  for (; r1;) {
-    // cout << "Process right node" << endl;
-    BraidNode* r3 = r1->back;
-    BraidNode* new_node = insertBackLeft(r1, pos, r1->type);
-    BraidNode* new_node2 = insertBackRight(new_node, pos + 1, type);
+  for (; r1 != BraidNode::kNone;) {
+    const Index r3 = the_nodes_[r1].back;
+    const Index new_node = insertBackLeft(r1, pos, the_nodes_[r1].type);
+    const Index new_node2 = insertBackRight(new_node, pos + 1, type);
 
     if (lst) {
       lst->push_back(make_AddTransform(new_node, pos));
@@ -564,12 +529,12 @@ void LinkedBraidStructure::removeRightHandle(NODE node, node_set& to_check, list
       lst->push_back(make_ChangeType(r1, pos));
     }
 
-    r1->type = !type;
+    the_nodes_[r1].type = !type;
 
-    to_check2.insert(std::make_pair(pos + 1, new_node2));
+    to_check2.emplace_back(pos + 1, new_node2);
 
     if (r1 == r2) {
-      to_check2.insert(std::make_pair(pos, new_node));
+      to_check2.emplace_back(pos, new_node);
       break;
     }
 
@@ -577,8 +542,8 @@ void LinkedBraidStructure::removeRightHandle(NODE node, node_set& to_check, list
   }
 
   // B. Remove "boundary" crossings that formed a handle.
-  to_check.erase(NODE(n1->weight, pos, n1));
-  to_check.erase(NODE(n2->weight, pos, n2));
+  to_check.erase(n1);
+  to_check.erase(n2);
 
   if (lst) {
     lst->push_back(removeNode(n1, pos));
@@ -589,349 +554,348 @@ void LinkedBraidStructure::removeRightHandle(NODE node, node_set& to_check, list
   }
 
   // Check if new handles were introduced.
-  for (auto c_it = to_check2.begin(); c_it != to_check2.end(); ++c_it) {
-    const auto pos = c_it->first;
-    BraidNode* bn = c_it->second;
-
-    const auto weight = checkIfStartsRightHandle(pos, bn);
+  for (const auto& c : to_check2) {
+    const auto weight = checkIfStartsRightHandle(c.first, c.second);
 
     if (weight != -1) {
-      // remove old version
-      to_check.erase(NODE(bn->weight, pos, bn));
-      // add a new
-      bn->weight = weight;
-      to_check.insert(NODE(weight, pos, bn));
+      // replace the old version
+      to_check.erase(c.second);
+      to_check.insert(NODE{weight, c.first, c.second});
     }
   }
 }
 
-LinkedBraidStructureTransform LinkedBraidStructure::removeNode(BraidNode* bn, int64_t pos) {
-  LinkedBraidStructureTransform result = make_EraseTransform(bn, pos);
+LinkedBraidStructureTransform LinkedBraidStructure::removeNode(Index n, int64_t pos) {
+  LinkedBraidStructureTransform result = make_EraseTransform(n, pos);
+  BraidNode& bn = the_nodes_[n];
 
   // A. process left
-  if (bn->left) {
-    bn->left->back_right = bn->back_left ? nullptr : bn->back;
+  if (bn.left != BraidNode::kNone) {
+    the_nodes_[bn.left].back_right = bn.back_left != BraidNode::kNone ? BraidNode::kNone : bn.back;
   }
 
   // B. process ahead
-  if (bn->ahead) {
-    bn->ahead->back = bn->back;
+  if (bn.ahead != BraidNode::kNone) {
+    BraidNode& ahead = the_nodes_[bn.ahead];
+    ahead.back = bn.back;
 
-    if (!bn->ahead->back_left) {
-      bn->ahead->back_left = bn->back_left;
+    if (ahead.back_left == BraidNode::kNone) {
+      ahead.back_left = bn.back_left;
     }
 
-    if (!bn->ahead->back_right) {
-      bn->ahead->back_right = bn->back_right;
+    if (ahead.back_right == BraidNode::kNone) {
+      ahead.back_right = bn.back_right;
     }
   }
 
   // C. process right
-  if (bn->right) {
-    bn->right->back_left = bn->back_right ? nullptr : bn->back;
+  if (bn.right != BraidNode::kNone) {
+    the_nodes_[bn.right].back_left = bn.back_right != BraidNode::kNone ? BraidNode::kNone : bn.back;
   }
 
   // D. process back_left
-  if (bn->back_left) {
-    bn->back_left->right = bn->left ? nullptr : bn->ahead;
+  if (bn.back_left != BraidNode::kNone) {
+    the_nodes_[bn.back_left].right = bn.left != BraidNode::kNone ? BraidNode::kNone : bn.ahead;
   }
 
   // E. process back
-  if (bn->back) {
-    bn->back->ahead = bn->ahead;
+  if (bn.back != BraidNode::kNone) {
+    BraidNode& back = the_nodes_[bn.back];
+    back.ahead = bn.ahead;
 
-    if (!bn->back->left) {
-      bn->back->left = bn->left;
+    if (back.left == BraidNode::kNone) {
+      back.left = bn.left;
     }
 
-    if (!bn->back->right) {
-      bn->back->right = bn->right;
+    if (back.right == BraidNode::kNone) {
+      back.right = bn.right;
     }
   }
 
   // F. process back_right
-  if (bn->back_right) {
-    bn->back_right->left = bn->right ? nullptr : bn->ahead;
+  if (bn.back_right != BraidNode::kNone) {
+    the_nodes_[bn.back_right].left = bn.right != BraidNode::kNone ? BraidNode::kNone : bn.ahead;
   }
 
   // G. process front_nodes_ and back_nodes_
-  if (front_nodes_[pos] == bn) {
-    front_nodes_[pos] = bn->back;
+  if (front_nodes_[pos] == n) {
+    front_nodes_[pos] = bn.back;
   }
 
-  if (back_nodes_[pos] == bn) {
-    back_nodes_[pos] = bn->ahead;
+  if (back_nodes_[pos] == n) {
+    back_nodes_[pos] = bn.ahead;
   }
 
-  // H. finally delet the memory allocated for the node
-  the_nodes_.erase(bn->theNumber);
+  // H. finally free the number of the node
+  free_nodes_.push_back(n);
+  --size_;
 
   return result;
 }
 
-BraidNode* LinkedBraidStructure::insertBackLeft(BraidNode* bn, int64_t pos, bool type) {
+LinkedBraidStructure::Index LinkedBraidStructure::insertBackLeft(Index bn, int64_t pos, bool type) {
   // A. determine the "main" nodes around the new node
-  BraidNode* back = bn->back;
+  const Index back = the_nodes_[bn].back;
 
-  BraidNode* left = nullptr;
+  Index left = BraidNode::kNone;
 
-  for (BraidNode* c = bn; c != nullptr && !left; c = c->ahead) {
-    if (c->left) {
-      left = c->left;
-    }
+  for (Index c = bn; c != BraidNode::kNone && left == BraidNode::kNone; c = the_nodes_[c].ahead) {
+    left = the_nodes_[c].left;
   }
 
-  BraidNode* back_left = nullptr;
+  Index back_left = BraidNode::kNone;
 
-  for (BraidNode* c = bn; c != nullptr && !back_left; c = c->back) {
-    if (c->back_left) {
-      back_left = c->back_left;
-    }
+  for (Index c = bn; c != BraidNode::kNone && back_left == BraidNode::kNone; c = the_nodes_[c].back) {
+    back_left = the_nodes_[c].back_left;
   }
 
-  BraidNode* left_back_left;
+  Index left_back_left;
 
-  if (left) {
-    left_back_left = left->back_left;
-  } else if (back_left) {
-    if (!back_left->left) {
-      left_back_left = nullptr;
+  if (left != BraidNode::kNone) {
+    left_back_left = the_nodes_[left].back_left;
+  } else if (back_left != BraidNode::kNone) {
+    if (the_nodes_[back_left].left == BraidNode::kNone) {
+      left_back_left = BraidNode::kNone;
     } else {
-      left_back_left = pos > 0 ? front_nodes_[pos - 1] : nullptr;
+      left_back_left = pos > 0 ? front_nodes_[pos - 1] : BraidNode::kNone;
     }
   } else {
-    left_back_left = pos > 0 ? front_nodes_[pos - 1] : nullptr;
+    left_back_left = pos > 0 ? front_nodes_[pos - 1] : BraidNode::kNone;
   }
 
-  BraidNode* back_left_right;
+  Index back_left_right;
 
-  if (back_left) {
-    back_left_right = back_left->right != bn ? bn->back : nullptr;
+  if (back_left != BraidNode::kNone) {
+    back_left_right = the_nodes_[back_left].right != bn ? back : BraidNode::kNone;
   } else {
     back_left_right = back;
   }
 
   // B. create a new node and link it to other nodes
-  BraidNode& newNode = the_nodes_[max_node_number_] =
-      BraidNode(max_node_number_, type, nullptr, left, bn, left_back_left, back_left, back_left_right);
+  const Index n = newNode(BraidNode(type, BraidNode::kNone, left, bn, left_back_left, back_left, back_left_right));
 
-  max_node_number_++;
+  the_nodes_[bn].back_left = n;
 
-  bn->back_left = &newNode;
-
-  if (left) {
-    left->back = &newNode;
-    left->back_left = nullptr;
+  if (left != BraidNode::kNone) {
+    the_nodes_[left].back = n;
+    the_nodes_[left].back_left = BraidNode::kNone;
   }
 
-  if (back_left) {
-    back_left->ahead = &newNode;
-    back_left->right = back_left->right == bn ? nullptr : back_left->right;
+  if (back_left != BraidNode::kNone) {
+    the_nodes_[back_left].ahead = n;
+
+    if (the_nodes_[back_left].right == bn) {
+      the_nodes_[back_left].right = BraidNode::kNone;
+    }
   }
 
-  if (left_back_left) {
-    left_back_left->right = &newNode;
+  if (left_back_left != BraidNode::kNone) {
+    the_nodes_[left_back_left].right = n;
   }
 
-  if (back_left_right) {
-    back_left_right->left = &newNode;
+  if (back_left_right != BraidNode::kNone) {
+    the_nodes_[back_left_right].left = n;
   }
 
-  if (!newNode.back) {
-    back_nodes_[pos] = &newNode;
+  if (the_nodes_[n].back == BraidNode::kNone) {
+    back_nodes_[pos] = n;
   }
 
-  if (!newNode.ahead) {
-    front_nodes_[pos] = &newNode;
+  if (the_nodes_[n].ahead == BraidNode::kNone) {
+    front_nodes_[pos] = n;
   }
 
-  return &newNode;
+  return n;
 }
 
-BraidNode* LinkedBraidStructure::insertBackRight(BraidNode* bn, int64_t pos, bool type) {
+LinkedBraidStructure::Index LinkedBraidStructure::insertBackRight(Index bn, int64_t pos, bool type) {
   // A. determine the "main" nodes around the new node
-  BraidNode* back = bn->back;
+  const Index back = the_nodes_[bn].back;
 
-  BraidNode* right = nullptr;
+  Index right = BraidNode::kNone;
 
-  for (BraidNode* c = bn; c != nullptr && !right; c = c->ahead) {
-    if (c->right) {
-      right = c->right;
-    }
+  for (Index c = bn; c != BraidNode::kNone && right == BraidNode::kNone; c = the_nodes_[c].ahead) {
+    right = the_nodes_[c].right;
   }
 
-  BraidNode* back_right = nullptr;
+  Index back_right = BraidNode::kNone;
 
-  for (BraidNode* c = bn; c != nullptr && !back_right; c = c->back) {
-    if (c->back_right) {
-      back_right = c->back_right;
-    }
+  for (Index c = bn; c != BraidNode::kNone && back_right == BraidNode::kNone; c = the_nodes_[c].back) {
+    back_right = the_nodes_[c].back_right;
   }
 
-  BraidNode* right_back_right;
+  Index right_back_right;
 
-  if (right) {
-    right_back_right = right->back_right;
-  } else if (back_right) {
-    if (!back_right->right) {
-      right_back_right = nullptr;
+  if (right != BraidNode::kNone) {
+    right_back_right = the_nodes_[right].back_right;
+  } else if (back_right != BraidNode::kNone) {
+    if (the_nodes_[back_right].right == BraidNode::kNone) {
+      right_back_right = BraidNode::kNone;
     } else {
-      right_back_right = (pos + 1 < the_index_) ? front_nodes_[pos + 1] : nullptr;
+      right_back_right = (pos + 1 < the_index_) ? front_nodes_[pos + 1] : BraidNode::kNone;
     }
   } else {
-    right_back_right = (pos + 1 < the_index_) ? front_nodes_[pos + 1] : nullptr;
+    right_back_right = (pos + 1 < the_index_) ? front_nodes_[pos + 1] : BraidNode::kNone;
   }
 
-  BraidNode* back_right_left;
-  if (back_right) {
-    back_right_left = back_right->left != bn ? bn->back : nullptr;
+  Index back_right_left;
+
+  if (back_right != BraidNode::kNone) {
+    back_right_left = the_nodes_[back_right].left != bn ? back : BraidNode::kNone;
   } else {
     back_right_left = back;
   }
 
   // B. create a new node and link it to other nodes
-  BraidNode& newNode = the_nodes_[max_node_number_] =
-      BraidNode(max_node_number_, type, bn, right, nullptr, back_right_left, back_right, right_back_right);
-
-  max_node_number_++;
+  const Index n = newNode(BraidNode(type, bn, right, BraidNode::kNone, back_right_left, back_right, right_back_right));
 
-  bn->back_right = &newNode;
+  the_nodes_[bn].back_right = n;
 
-  if (right) {
-    right->back = &newNode;
-    right->back_right = nullptr;
+  if (right != BraidNode::kNone) {
+    the_nodes_[right].back = n;
+    the_nodes_[right].back_right = BraidNode::kNone;
   }
 
-  if (back_right) {
-    back_right->ahead = &newNode;
-    back_right->left = back_right->left == bn ? nullptr : back_right->left;
+  if (back_right != BraidNode::kNone) {
+    the_nodes_[back_right].ahead = n;
+
+    if (the_nodes_[back_right].left == bn) {
+      the_nodes_[back_right].left = BraidNode::kNone;
+    }
   }
 
-  if (back_right_left) {
-    back_right_left->right = &newNode;
+  if (back_right_left != BraidNode::kNone) {
+    the_nodes_[back_right_left].right = n;
   }
 
-  if (right_back_right) {
-    right_back_right->left = &newNode;
+  if (right_back_right != BraidNode::kNone) {
+    the_nodes_[right_back_right].left = n;
   }
 
   // update back_nodes_ and front_nodes_
-  if (!newNode.back) {
-    back_nodes_[pos] = &newNode;
+  if (the_nodes_[n].back == BraidNode::kNone) {
+    back_nodes_[pos] = n;
   }
 
-  if (!newNode.ahead) {
-    front_nodes_[pos] = &newNode;
+  if (the_nodes_[n].ahead == BraidNode::kNone) {
+    front_nodes_[pos] = n;
   }
 
-  return &newNode;
+  return n;
 }
 
-BraidNode* LinkedBraidStructure::insert(const LinkedBraidStructureTransform& lbst) {
-  BraidNode& newNode = the_nodes_[lbst.theNumber] = BraidNode(
-      lbst.theNumber, lbst.type, lbst.left == -1 ? nullptr : &the_nodes_[lbst.left],
-      lbst.ahead == -1 ? nullptr : &the_nodes_[lbst.ahead], lbst.right == -1 ? nullptr : &the_nodes_[lbst.right],
-      lbst.back_left == -1 ? nullptr : &the_nodes_[lbst.back_left], lbst.back == -1 ? nullptr : &the_nodes_[lbst.back],
-      lbst.back_right == -1 ? nullptr : &the_nodes_[lbst.back_right]);
+LinkedBraidStructure::Index LinkedBraidStructure::insert(const LinkedBraidStructureTransform& lbst) {
+  const Index n = lbst.theNumber;
+
+  if (the_nodes_.size() <= static_cast<size_t>(n)) {
+    the_nodes_.resize(n + 1);
+  } else if (!free_nodes_.empty() && free_nodes_.back() == n) {
+    // the usual case, transforms are undone in the reverse order
+    free_nodes_.pop_back();
+  } else {
+    free_nodes_.erase(std::remove(free_nodes_.begin(), free_nodes_.end(), n), free_nodes_.end());
+  }
+
+  // erased links are stored as -1 == kNone
+  BraidNode& node = the_nodes_[n] =
+      BraidNode(lbst.type, lbst.left, lbst.ahead, lbst.right, lbst.back_left, lbst.back, lbst.back_right);
+  ++size_;
 
   // A. determine the "main" nodes around the new node
-  if (newNode.left) {
-    newNode.left->back_right = &newNode;
+  if (node.left != BraidNode::kNone) {
+    the_nodes_[node.left].back_right = n;
   }
 
-  if (newNode.ahead) {
-    newNode.ahead->back = &newNode;
+  if (node.ahead != BraidNode::kNone) {
+    BraidNode& ahead = the_nodes_[node.ahead];
+    ahead.back = n;
 
-    if (!newNode.left) {
-      newNode.ahead->back_left = nullptr;
+    if (node.left == BraidNode::kNone) {
+      ahead.back_left = BraidNode::kNone;
     }
 
-    if (!newNode.right) {
-      newNode.ahead->back_right = nullptr;
+    if (node.right == BraidNode::kNone) {
+      ahead.back_right = BraidNode::kNone;
     }
   }
 
-  if (newNode.right) {
-    newNode.right->back_left = &newNode;
+  if (node.right != BraidNode::kNone) {
+    the_nodes_[node.right].back_left = n;
   }
 
-  if (newNode.back_left) {
-    newNode.back_left->right = &newNode;
+  if (node.back_left != BraidNode::kNone) {
+    the_nodes_[node.back_left].right = n;
   }
 
-  if (newNode.back) {
-    newNode.back->ahead = &newNode;
+  if (node.back != BraidNode::kNone) {
+    BraidNode& back = the_nodes_[node.back];
+    back.ahead = n;
 
-    if (!newNode.back_left) {
-      newNode.back->left = nullptr;
+    if (node.back_left == BraidNode::kNone) {
+      back.left = BraidNode::kNone;
     }
 
-    if (!newNode.back_right) {
-      newNode.back->right = nullptr;
+    if (node.back_right == BraidNode::kNone) {
+      back.right = BraidNode::kNone;
     }
   }
 
-  if (newNode.back_right) {
-    newNode.back_right->left = &newNode;
+  if (node.back_right != BraidNode::kNone) {
+    the_nodes_[node.back_right].left = n;
   }
 
   // B. update back_nodes_ and front_nodes_
-  if (!newNode.back) {
-    back_nodes_[lbst.thePosition] = &newNode;
+  if (node.back == BraidNode::kNone) {
+    back_nodes_[lbst.thePosition] = n;
   }
 
-  if (!newNode.ahead) {
-    front_nodes_[lbst.thePosition] = &newNode;
+  if (node.ahead == BraidNode::kNone) {
+    front_nodes_[lbst.thePosition] = n;
   }
 
-  return &newNode;
+  return n;
 }
 
-void LinkedBraidStructure::processTree(int al, BraidNode* node, Word& result) const {
-  if (node->back_left && !node->back_left->link) {
-    processTree(al - 1, node->back_left, result);
+void LinkedBraidStructure::processTree(int al, Index n, std::vector<bool>& visited, Word& result) const {
+  const BraidNode& node = the_nodes_[n];
+
+  if (node.back_left != BraidNode::kNone && !visited[node.back_left]) {
+    processTree(al - 1, node.back_left, visited, result);
   }
 
-  if (node->back_right && !node->back_right->link) {
-    processTree(al + 1, node->back_right, result);
+  if (node.back_right != BraidNode::kNone && !visited[node.back_right]) {
+    processTree(al + 1, node.back_right, visited, result);
   }
 
-  if (node->back && !node->back->link) {
-    processTree(al, node->back, result);
+  if (node.back != BraidNode::kNone && !visited[node.back]) {
+    processTree(al, node.back, visited, result);
   }
 
-  result.push_front(node->type ? al : -al);
+  result.push_front(node.type ? al : -al);
 
-  node->link = node;
+  visited[n] = true;
 }
 
 Word LinkedBraidStructure::translateIntoWord() const {
   Word result;
+  std::vector<bool> visited(the_nodes_.size(), false);
 
   for (size_t i = 0; i < the_index_; ++i) {
-    if (front_nodes_[i] && !front_nodes_[i]->link) {
-      processTree(i + 1, front_nodes_[i], result);
+    if (front_nodes_[i] != BraidNode::kNone && !visited[front_nodes_[i]]) {
+      processTree(i + 1, front_nodes_[i], visited, result);
     }
   }
 
-  clearLinks();
-
   return result;
 }
 
-void LinkedBraidStructure::clearLinks() const {
-  auto n_it = the_nodes_.begin();
-
-  for (; n_it != the_nodes_.end(); ++n_it) {
-    (*n_it).second.link = nullptr;
-  }
-}
-
 void LinkedBraidStructure::clear() {
   the_nodes_.clear();
+  free_nodes_.clear();
+  size_ = 0;
 
-  front_nodes_ = std::vector<BraidNode*>(the_index_, nullptr);
-  back_nodes_ = std::vector<BraidNode*>(the_index_, nullptr);
+  front_nodes_.assign(the_index_, BraidNode::kNone);
+  back_nodes_.assign(the_index_, BraidNode::kNone);
 }
 
 void LinkedBraidStructure::undo(const std::list<LinkedBraidStructureTransform>& lbst_seq) {
@@ -944,7 +908,7 @@ void LinkedBraidStructure::undo(const std::list<LinkedBraidStructureTransform>&
 
 void LinkedBraidStructure::undo(const LinkedBraidStructureTransform& lbst) {
   if (lbst.theTransform == LinkedBraidStructureTransform::ADDED) {
-    removeNode(&the_nodes_[lbst.theNumber], lbst.thePosition);
+    removeNode(lbst.theNumber, lbst.thePosition);
   } else if (lbst.theTransform == LinkedBraidStructureTransform::ERASED) {
     insert(lbst);
   } else if (lbst.theTransform == LinkedBraidStructureTransform::CHANGE_TYPE) {
@@ -4,17 +4,26 @@
 #include "LinkedBraidStructure.h"
 #include "ThRightNormalForm.h"
 #include "braid_group.h"
+#include "parallel.h"
 
 LinkedBraidStructure shortenLBS(LinkedBraidStructure& lbs) {
-  LinkedBraidStructure result = lbs;
+  // instead of copying the structure on every improvement keep the changes made since the best one
+  std::list<LinkedBraidStructureTransform> since_best;
+  auto best_size = lbs.size();
+
   for (int i = 0; i < 4; ++i) {
     if (i % 2 == 0)
-      lbs.removeRightHandles();
+      lbs.removeRightHandles(&since_best);
     else
-      lbs.removeLeftHandles();
-    if (result.size() > lbs.size())
-      result = lbs;
+      lbs.removeLeftHandles(&since_best);
+    if (best_size > lbs.size()) {
+      best_size = lbs.size();
+      since_best.clear();
+    }
   }
+
+  LinkedBraidStructure result = lbs;
+  result.undo(since_best);
   return result;
 }
 
@@ -33,50 +42,75 @@ Word garsideDehornoy(int N, const Word& w) {
 
 Word shortenBraid(int N, const Word& w) {
   LinkedBraidStructure df(N - 1, w);
-  LinkedBraidStructure result = df;
+
+  // the changes made since the shortest structure met so far, undone at the end
+  std::list<LinkedBraidStructureTransform> since_best;
+  auto best_size = df.size();
 
   for (int i = 0; i < 4; ++i) {
     if (i % 2 == 0) {
-      df.removeRightHandles();
+      df.removeRightHandles(&since_best);
     } else {
-      df.removeLeftHandles();
+      df.removeLeftHandles(&since_best);
     }
 
-    if (df.size() < result.size()) {
-      result = df;
+    if (df.size() < best_size) {
+      best_size = df.size();
+      since_best.clear();
     }
   }
 
-  return result.translateIntoWord();
+  df.undo(since_best);
+  return df.translateIntoWord();
 }
 
-Word shortenBraid2(int n, const Word& w) {
-  //  return shortenBraid(n, w);
+namespace {
 
+//! Common part of shortenBraid2 and parallelShortenBraid2.
+/*!
+  Every level shortens the segments of the current word of length step independently, for_each(k, fn) must invoke
+  fn(i) for each i = 0,...,k-1. If adaptive is true, the level following a level which shortened the word by less
+  than 1/64 of its length is skipped.
+*/
+template <typename ForEach>
+Word shortenBraid2_(int n, const Word& w, ForEach for_each, bool adaptive) {
   std::vector<int> result(w.begin(), w.end());
 
   for (size_t step = 16; step < result.size(); step *= 2) {
-    std::vector<int> interm_result;
-    interm_result.reserve(result.size());
+    const auto segments_count = (result.size() + step - 1) / step;
+    std::vector<std::vector<int>> short_segs(segments_count);
 
-    for (size_t i = 0; i < result.size(); i += step) {
-      const auto begin = i;
-      const auto end = std::min(i + step, result.size());
+    for_each(segments_count, [&](size_t i) {
+      const auto begin = i * step;
+      const auto end = std::min(begin + step, result.size());
 
       Word seg(result.begin() + begin, result.begin() + end);
 
       const auto short_seg = shortenBraid(n, seg);
 
       if (seg.length() <= short_seg.length()) {
-        interm_result.insert(interm_result.end(), result.begin() + begin, result.begin() + end);
+        short_segs[i].assign(result.begin() + begin, result.begin() + end);
       } else {
-        interm_result.insert(interm_result.end(), short_seg.begin(), short_seg.end());
+        short_segs[i].assign(short_seg.begin(), short_seg.end());
       }
+    });
+
+    std::vector<int> interm_result;
+    interm_result.reserve(result.size());
+
+    for (const auto& seg : short_segs) {
+      interm_result.insert(interm_result.end(), seg.begin(), seg.end());
     }
 
+    const auto gain = result.size() - std::min(result.size(), interm_result.size());
+
     if (interm_result.size() < result.size()) {
       result = interm_result;
     }
+
+    if (adaptive && gain * 64 < result.size()) {
+      step *= 2;
+    }
   }
 
   const auto result_word = Word(result);
@@ -89,6 +123,23 @@ Word shortenBraid2(int n, const Word& w) {
 
   return result_word;
 }
+} // namespace
+
+Word shortenBraid2(int n, const Word& w) {
+  const auto for_each = [](size_t k, const auto& fn) {
+    for (size_t i = 0; i < k; ++i) {
+      fn(i);
+    }
+  };
+
+  return shortenBraid2_(n, w, for_each, false);
+}
+
+Word parallelShortenBraid2(int n, const Word& w, bool adaptive) {
+  const auto for_each = [](size_t k, const auto& fn) { crag::parallel::forEach(k, fn); };
+
+  return shortenBraid2_(n, w, for_each, adaptive);
+}
 
 Word shortBraidForm(int N, const Word& w) {
   crag::braidgroup::BraidGroup B(N);
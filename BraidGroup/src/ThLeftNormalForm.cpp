@@ -11,16 +11,17 @@
 #include "ThLeftNormalForm.h"
 #include "ThRightNormalForm.h"
 #include "braid_group.h"
+#include "summit_set_search.h"
 #include "Word.h"
 #include <time.h>
 
 
 ostream& operator << ( ostream& os, const ThLeftNormalForm& rep )
 {
-  const list< Permutation >& decomposition = rep.getDecomposition( );
+  const vector< Permutation >& decomposition = rep.getDecomposition( );
   
   os << "Power = " << rep.getPower( ) << endl;
-  list< Permutation >::const_iterator it = decomposition.begin( );
+  vector< Permutation >::const_iterator it = decomposition.begin( );
   for( ; it!=decomposition.end( ) ; ++it )
     os << (*it) << endl;
   os << "Rank = "  << rep.getRank ( ) << endl;
@@ -42,8 +43,9 @@ ThLeftNormalForm::operator ThRightNormalForm( ) const
     return nf;
   }
   
-  list< Permutation > D;
-  for( list< Permutation >::const_iterator d_it=theDecomposition.begin( ) ; d_it!=theDecomposition.end( ) ; ++d_it )
+  vector< Permutation > D;
+  D.reserve( theDecomposition.size( ) );
+  for( vector< Permutation >::const_iterator d_it=theDecomposition.begin( ) ; d_it!=theDecomposition.end( ) ; ++d_it )
     D.push_back( (*d_it).flip( ) );
   
   ThRightNormalForm nf( theRank , theOmegaPower , D );
@@ -74,10 +76,9 @@ bool ThLeftNormalForm::operator==( const ThLeftNormalForm& rep ) const
 ThLeftNormalForm::ThLeftNormalForm( const crag::braidgroup::BraidGroup& G , const Word& w ) :
   theRank( G.getRank( ) )
 {
-  Word reversed_w;
-  for( Word::const_iterator w_it=w.begin( ) ; w_it!=w.end( ) ; ++w_it )
-    reversed_w.push_front( *w_it );
-  ThRightNormalForm F( G , reversed_w );
+  vector< int > letters( w.begin( ) , w.end( ) );
+  std::reverse( letters.begin( ) , letters.end( ) );
+  ThRightNormalForm F( G , Word( letters ) );
   
   NF pr ( theRank , F.getPower() , F.getDecomposition( ) );
   reverse( pr );
@@ -94,11 +95,10 @@ ThLeftNormalForm::ThLeftNormalForm( const crag::braidgroup::BraidGroup& G , cons
 
 void ThLeftNormalForm::reverse( ThLeftNormalForm::NF& pr )
 {
-  list<Permutation> rev_list;
-  list<Permutation>::iterator it = pr.third.begin( );
+  std::reverse( pr.third.begin( ) , pr.third.end( ) );
+  vector<Permutation>::iterator it = pr.third.begin( );
   for( ; it!=pr.third.end( ) ; ++it )
-    rev_list.push_front( -*it );
-  pr.third = rev_list;
+    *it = -*it;
 }
 
 
@@ -107,7 +107,7 @@ void ThLeftNormalForm::reverse( ThLeftNormalForm::NF& pr )
 //---------------------------------------------------------------------------//
 
 
-void ThLeftNormalForm::adjustDecomposition( int rank , int& power , list<Permutation>& decomp )
+void ThLeftNormalForm::adjustDecomposition( int rank , int& power , vector<Permutation>& decomp )
 {
   NF pr( rank , power , decomp );
   reverse( pr );
@@ -155,6 +155,21 @@ ThLeftNormalForm ThLeftNormalForm::multiply( const ThLeftNormalForm& rep ) const
 }
 
 
+//---------------------------------------------------------------------------//
+//---------------------------------- hash -----------------------------------//
+//---------------------------------------------------------------------------//
+
+
+size_t ThLeftNormalForm::hash( ) const
+{
+  size_t result = theRank;
+  result ^= size_t( theOmegaPower ) + 0x9e3779b9 + ( result<<6 ) + ( result>>2 );
+  for( vector< Permutation >::const_iterator it=theDecomposition.begin( ) ; it!=theDecomposition.end( ) ; ++it )
+    result ^= (*it).hash( ) + 0x9e3779b9 + ( result<<6 ) + ( result>>2 );
+  return result;
+}
+
+
 //---------------------------------------------------------------------------//
 //-------------------------------- getWord ----------------------------------//
 //---------------------------------------------------------------------------//
@@ -264,8 +279,8 @@ pair< ThLeftNormalForm , ThLeftNormalForm > ThLeftNormalForm::cycle( ) const
   Permutation first = *(theDecomposition.begin( ));
   if( theOmegaPower%2!=0 )
     first = first.flip( );
-  result.theDecomposition.push_back( first );
-  result.theDecomposition.pop_front( );
+  std::rotate( result.theDecomposition.begin( ) , ++result.theDecomposition.begin( ) , result.theDecomposition.end( ) );
+  result.theDecomposition.back( ) = first;
   result.adjust( );
   
   return pair< ThLeftNormalForm , ThLeftNormalForm >( result , ThLeftNormalForm(first) );
@@ -284,11 +299,11 @@ pair< ThLeftNormalForm , ThLeftNormalForm > ThLeftNormalForm::decycle( ) const
   
   ThLeftNormalForm result = *this;
   Permutation last = *(--theDecomposition.end( ));
+  std::rotate( result.theDecomposition.begin( ) , --result.theDecomposition.end( ) , result.theDecomposition.end( ) );
   if( theOmegaPower%2==0 )
-    result.theDecomposition.push_front( last );
+    result.theDecomposition.front( ) = last;
   else 
-    result.theDecomposition.push_front( last.flip( ) );
-  result.theDecomposition.pop_back( );
+    result.theDecomposition.front( ) = last.flip( );
   result.adjust( );
   
   return pair< ThLeftNormalForm , ThLeftNormalForm >( result , -ThLeftNormalForm(last) );
@@ -456,14 +471,14 @@ triple< ThLeftNormalForm , ThLeftNormalForm , int > ThLeftNormalForm::findUSSRep
   result = sss.first;
   
   // Cycle until get into a loop
-  map< ThLeftNormalForm , pair< ThLeftNormalForm , int > > trajectory;
+  unordered_map< ThLeftNormalForm , pair< ThLeftNormalForm , int > > trajectory;
   trajectory[result] = pair< ThLeftNormalForm , int >( conjugator , 0 );
   for( int c=0 ; 1 ; ++c ) {
     
     pair< ThLeftNormalForm , ThLeftNormalForm > pr = result.cycle( );
     result = pr.first;
     conjugator *= pr.second;
-    map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >::iterator t_it = trajectory.find( result );
+    unordered_map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >::iterator t_it = trajectory.find( result );
     if( t_it==trajectory.end( ) )
       trajectory[result] = pair< ThLeftNormalForm , int >( conjugator , c+1 );
     else
@@ -491,7 +506,7 @@ Permutation ThLeftNormalForm::getPullback( const Permutation& s ) const
   B1 = Delta * -B1;
   Permutation b0 = -B1 * B1.LeftLCM( s.flip( ) );
 
-  for( list< Permutation >::const_iterator d_it=++theDecomposition.begin( ) ; d_it!=theDecomposition.end( ) ; ++d_it ) {
+  for( vector< Permutation >::const_iterator d_it=++theDecomposition.begin( ) ; d_it!=theDecomposition.end( ) ; ++d_it ) {
     const Permutation& B = *d_it;
     b1 = -B * B.LeftLCM( b1 );
   }
@@ -652,10 +667,10 @@ set< pair< Permutation , bool > > ThLeftNormalForm::getSimpleUltraConjugators( i
 
 pair< bool , ThLeftNormalForm > 
 ThLeftNormalForm::ussAddTrajectory( const ThLeftNormalForm& new_elt , const ThLeftNormalForm& new_conj , 
-				    map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_new1 , 
-				    map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_checked1 , 
-				    const map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_new2 , 
-				    const map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_checked2 ) const
+				    unordered_map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_new1 , 
+				    unordered_map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_checked1 , 
+				    const unordered_map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_new2 , 
+				    const unordered_map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_checked2 ) const
 {
   pair< bool , ThLeftNormalForm >  result;
   
@@ -665,7 +680,7 @@ ThLeftNormalForm::ussAddTrajectory( const ThLeftNormalForm& new_elt , const ThLe
   do {
     
     // a. Check if the new element belongs to the other USS. Stop if true.
-    map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >::const_iterator uss_it = uss_new2.find( cur_res );
+    unordered_map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >::const_iterator uss_it = uss_new2.find( cur_res );
     if( uss_it!=uss_new2.end( ) )
       return pair< bool , ThLeftNormalForm >( true , (*uss_it).second.first * -new_conjugator );
     
@@ -684,49 +699,6 @@ ThLeftNormalForm::ussAddTrajectory( const ThLeftNormalForm& new_elt , const ThLe
   return result;
 }
 
-//---------------------------------------------------------------------------//
-//------------------------- sssConstructionIteration ------------------------//
-//---------------------------------------------------------------------------//
-
-
-pair< bool , ThLeftNormalForm > 
-ThLeftNormalForm::ussConstructionIteration( map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_new1 , 
-					    map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_checked1 , 
-					    const map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_new2 , 
-					    const map< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& uss_checked2 ) const
-{
-  const Permutation omega = Permutation::getHalfTwistPermutation( theRank );
-  
-  const pair< ThLeftNormalForm , pair< ThLeftNormalForm , int > > pr = *uss_new1.begin( );
-  uss_checked1[pr.first] = pr.second;
-  uss_new1.erase( uss_new1.begin( ) );
-  
-  // 1. compute the set of simple summit conjugators 
-  set< pair< Permutation , bool > > conj = pr.first.getSimpleUltraConjugators( pr.second.second );
-  for( set< pair< Permutation , bool > > ::iterator it=conj.begin( ) ; it!=conj.end( ) ; ++it ) {
-    
-    // Conjugate the current element
-    ThLeftNormalForm conj( (*it).first );
-    ThLeftNormalForm res = -conj * pr.first * conj;
-    
-    // Check if the element is new
-    if( uss_new1.find( res )!=uss_new1.end( ) ||
-      uss_checked1.find( res )!=uss_checked1.end( ) )
-      continue;
-    
-    // Compute new conjugator
-    ThLeftNormalForm new_conjugator = pr.second.first * conj;
-    
-    pair< bool , ThLeftNormalForm > traj_add_result = 
-      ussAddTrajectory( res , new_conjugator , uss_new1 , uss_checked1 , uss_new2 , uss_checked2 );
-    if( traj_add_result.first )
-      return traj_add_result;
-  }
-  
-  return pair<bool,ThLeftNormalForm>( false , ThLeftNormalForm( theRank ) );
-}
-
-
 //---------------------------------------------------------------------------//
 //----------------------------- areConjugate_uss ----------------------------//
 //---------------------------------------------------------------------------//
@@ -737,7 +709,7 @@ pair< bool , ThLeftNormalForm > ThLeftNormalForm::areConjugate_uss( const ThLeft
   if( theRank!=rep.theRank )
     return pair< bool , ThLeftNormalForm >( false , ThLeftNormalForm( theRank ) );
   
-  int init_time = time(0);
+  const auto deadline = crag::braidgroup::summit::Clock::now( ) + std::chrono::seconds( time_sec_bound );
   
   // 1. find representative of SSS1
   triple< ThLeftNormalForm , ThLeftNormalForm , int > tr1 =     findUSSRepresentative( );
@@ -755,10 +727,10 @@ pair< bool , ThLeftNormalForm > ThLeftNormalForm::areConjugate_uss( const ThLeft
     return pair< bool , ThLeftNormalForm >( true , tr2.second * -tr1.second );
   
   // 3. construct ultra summit sets
-  map< ThLeftNormalForm , pair< ThLeftNormalForm , int > > uss_new1;
-  map< ThLeftNormalForm , pair< ThLeftNormalForm , int > > uss_checked1;
-  map< ThLeftNormalForm , pair< ThLeftNormalForm , int > > uss_new2;
-  map< ThLeftNormalForm , pair< ThLeftNormalForm , int > > uss_checked2;
+  unordered_map< ThLeftNormalForm , pair< ThLeftNormalForm , int > > uss_new1;
+  unordered_map< ThLeftNormalForm , pair< ThLeftNormalForm , int > > uss_checked1;
+  unordered_map< ThLeftNormalForm , pair< ThLeftNormalForm , int > > uss_new2;
+  unordered_map< ThLeftNormalForm , pair< ThLeftNormalForm , int > > uss_checked2;
   
   ussAddTrajectory( tr1.first , tr1.second , uss_new1 , uss_checked1 , uss_new2 , uss_checked2 );
   pair< bool , ThLeftNormalForm > traj_add_result = 
@@ -769,30 +741,44 @@ pair< bool , ThLeftNormalForm > ThLeftNormalForm::areConjugate_uss( const ThLeft
   // uss_new1[tr1.first] = pair< ThLeftNormalForm , int >( tr1.second , tr1.third );
   // uss_new2[tr2.first] = pair< ThLeftNormalForm , int >( tr2.second , tr2.third );
 
-  for( int i=0 ; i<1000000 && uss_new1.size( ) && uss_new2.size( ) ; ++i ) {
-
-    // Check if we have time to proceed
-    int cur_time = time(0);
-    if( cur_time-init_time>time_sec_bound )
-      return pair< bool , ThLeftNormalForm >( false , ThLeftNormalForm( theRank ) );
-    
-    pair< bool , ThLeftNormalForm > pr = ussConstructionIteration( uss_new1 , uss_checked1 , uss_new2 , uss_checked2 );
-    if( pr.first ) {
-      // cout << "Size: " << uss_new1.size()+uss_checked1.size() << "  -  " << uss_new2.size()+uss_checked2.size() << endl;
-      return pair< bool , ThLeftNormalForm >( true , pr.second );
+  // a vertex is expanded by conjugating it by its simple ultra conjugators and adding the trajectories
+  // of the results (see ussAddTrajectory)
+  typedef pair< ThLeftNormalForm , pair< ThLeftNormalForm , int > > Vertex;
+  const auto expand = []( const Vertex& pr , const crag::braidgroup::summit::SummitSets< ThLeftNormalForm , pair< ThLeftNormalForm , int > >& sets , 
+			  vector< vector< Vertex > >& paths ) {
+    const set< pair< Permutation , bool > > conj = pr.first.getSimpleUltraConjugators( pr.second.second );
+    for( set< pair< Permutation , bool > >::const_iterator it=conj.begin( ) ; it!=conj.end( ) ; ++it ) {
+
+      // Conjugate the current element
+      const ThLeftNormalForm c( (*it).first );
+      const ThLeftNormalForm res = -c * pr.first * c;
+      if( sets.isChecked( res ) )
+        continue;
+
+      // Compute the trajectory of the new element
+      vector< Vertex > trajectory;
+      ThLeftNormalForm cur_res = res;
+      ThLeftNormalForm new_conjugator = pr.second.first * c;
+      bool met = false;
+      do {
+        trajectory.push_back( Vertex( cur_res , pair< ThLeftNormalForm , int >( new_conjugator , cur_res.computePeriod( ) ) ) );
+        met = sets.isInOther( cur_res );
+
+        pair< ThLeftNormalForm , ThLeftNormalForm > pr_res = cur_res.cycle( );
+        cur_res = pr_res.first;
+        new_conjugator *= pr_res.second;
+      } while( !met && cur_res!=res );
+      paths.push_back( trajectory );
+
+      if( met )
+        return true;
     }
+    return false;
+  };
 
-    // Check if we have time to proceed
-    cur_time = time(0);
-    if( cur_time-init_time>time_sec_bound )
-      return pair< bool , ThLeftNormalForm >( false , ThLeftNormalForm( theRank ) );
-
-    pr = ussConstructionIteration( uss_new2 , uss_checked2 , uss_new1 , uss_checked1 );
-    if( pr.first ) {
-      // cout << "Size: " << uss_new1.size()+uss_checked1.size() << "  -  " << uss_new2.size()+uss_checked2.size() << endl;
-      return pair< bool , ThLeftNormalForm >( true , pr.second.inverse( ) );
-    }
-  }
+  const auto meeting = crag::braidgroup::summit::findMeeting( uss_new1 , uss_checked1 , uss_new2 , uss_checked2 , 1000000 , deadline , expand );
+  if( meeting.status==crag::braidgroup::summit::Meeting< pair< ThLeftNormalForm , int > >::Status::Met )
+    return pair< bool , ThLeftNormalForm >( true , meeting.second.first * -meeting.first.first );
   
   return pair< bool , ThLeftNormalForm >( false , ThLeftNormalForm( theRank ) );
 }
@@ -808,11 +794,11 @@ ThLeftNormalForm ThLeftNormalForm::increaseRank( int N ) const
   if( N<=theRank )
     return *this;
   
-  list< Permutation > D1;
-  for( list< Permutation >::const_iterator d_it=theDecomposition.begin( ) ; d_it!=theDecomposition.end( ) ; ++d_it )
+  vector< Permutation > D1;
+  for( vector< Permutation >::const_iterator d_it=theDecomposition.begin( ) ; d_it!=theDecomposition.end( ) ; ++d_it )
     D1.push_back( (*d_it).increaseSize(N) );
   
-  list< Permutation > D2;
+  vector< Permutation > D2;
   for( int i=0 ; i<abs(theOmegaPower) ; ++i )
     D2.push_back( Permutation::getHalfTwistPermutation( theRank ).increaseSize(N) );
   
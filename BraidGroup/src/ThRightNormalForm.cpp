@@ -6,20 +6,22 @@
 // Revision History:
 //
 
+#include <algorithm>
 #include <cassert>
 #include <fstream>
 
 #include "braid_group.h"
+#include "garside_normal_form.h"
 #include "ShortBraidForm.h"
 #include "ThRightNormalForm.h"
 #include "ThLeftNormalForm.h"
 #include "Word.h"
 
 
-ostream& printOn( ostream& os , const list<Permutation>& lp  )
+ostream& printOn( ostream& os , const vector<Permutation>& lp  )
 {
   os << "(";
-  list<Permutation>::const_iterator lp_it = lp.begin( );
+  vector<Permutation>::const_iterator lp_it = lp.begin( );
   for( ; lp_it!=lp.end( ) ; ++lp_it ) {
     // os << (*lp_it) << " -> " << (*lp_it).geodesic( ).size( ) << endl;
     if( lp_it!=lp.begin( ) )
@@ -36,9 +38,9 @@ ostream& printOn( ostream& os , const list<Permutation>& lp  )
 
 ostream& operator << ( ostream& os, const ThRightNormalForm& rep )
 {
-  const list< Permutation >& decomposition = rep.getDecomposition( );
+  const vector< Permutation >& decomposition = rep.getDecomposition( );
   
-  list< Permutation >::const_iterator it = decomposition.begin( );
+  vector< Permutation >::const_iterator it = decomposition.begin( );
   for( ; it!=decomposition.end( ) ; ++it )
     os << *it << endl;
   
@@ -55,14 +57,16 @@ ostream& operator << ( ostream& os, const ThRightNormalForm& rep )
 
 ThRightNormalForm::operator ThLeftNormalForm( ) const
 {
+  applyFlip_( );
   if( theOmegaPower%2==0 ) {
     ThLeftNormalForm nf( theRank , theOmegaPower , theDecomposition );
     nf.adjust( );
     return nf;
   }
   
-  list< Permutation > D;
-  for( list< Permutation >::const_iterator d_it=theDecomposition.begin( ) ; d_it!=theDecomposition.end( ) ; ++d_it )
+  vector< Permutation > D;
+  D.reserve( theDecomposition.size( ) );
+  for( vector< Permutation >::const_iterator d_it=theDecomposition.begin( ) ; d_it!=theDecomposition.end( ) ; ++d_it )
     D.push_back( (*d_it).flip( ) );
   
   ThLeftNormalForm nf( theRank , theOmegaPower , D );
@@ -76,10 +80,11 @@ ThRightNormalForm::operator ThLeftNormalForm( ) const
 //---------------------------------------------------------------------------//
 
 ThRightNormalForm::ThRightNormalForm(const crag::braidgroup::BraidGroup &G, const Word &w)
-    : theRank(G.getRank()), theOmegaPower(0) {
+    : theRank(G.getRank()), theOmegaPower(0), theFlipped(false) {
   const Permutation omega = Permutation::getHalfTwistPermutation(theRank);
 
   // 1. compute permutation decomposition of a given braid word
+  //    (factors are collected from the right end, so the decomposition is built reversed)
   Permutation curMult(theRank);
   // bool trivialMult = true;
   for (Word::const_iterator w_it = w.end(); w_it != w.begin();) {
@@ -103,40 +108,40 @@ ThRightNormalForm::ThRightNormalForm(const crag::braidgroup::BraidGroup &G, cons
         int gen = *w_it3;
         // cout << " +++++ " << gen << endl;
         if (curMult[gen - 1] > curMult[gen]) {
-          theDecomposition.push_front(curMult);
+          theDecomposition.push_back(curMult);
           curMult = Permutation(theRank);
         }
         curMult.change(gen - 1, gen);
         // trivialMult = false;
       }
-      theDecomposition.push_front(curMult);
+      theDecomposition.push_back(curMult);
       curMult = Permutation(theRank);
       // trivialMult = true;
 
     } else {
 
       // process the negative block
-      list<Permutation> mult;
+      vector<Permutation> mult;
       for (Word::const_iterator w_it3 = w_it2; w_it3 != w_it; ++w_it3) {
 
         int gen = -*w_it3;
         // cout << " ------ " << gen << endl;
         if (curMult[gen - 1] > curMult[gen]) {
-          mult.push_front(curMult);
+          mult.push_back(curMult);
           curMult = Permutation(theRank);
         }
         curMult.change(gen - 1, gen);
         // trivialMult = false;
       }
-      mult.push_front(curMult);
+      mult.push_back(curMult);
       curMult = Permutation(theRank);
       // trivialMult = true;
 
-      list<Permutation>::iterator it = mult.begin();
-      for (; it != mult.end(); ++it) {
-        theDecomposition.push_front(omega);
+      vector<Permutation>::reverse_iterator it = mult.rbegin();
+      for (; it != mult.rend(); ++it) {
+        theDecomposition.push_back(omega);
         if (!((*it).inverse() * omega).isTrivial())
-          theDecomposition.push_front((*it).inverse() * omega);
+          theDecomposition.push_back((*it).inverse() * omega);
         theOmegaPower -= 2;
       }
     }
@@ -144,6 +149,7 @@ ThRightNormalForm::ThRightNormalForm(const crag::braidgroup::BraidGroup &G, cons
     w_it = w_it2;
   }
 
+  std::reverse(theDecomposition.begin(), theDecomposition.end());
   adjustDecomposition(theRank, theOmegaPower, theDecomposition);
 }
 
@@ -151,47 +157,8 @@ ThRightNormalForm::ThRightNormalForm(const crag::braidgroup::BraidGroup &G, cons
 //--------------------------- adjustDecomposition ---------------------------//
 //---------------------------------------------------------------------------//
 
-void ThRightNormalForm::adjustDecomposition(int rank, int &power, list<Permutation> &decomp) {
-
-  const Permutation omega = Permutation::getHalfTwistPermutation(rank);
-
-  bool flip = false;
-  list<Permutation>::iterator it1 = decomp.begin();
-  for (; it1 != decomp.end(); ) {
-
-    if (flip)
-      *it1 = omega * (*it1) * omega;
-
-    list<Permutation>::iterator it2 = it1;
-    for (; it2 != decomp.begin(); it2--) {
-      list<Permutation>::iterator it3 = it2;
-      it3--;
-
-      transformationResult tr_res = transform( rank , *it3 , *it2 );
-      switch( tr_res ) {
-      case ONE_MULTIPLIER:
-				if( it1==it2 )
-					it1 = it2 = decomp.erase( it3 );
-				else
-					it2 = decomp.erase( it3 );
-				it2++;
-				break;
-      case NO_CHANGE:
-				it2 = decomp.begin( );
-				it2++;
-				break;
-      }
-    }
-
-    if (*it1 == omega) {
-      power++;
-      it1 = decomp.erase(it1);
-      flip = !flip;
-    } else {
-      if (it1 != decomp.end())
-        it1++;
-    }
-  }
+void ThRightNormalForm::adjustDecomposition(int rank, int &power, vector<Permutation> &decomp) {
+  crag::braidgroup::garside::adjustDecomposition(rank, power, decomp);
 }
 
 
@@ -205,18 +172,14 @@ void ThRightNormalForm::adjustDecomposition(int rank, int &power, list<Permutati
 ThRightNormalForm::transformationResult
 ThRightNormalForm::transform( int theRank , Permutation& p1 , Permutation& p2 )
 {
-  transformationResult res = TWO_MULTIPLIERS;
-  const Permutation omega = Permutation::getHalfTwistPermutation( theRank );
-
-  Permutation p3 = p1.RightGCD( omega * -p2 );
-  if( p3==p1 )
-    res = ONE_MULTIPLIER;
-  if( p3.isTrivial( ) )
-    res = NO_CHANGE;
-  p2 = p3 * p2;
-  p1 *= -p3;
-
-  return res;
+  switch( crag::braidgroup::garside::transform( theRank , p1 , p2 ) ) {
+  case crag::braidgroup::garside::Transformation::OneFactor:
+    return ONE_MULTIPLIER;
+  case crag::braidgroup::garside::Transformation::NoChange:
+    return NO_CHANGE;
+  default:
+    return TWO_MULTIPLIERS;
+  }
 }
 
 
@@ -225,13 +188,15 @@ ThRightNormalForm::transform( int theRank , Permutation& p1 , Permutation& p2 )
 //---------------------------------------------------------------------------//
 
 ThRightNormalForm::NF ThRightNormalForm::inverse() const {
+  applyFlip_();
   int dec_size = theDecomposition.size();
 
   int power = -theOmegaPower - dec_size;
   const Permutation omega = Permutation::getHalfTwistPermutation(theRank);
-  list<Permutation> result;
+  vector<Permutation> result;
+  result.reserve(dec_size);
 
-  list<Permutation>::const_iterator it = theDecomposition.end();
+  vector<Permutation>::const_iterator it = theDecomposition.end();
   for (int i = 0; i < dec_size; ++i) {
     --it;
     if ((i % 2 == 0) == (theOmegaPower % 2 != 0))
@@ -251,16 +216,20 @@ ThRightNormalForm::NF ThRightNormalForm::inverse() const {
 ThRightNormalForm::NF
 ThRightNormalForm::multiply( const ThRightNormalForm& rep ) const
 {
+  applyFlip_( );
+  rep.applyFlip_( );
   const Permutation omega = Permutation::getHalfTwistPermutation( theRank );
   
   // 1. shift omegas to the right
   int power = theOmegaPower + rep.theOmegaPower;
   
-  list< Permutation > blocks( theDecomposition );
+  vector< Permutation > blocks;
+  blocks.reserve( theDecomposition.size( ) + rep.theDecomposition.size( ) );
+  blocks.insert( blocks.end( ) , theDecomposition.begin( ) , theDecomposition.end( ) );
   
   // 2. if power of the omega on the left is odd we must flip 
   //    permutations of the second form
-  list< Permutation >::const_iterator it = rep.theDecomposition.begin( );
+  vector< Permutation >::const_iterator it = rep.theDecomposition.begin( );
   if( theOmegaPower%2 ) {
     for( size_t t=0 ; t<rep.theDecomposition.size( ) ; ++t , ++it )
       blocks.push_back( omega * (*it) * omega );
@@ -269,11 +238,28 @@ ThRightNormalForm::multiply( const ThRightNormalForm& rep ) const
 		   rep.theDecomposition.begin( ) , 
 		   rep.theDecomposition.end( ) );
   
-  adjustDecomposition( theRank , power , blocks );
+  // 3. the factors of the first form are already right-weighted
+  crag::braidgroup::garside::adjustDecomposition( theRank , power , blocks , theDecomposition.size( ) );
   return NF( theRank , power , blocks );
 }
 
 
+//---------------------------------------------------------------------------//
+//---------------------------------- hash -----------------------------------//
+//---------------------------------------------------------------------------//
+
+
+size_t ThRightNormalForm::hash( ) const
+{
+  applyFlip_( );
+  size_t result = theRank;
+  result ^= size_t( theOmegaPower ) + 0x9e3779b9 + ( result<<6 ) + ( result>>2 );
+  for( vector< Permutation >::const_iterator it=theDecomposition.begin( ) ; it!=theDecomposition.end( ) ; ++it )
+    result ^= (*it).hash( ) + 0x9e3779b9 + ( result<<6 ) + ( result>>2 );
+  return result;
+}
+
+
 //---------------------------------------------------------------------------//
 //-------------------------------- getWord ----------------------------------//
 //---------------------------------------------------------------------------//
@@ -281,11 +267,12 @@ ThRightNormalForm::multiply( const ThRightNormalForm& rep ) const
 
 Word ThRightNormalForm::getWord( ) const
 {
+  applyFlip_( );
   Word result;
   vector< int > decomposition;
   
   vector< int > geodesic;
-  list<Permutation>::const_iterator it = theDecomposition.begin( );
+  vector<Permutation>::const_iterator it = theDecomposition.begin( );
   for( ; it!=theDecomposition.end( ) ; ++it ) {
     geodesic = (*it).geodesic( );
     for( size_t j=0 ; j<geodesic.size( ) ; ++j )
@@ -319,8 +306,8 @@ Word ThRightNormalForm::getShortWord( ) const
 
   if( power<0 ) {
 
-    const list< Permutation >& decomp = getDecomposition( );
-    list<Permutation>:: const_iterator it = decomp.begin( );
+    const vector< Permutation >& decomp = getDecomposition( );
+    vector<Permutation>:: const_iterator it = decomp.begin( );
     for( int j=0 ; it!=decomp.end( ) ; ++it, ++j ) {
       int n = j - decomp.size( ) - power;
       if( n<0 ) {
@@ -355,8 +342,6 @@ Word ThRightNormalForm::getShortWord( ) const
 set<ThRightNormalForm> 
 ThRightNormalForm::computeCentralizer( ) const
 {
-  const Permutation omega = Permutation::getHalfTwistPermutation( theRank );
-  
   set<ThRightNormalForm> result;
   
   map< ThRightNormalForm , ThRightNormalForm > new_states;
@@ -412,11 +397,10 @@ ThRightNormalForm::computeCentralizer( ) const
       
       for( set<Permutation>::const_iterator conj_it = conjugators.begin( ) ; conj_it!=conjugators.end( ) ; ++conj_it ) {
 				
-	ThRightNormalForm r_mult( theRank , 0 , list<Permutation>( 1 , *conj_it ) );
-	if( *conj_it==omega )
-	  r_mult = ThRightNormalForm( theRank , 1 , list<Permutation>( 0 ) );
-	ThRightNormalForm new_el = -r_mult * cur_el * r_mult;
-	ThRightNormalForm new_conj = cur_conj * r_mult;
+	ThRightNormalForm new_el = cur_el;
+	new_el.conjugate( *conj_it );
+	ThRightNormalForm new_conj = cur_conj;
+	new_conj.multiplyRight( *conj_it );
 
 /*
 				cout << "**********************************************" << endl;
@@ -501,7 +485,8 @@ ThRightNormalForm::computeCentralizer( ) const
 
 ThRightNormalForm ThRightNormalForm::randomPositive( int rank , int decomp_length )
 {
-  list< Permutation > D;
+  vector< Permutation > D;
+  D.reserve( decomp_length );
   for( int i=0 ; i<decomp_length ; ++i )
     D.push_back( Permutation::random( rank ) );
   ThRightNormalForm result( rank , 0 , D );
@@ -521,11 +506,12 @@ ThRightNormalForm ThRightNormalForm::increaseRank( int N ) const
   if( N<=theRank )
     return *this;
   
-  list< Permutation > D1;
-  for( list< Permutation >::const_iterator d_it=theDecomposition.begin( ) ; d_it!=theDecomposition.end( ) ; ++d_it )
+  applyFlip_( );
+  vector< Permutation > D1;
+  for( vector< Permutation >::const_iterator d_it=theDecomposition.begin( ) ; d_it!=theDecomposition.end( ) ; ++d_it )
     D1.push_back( (*d_it).increaseSize(N) );
   
-  list< Permutation > D2;
+  vector< Permutation > D2;
   for( int i=0 ; i<abs(theOmegaPower) ; ++i )
     D2.push_back( Permutation::getHalfTwistPermutation( theRank ).increaseSize(N) );
   
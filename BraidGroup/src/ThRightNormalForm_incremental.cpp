@@ -0,0 +1,144 @@
+// Contents: Incremental updates of right normal forms for class ThRightNormalForm
+//
+// Multiplication of a normal form by a simple element on either side changes
+// only the factors touched by a single sweep of transformations, so the cost is
+// proportional to the number of affected factors rather than to the length.
+// The functions work with the stored factors: if theFlipped is set they are the
+// flips of the actual ones, and the transformations commute with flips.
+//
+
+#include <cstdlib>
+
+#include "garside_normal_form.h"
+#include "ThRightNormalForm.h"
+
+
+//---------------------------------------------------------------------------//
+//------------------------------ multiplyRight ------------------------------//
+//---------------------------------------------------------------------------//
+
+
+void ThRightNormalForm::multiplyRight( const Permutation& s )
+{
+  if( s.isTrivial( ) )
+    return;
+
+  // \Delta^p s = \tau^p(s) \Delta^p, then the new factor is pushed to the left
+  theDecomposition.push_back( ( theOmegaPower%2!=0 )!=theFlipped ? s.flip( ) : s );
+  crag::braidgroup::garside::adjustDecomposition( theRank , theOmegaPower , theDecomposition , theDecomposition.size( )-1 );
+}
+
+
+void ThRightNormalForm::multiplyRightByInverse_( const Permutation& s )
+{
+  // s^{-1} = (s^{-1} \Delta) \Delta^{-1}
+  multiplyRight( -s * Permutation::getHalfTwistPermutation( theRank ) );
+  --theOmegaPower;
+}
+
+
+//---------------------------------------------------------------------------//
+//------------------------------- multiplyLeft ------------------------------//
+//---------------------------------------------------------------------------//
+
+
+void ThRightNormalForm::multiplyLeft( const Permutation& s )
+{
+  if( s.isTrivial( ) )
+    return;
+
+  const Permutation omega = Permutation::getHalfTwistPermutation( theRank );
+
+  // the new factor is pushed to the right while it changes the next one
+  theDecomposition.insert( theDecomposition.begin( ) , theFlipped ? s.flip( ) : s );
+  for( size_t j=0 ; j+1<theDecomposition.size( ) ; ) {
+    const transformationResult result = transform( theRank , theDecomposition[j] , theDecomposition[j+1] );
+    if( result==NO_CHANGE )
+      break;
+
+    if( result==ONE_MULTIPLIER )
+      // the left factor became trivial
+      theDecomposition.erase( theDecomposition.begin( )+j );
+    else
+      ++j;
+
+    // \Delta is moved to the end at once: the factors it passes are flipped, which is the same
+    // as flipping the factors it has already swept and toggling the flag for the whole sequence,
+    // then the flipped factors are normalized by the usual left sweeps
+    if( j<theDecomposition.size( ) && theDecomposition[j]==omega ) {
+      theDecomposition.erase( theDecomposition.begin( )+j );
+      for( size_t t=0 ; t<j ; ++t )
+        theDecomposition[t] = theDecomposition[t].flip( );
+      theFlipped = !theFlipped;
+      ++theOmegaPower;
+      crag::braidgroup::garside::adjustDecomposition( theRank , theOmegaPower , theDecomposition , j );
+      return;
+    }
+  }
+
+  // half twists can appear only at the end of a right-weighted sequence
+  while( !theDecomposition.empty( ) && theDecomposition.back( )==omega ) {
+    theDecomposition.pop_back( );
+    ++theOmegaPower;
+  }
+}
+
+
+void ThRightNormalForm::multiplyLeftByInverse_( const Permutation& s )
+{
+  const Permutation omega = Permutation::getHalfTwistPermutation( theRank );
+
+  // s^{-1} = \Delta^{-1} (\Delta s^{-1}), and \Delta^{-1} is moved to the right by flipping all factors
+  theFlipped = !theFlipped;
+  --theOmegaPower;
+
+  multiplyLeft( ( omega * -s ).flip( ) );
+}
+
+
+//---------------------------------------------------------------------------//
+//---------------------------- push_back/push_front -------------------------//
+//---------------------------------------------------------------------------//
+
+
+void ThRightNormalForm::push_back( int gen )
+{
+  Permutation s( theRank );
+  s.change( abs(gen)-1 , abs(gen) );
+
+  if( gen>0 )
+    multiplyRight( s );
+  else
+    multiplyRightByInverse_( s );
+}
+
+
+void ThRightNormalForm::push_front( int gen )
+{
+  Permutation s( theRank );
+  s.change( abs(gen)-1 , abs(gen) );
+
+  if( gen>0 )
+    multiplyLeft( s );
+  else
+    multiplyLeftByInverse_( s );
+}
+
+
+//---------------------------------------------------------------------------//
+//--------------------------------- conjugate -------------------------------//
+//---------------------------------------------------------------------------//
+
+
+void ThRightNormalForm::conjugate( const Permutation& s )
+{
+  multiplyLeftByInverse_( s );
+  multiplyRight( s );
+}
+
+
+void ThRightNormalForm::conjugate( int gen )
+{
+  push_front( -gen );
+  push_back( gen );
+}
@@ -7,11 +7,14 @@
 //
 
 #include "fstream"
+#include <algorithm>
+#include "garside_normal_form.h"
 #include "ShortBraidForm.h"
 
 
 #include "ThRightNormalForm.h"
 #include "braid_group.h"
+#include "summit_set_search.h"
 #include "Word.h"
 
 
@@ -22,6 +25,7 @@
 
 pair< ThRightNormalForm , ThRightNormalForm > ThRightNormalForm::cycle( ) const
 {
+  applyFlip_( );
   if( theDecomposition.empty( ) )
     return pair< ThRightNormalForm , ThRightNormalForm > ( *this ,   ThRightNormalForm( theRank ) );
   
@@ -29,8 +33,8 @@ pair< ThRightNormalForm , ThRightNormalForm > ThRightNormalForm::cycle( ) const
   Permutation conj = *(--theDecomposition.end( ));
   if( theOmegaPower%2!=0 )
     conj = conj.flip( );
-  result.theDecomposition.push_front( conj );
-  result.theDecomposition.pop_back( );
+  rotate( result.theDecomposition.begin( ) , --result.theDecomposition.end( ) , result.theDecomposition.end( ) );
+  result.theDecomposition.front( ) = conj;
   result.adjust( );
   
   return pair<NF,ThRightNormalForm> ( result , -ThRightNormalForm( conj ) );
@@ -44,17 +48,19 @@ pair< ThRightNormalForm , ThRightNormalForm > ThRightNormalForm::cycle( ) const
 
 pair< ThRightNormalForm , ThRightNormalForm > ThRightNormalForm::decycle( ) const
 {
+  applyFlip_( );
   if( theDecomposition.empty( ) )
     return pair< ThRightNormalForm , ThRightNormalForm >( *this , ThRightNormalForm( theRank ) );
   
   ThRightNormalForm result = *this;
   Permutation conj = *theDecomposition.begin( );
+  rotate( result.theDecomposition.begin( ) , ++result.theDecomposition.begin( ) , result.theDecomposition.end( ) );
   if( theOmegaPower%2!=0 )
-    result.theDecomposition.push_back( conj.flip( ) );
+    result.theDecomposition.back( ) = conj.flip( );
   else
-    result.theDecomposition.push_back( conj );
-  result.theDecomposition.pop_front( );
-  result.adjust( );
+    result.theDecomposition.back( ) = conj;
+  // all factors but the last one are still right-weighted
+  crag::braidgroup::garside::adjustDecomposition( theRank , result.theOmegaPower , result.theDecomposition , theDecomposition.size( )-1 );
 
   return pair< ThRightNormalForm , ThRightNormalForm > ( result , conj );
 }
@@ -124,13 +130,14 @@ pair< ThRightNormalForm , ThRightNormalForm > ThRightNormalForm::findSSSRepresen
 
 Permutation ThRightNormalForm::getSimpleConjugator( const Permutation& start ) const
 {
+  applyFlip_( );
   const Permutation omega = Permutation::getHalfTwistPermutation( theRank );
   
   Permutation  c = start;
   Permutation ic = theOmegaPower%2 ? omega * c * omega : c;
     
   Permutation v = c;
-  list< Permutation >::const_iterator it = theDecomposition.begin( );
+  vector< Permutation >::const_iterator it = theDecomposition.begin( );
   while( 1 ) {
       
     // move through permutations to the right
@@ -165,8 +172,8 @@ Permutation ThRightNormalForm::getSimpleSummitConjugator( const Permutation& sta
       return c;
     
     // Conjugate *this by the current permutation
-    ThRightNormalForm conj( c );
-    ThRightNormalForm R = -conj * *this * conj;
+    ThRightNormalForm R = *this;
+    R.conjugate( c );
 
 
     // If the current conjugator does not change the cannonical length then stop
@@ -177,11 +184,11 @@ Permutation ThRightNormalForm::getSimpleSummitConjugator( const Permutation& sta
     // If the cannonical length increased then we cycle R
     if( R.theDecomposition.size( )+R.theOmegaPower > 
 	theDecomposition.size( )+theOmegaPower ) {
-      c = c * (*R.theDecomposition.begin( ));
+      c = c * R.factor_( 0 );
       continue;
     }
     
-    Permutation v = *--R.theDecomposition.end( );
+    Permutation v = R.factor_( R.theDecomposition.size( )-1 );
     if( 1-theOmegaPower%2 )
       v = v.flip( );
     v = v.inverse( ) * omega;
@@ -227,56 +234,6 @@ set< Permutation > ThRightNormalForm::getSimpleSummitConjugators( ) const
 }
 
 
-//---------------------------------------------------------------------------//
-//------------------------- sssConstructionIteration ------------------------//
-//---------------------------------------------------------------------------//
-
-
-pair< bool , ThRightNormalForm > 
-ThRightNormalForm::sssConstructionIteration( map< ThRightNormalForm , ThRightNormalForm >& sss_new1 , 
-					     map< ThRightNormalForm , ThRightNormalForm >& sss_checked1 , 
-					     const map< ThRightNormalForm , ThRightNormalForm >& sss_new2 , 
-					     const map< ThRightNormalForm , ThRightNormalForm >& sss_checked2 ) const
-{
-  const Permutation omega = Permutation::getHalfTwistPermutation( theRank );
-
-  const pair< ThRightNormalForm , ThRightNormalForm > pr = *sss_new1.begin( );
-  sss_checked1[pr.first] = pr.second;
-  sss_new1.erase( sss_new1.begin( ) );
-
-  // 1. compute the set of simple summit conjugators 
-  set< Permutation > conj = pr.first.getSimpleSummitConjugators( );
-  for( set< Permutation >::iterator it=conj.begin( ) ; it!=conj.end( ) ; ++it ) {
-    
-    // Conjugate the current element
-    ThRightNormalForm conj( *it );
-    ThRightNormalForm res = -conj * pr.first * conj;
-    
-    // Check if the element is new
-    if( sss_new1.find( res )!=sss_new1.end( ) ||
-      sss_checked1.find( res )!=sss_checked1.end( ) )
-      continue;
-    
-    // Compute new conjugator
-    ThRightNormalForm new_conjugator = pr.second * conj;
-    
-    // a. Check if the new element belongs to the other SSS. Stop if true.
-    map< ThRightNormalForm , ThRightNormalForm >::const_iterator sss_it = sss_new2.find( res );
-    if( sss_it!=sss_new2.end( ) )
-      return pair< bool , ThRightNormalForm >( true , (*sss_it).second * -new_conjugator );
-    
-    // b. Check if the new element belongs to the other SSS. Stop if true.
-    sss_it = sss_checked2.find( res );
-    if( sss_it!=sss_checked2.end( ) )
-      return pair< bool , ThRightNormalForm >( true , (*sss_it).second * -new_conjugator );
-    
-    sss_new1[res] = new_conjugator;
-  }
-  
-  return pair<bool,ThRightNormalForm>( false , ThRightNormalForm( theRank ) );
-}
-
-
 //---------------------------------------------------------------------------//
 //------------------------------ areConjugate -------------------------------//
 //---------------------------------------------------------------------------//
@@ -313,26 +270,42 @@ pair< bool , ThRightNormalForm > ThRightNormalForm::areConjugate( const ThRightN
   
   
   // 3. construct super summit sets
-  map< ThRightNormalForm , ThRightNormalForm > sss_new1;
-  map< ThRightNormalForm , ThRightNormalForm > sss_checked1;
-  map< ThRightNormalForm , ThRightNormalForm > sss_new2;
-  map< ThRightNormalForm , ThRightNormalForm > sss_checked2;
+  unordered_map< ThRightNormalForm , ThRightNormalForm > sss_new1;
+  unordered_map< ThRightNormalForm , ThRightNormalForm > sss_checked1;
+  unordered_map< ThRightNormalForm , ThRightNormalForm > sss_new2;
+  unordered_map< ThRightNormalForm , ThRightNormalForm > sss_checked2;
   
   sss_new1[pr1.first] = pr1.second;
   sss_new2[pr2.first] = pr2.second;
   
   
-  for( int i=0 ; i<1000000 && sss_new1.size( ) && sss_new2.size( ) ; ++i ) {
-    
-    pair< bool , ThRightNormalForm > pr = sssConstructionIteration( sss_new1 , sss_checked1 , sss_new2 , sss_checked2 );
-    if( pr.first )
-      return pair< bool , ThRightNormalForm >( true , pr.second );
+  // a vertex is expanded by conjugating it by its simple summit conjugators
+  typedef pair< ThRightNormalForm , ThRightNormalForm > Vertex;
+  const auto expand = []( const Vertex& pr , const crag::braidgroup::summit::SummitSets< ThRightNormalForm , ThRightNormalForm >& sets , vector< vector< Vertex > >& paths ) {
+    const set< Permutation > conj = pr.first.getSimpleSummitConjugators( );
+    for( set< Permutation >::const_iterator it=conj.begin( ) ; it!=conj.end( ) ; ++it ) {
+
+      // Conjugate the current element
+      ThRightNormalForm res = pr.first;
+      res.conjugate( *it );
+      if( sets.isChecked( res ) )
+        continue;
+
+      // Compute new conjugator
+      ThRightNormalForm new_conjugator = pr.second;
+      new_conjugator.multiplyRight( *it );
+
+      paths.push_back( vector< Vertex >( 1 , Vertex( res , new_conjugator ) ) );
+      if( sets.isInOther( res ) )
+        return true;
+    }
+    return false;
+  };
 
-    
-    pr = sssConstructionIteration( sss_new2 , sss_checked2 , sss_new1 , sss_checked1 );
-    if( pr.first )
-      return pair< bool , ThRightNormalForm >( true , pr.second.inverse( ) );
-  }
+  const auto meeting = crag::braidgroup::summit::findMeeting( sss_new1 , sss_checked1 , sss_new2 , sss_checked2 , 1000000 , 
+							     crag::braidgroup::summit::Clock::time_point::max( ) , expand );
+  if( meeting.status==crag::braidgroup::summit::Meeting< ThRightNormalForm >::Status::Met )
+    return pair< bool , ThRightNormalForm >( true , meeting.second * -meeting.first );
   
   return pair<bool,ThRightNormalForm>( false , ThRightNormalForm( theRank ) );
 }
@@ -19,6 +19,9 @@
 
 Permutation ThRightNormalForm::getTransport( const ThRightNormalForm& B , const Permutation& u ) const
 {
+  applyFlip_( );
+  B.applyFlip_( );
+
   // we assume that the braid is not a power of \Delta
   Permutation A1 = *(--  theDecomposition.end( ));
   Permutation B1 = *(--B.theDecomposition.end( ));
@@ -58,7 +61,7 @@ set< Permutation > ThRightNormalForm::getTransports( const Permutation& u , int
 
   // trajectory contains elements obtained by consequent cycling of the current element
   // first=trajectory element, second.first=transport, second.second=loop number
-  map< ThRightNormalForm , pair< Permutation , int > > trajectory;
+  unordered_map< ThRightNormalForm , pair< Permutation , int > > trajectory;
   trajectory[B] = pair< Permutation , int >( cur_perm , 0 );
   for( int i=1 ; 1 ; ++i ) {
     
@@ -70,7 +73,7 @@ set< Permutation > ThRightNormalForm::getTransports( const Permutation& u , int
     }
     
     // check if got into a loop
-    map< ThRightNormalForm , pair< Permutation , int > >::iterator t_it = trajectory.find( B );
+    unordered_map< ThRightNormalForm , pair< Permutation , int > >::iterator t_it = trajectory.find( B );
     if( t_it!=trajectory.end( ) ) {
       
       int loop_start = (*t_it).second.second;
@@ -100,6 +103,8 @@ Permutation ThRightNormalForm::getPullback( const Permutation& s ) const
 {
   const Permutation omega = Permutation::getHalfTwistPermutation( theRank );
 
+  applyFlip_( );
+
   // we assume that the braid is not a power of \Delta
   Permutation A1 = *(--theDecomposition.end( ));
   if( getPower()%2!=0 )
@@ -109,7 +114,7 @@ Permutation ThRightNormalForm::getPullback( const Permutation& s ) const
   Permutation s1 = -A1 * A1.LeftLCM( s );
 
   Permutation p = s;
-  for( list< Permutation >::const_iterator d_it=--theDecomposition.end( ) ; d_it!=theDecomposition.begin( ) ; ) {
+  for( vector< Permutation >::const_iterator d_it=--theDecomposition.end( ) ; d_it!=theDecomposition.begin( ) ; ) {
     Permutation A = *--d_it;
     transform( theRank , A , p );
     p = A;
@@ -256,14 +261,14 @@ triple< ThRightNormalForm , ThRightNormalForm , int > ThRightNormalForm::findUSS
   result = sss.first;
   
   // Cycle until get into a loop
-  map< ThRightNormalForm , pair< ThRightNormalForm , int > > trajectory;
+  unordered_map< ThRightNormalForm , pair< ThRightNormalForm , int > > trajectory;
   trajectory[result] = pair<ThRightNormalForm,int>(conjugator,0);
   for( int c=0 ; 1 ; ++c ) {
     
     pair< ThRightNormalForm , ThRightNormalForm > pr = result.cycle( );
     result = pr.first;
     conjugator *= pr.second;
-    map< ThRightNormalForm , pair< ThRightNormalForm , int > >::iterator t_it = trajectory.find( result );
+    unordered_map< ThRightNormalForm , pair< ThRightNormalForm , int > >::iterator t_it = trajectory.find( result );
     if( t_it==trajectory.end( ) )
       trajectory[result] = pair<ThRightNormalForm,int>(conjugator,c+1);
     else
@@ -0,0 +1,384 @@
+#include "bkl_simple_element.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace crag {
+namespace braidgroup {
+
+namespace {
+
+//! Root of the set of i in a disjoint-set forest, compresses the path.
+size_t findRoot(std::vector<size_t>& parent, size_t i) {
+  auto root = i;
+
+  while (parent[root] != root) {
+    root = parent[root];
+  }
+
+  while (parent[i] != root) {
+    const auto next = parent[i];
+    parent[i] = root;
+    i = next;
+  }
+
+  return root;
+}
+
+std::vector<int> inverseValues(const std::vector<int>& values) {
+  std::vector<int> result(values.size());
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    result[values[i]] = i;
+  }
+
+  return result;
+}
+} // namespace
+
+BKLSimpleElement::BKLSimpleElement(size_t rank) {
+  if (rank > kMaxRank) {
+    throw std::invalid_argument("Rank is too big for BKLSimpleElement.");
+  }
+
+  min_.resize(rank);
+
+  for (size_t i = 0; i < rank; ++i) {
+    min_[i] = i;
+  }
+}
+
+BKLSimpleElement::BKLSimpleElement(const Permutation& p)
+  : BKLSimpleElement(fromValues_(p.getVector(), true)) {}
+
+BKLSimpleElement BKLSimpleElement::band(size_t rank, size_t s, size_t t) {
+  if (s == t || s >= rank || t >= rank) {
+    throw std::invalid_argument("Bad band generator.");
+  }
+
+  BKLSimpleElement result(rank);
+  result.min_[std::max(s, t)] = std::min(s, t);
+
+  return result;
+}
+
+BKLSimpleElement BKLSimpleElement::getTinyTwist(size_t rank) {
+  BKLSimpleElement result(rank);
+  std::fill(result.min_.begin(), result.min_.end(), 0);
+
+  return result;
+}
+
+bool BKLSimpleElement::isTrivial() const {
+  for (size_t i = 0; i < size(); ++i) {
+    if (min_[i] != i) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool BKLSimpleElement::isTinyTwist() const {
+  return std::all_of(min_.begin(), min_.end(), [](std::uint16_t m) { return m == 0; });
+}
+
+size_t BKLSimpleElement::length() const {
+  size_t blocks = 0;
+
+  for (size_t i = 0; i < size(); ++i) {
+    if (min_[i] == i) {
+      ++blocks;
+    }
+  }
+
+  return size() - blocks;
+}
+
+std::vector<int> BKLSimpleElement::values_() const {
+  const auto n = size();
+  std::vector<int> result(n);
+
+  // the last point of each block seen so far, every point goes to the previous point of its block
+  std::vector<int> last(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    const auto b = min_[i];
+    result[i] = b == i ? i : last[b];
+    last[b] = i;
+  }
+
+  // the minimal point goes to the maximal one
+  for (size_t i = 0; i < n; ++i) {
+    if (min_[i] == i) {
+      result[i] = last[i];
+    }
+  }
+
+  return result;
+}
+
+Permutation BKLSimpleElement::toPermutation() const {
+  return Permutation(values_());
+}
+
+BKLSimpleElement BKLSimpleElement::fromValues_(const std::vector<int>& values, bool check) {
+  const auto n = values.size();
+  BKLSimpleElement result(n);
+
+  std::vector<bool> visited(n, false);
+
+  for (size_t i = 0; i < n; ++i) {
+    if (visited[i]) {
+      continue;
+    }
+
+    // cycles are enumerated by their minimal points
+    for (auto j = i; !visited[j]; j = values[j]) {
+      visited[j] = true;
+      result.min_[j] = i;
+    }
+  }
+
+  if (check) {
+    if (result.values_() != values) {
+      throw std::invalid_argument("Permutation is not a product of descending cycles.");
+    }
+
+    // a block may be nested into another one, but not interleaved with it
+    std::vector<size_t> last(n);
+
+    for (size_t i = 0; i < n; ++i) {
+      last[result.min_[i]] = i;
+    }
+
+    std::vector<size_t> open;
+
+    for (size_t i = 0; i < n; ++i) {
+      const auto b = result.min_[i];
+
+      if (b == i) {
+        open.push_back(b);
+        continue;
+      }
+
+      while (open.back() != b) {
+        if (last[open.back()] > i) {
+          throw std::invalid_argument("Descending cycles are not parallel.");
+        }
+
+        open.pop_back();
+      }
+    }
+  }
+
+  return result;
+}
+
+bool BKLSimpleElement::operator<(const BKLSimpleElement& s) const {
+  if (size() != s.size()) {
+    return size() < s.size();
+  }
+
+  return min_ < s.min_;
+}
+
+BKLSimpleElement BKLSimpleElement::operator*(const BKLSimpleElement& s) const {
+  const auto v1 = values_();
+  const auto v2 = s.values_();
+
+  std::vector<int> result(size());
+
+  for (size_t i = 0; i < size(); ++i) {
+    result[i] = v2[v1[i]];
+  }
+
+  return fromValues_(result, true);
+}
+
+BKLSimpleElement BKLSimpleElement::leftQuotient(const BKLSimpleElement& d) const {
+  const auto v = values_();
+  const auto dinv = inverseValues(d.values_());
+
+  std::vector<int> result(size());
+
+  for (size_t i = 0; i < size(); ++i) {
+    result[i] = v[dinv[i]];
+  }
+
+  return fromValues_(result, true);
+}
+
+BKLSimpleElement BKLSimpleElement::rightComplement() const {
+  const auto n = size();
+  const auto inv = inverseValues(values_());
+
+  std::vector<int> result(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    result[i] = (inv[i] + n - 1) % n;
+  }
+
+  return fromValues_(result, false);
+}
+
+BKLSimpleElement BKLSimpleElement::leftComplement() const {
+  const auto n = size();
+  const auto inv = inverseValues(values_());
+
+  std::vector<int> result(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    result[i] = inv[(i + n - 1) % n];
+  }
+
+  return fromValues_(result, false);
+}
+
+BKLSimpleElement BKLSimpleElement::tinyFlip(int sh) const {
+  const int n = size();
+
+  if (n == 0) {
+    return *this;
+  }
+
+  sh %= n;
+
+  if (sh < 0) {
+    sh += n;
+  }
+
+  const auto v = values_();
+  std::vector<int> result(n);
+
+  for (int t = 0; t < n; ++t) {
+    result[(t + sh) % n] = (v[t] + sh) % n;
+  }
+
+  return fromValues_(result, false);
+}
+
+BKLSimpleElement BKLSimpleElement::meet(const BKLSimpleElement& s) const {
+  const auto n = size();
+
+  if (n != s.size()) {
+    throw std::invalid_argument("Ranks of simple elements do not match.");
+  }
+
+  // sort the points by the blocks of *this (stable, the points of each block are in the ascending order)
+  std::vector<size_t> start(n + 1, 0);
+
+  for (size_t i = 0; i < n; ++i) {
+    ++start[min_[i] + 1];
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    start[i + 1] += start[i];
+  }
+
+  std::vector<size_t> points(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    points[start[min_[i]]++] = i;
+  }
+
+  // within a block of *this the first point of each block of s starts a new block of the result
+  BKLSimpleElement result(n);
+  std::vector<size_t> stamp(n, n);
+  std::vector<std::uint16_t> first(n);
+
+  for (const auto i : points) {
+    const auto b1 = min_[i];
+    const auto b2 = s.min_[i];
+
+    if (stamp[b2] != b1) {
+      stamp[b2] = b1;
+      first[b2] = i;
+    }
+
+    result.min_[i] = first[b2];
+  }
+
+  return result;
+}
+
+BKLSimpleElement BKLSimpleElement::join(const BKLSimpleElement& s) const {
+  const auto n = size();
+
+  if (n != s.size()) {
+    throw std::invalid_argument("Ranks of simple elements do not match.");
+  }
+
+  // 1. the join of the set partitions
+  std::vector<size_t> parent(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    parent[i] = i;
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    for (const size_t b : {min_[i], s.min_[i]}) {
+      const auto r1 = findRoot(parent, i);
+      const auto r2 = findRoot(parent, b);
+      parent[std::max(r1, r2)] = std::min(r1, r2);
+    }
+  }
+
+  std::vector<size_t> last(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    last[findRoot(parent, i)] = i;
+  }
+
+  // 2. merge crossing blocks: a block which is open above the block of the current point crosses it
+  std::vector<size_t> open;
+  std::vector<bool> seen(n, false);
+
+  for (size_t i = 0; i < n; ++i) {
+    const auto r = findRoot(parent, i);
+
+    if (!seen[r]) {
+      seen[r] = true;
+      open.push_back(r);
+    } else {
+      while (open.back() != r) {
+        const auto t = open.back();
+        open.pop_back();
+
+        parent[t] = r;
+        last[r] = std::max(last[r], last[t]);
+      }
+    }
+
+    if (last[r] == i) {
+      open.pop_back();
+    }
+  }
+
+  // 3. roots are the minimal points of the blocks
+  BKLSimpleElement result(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    result.min_[i] = findRoot(parent, i);
+  }
+
+  return result;
+}
+
+size_t BKLSimpleElement::hash() const {
+  std::uint64_t result = min_.size();
+
+  for (const auto m : min_) {
+    result = (result ^ static_cast<std::uint64_t>(m)) * 0x9E3779B97F4A7C15ull;
+    result ^= result >> 29;
+  }
+
+  return static_cast<size_t>(result);
+}
+
+std::ostream& operator<<(std::ostream& os, const BKLSimpleElement& s) {
+  return os << s.toPermutation();
+}
+
+} // namespace braidgroup
+} // namespace crag
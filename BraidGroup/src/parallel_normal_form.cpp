@@ -0,0 +1,64 @@
+#include "parallel_normal_form.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "parallel.h"
+
+namespace crag {
+namespace braidgroup {
+
+namespace {
+
+//! Returns the normal form of the product of forms[i] in the order of i.
+template <typename NormalForm>
+NormalForm multiplyBalanced(std::vector<NormalForm> forms) {
+  while (forms.size() > 1) {
+    // odd forms are multiplied by the next ones, the last one is carried over if there is no pair for it
+    forms = parallel::map<NormalForm>((forms.size() + 1) / 2, [&forms](size_t i) {
+      return 2 * i + 1 < forms.size() ? forms[2 * i] * forms[2 * i + 1] : forms[2 * i];
+    });
+  }
+
+  return forms.front();
+}
+
+template <typename NormalForm>
+NormalForm parallelNormalForm(const BraidGroup& G, const Word& w, size_t chunks) {
+  if (chunks == 0) {
+    throw std::invalid_argument("The number of chunks must be positive.");
+  }
+
+  const auto letters = w.toVector();
+  chunks = std::max<size_t>(1, std::min(chunks, letters.size()));
+
+  auto forms = parallel::map<NormalForm>(chunks, [&](size_t i) {
+    const auto begin = letters.begin() + letters.size() * i / chunks;
+    const auto end = letters.begin() + letters.size() * (i + 1) / chunks;
+
+    return NormalForm(G, Word(begin, end));
+  });
+
+  return multiplyBalanced(std::move(forms));
+}
+
+} // namespace
+
+ThRightNormalForm parallelRightNormalForm(const BraidGroup& G, const Word& w) {
+  return parallelRightNormalForm(G, w, parallel::getHardwareConcurrency());
+}
+
+ThRightNormalForm parallelRightNormalForm(const BraidGroup& G, const Word& w, size_t chunks) {
+  return parallelNormalForm<ThRightNormalForm>(G, w, chunks);
+}
+
+ThLeftNormalForm parallelLeftNormalForm(const BraidGroup& G, const Word& w) {
+  return parallelLeftNormalForm(G, w, parallel::getHardwareConcurrency());
+}
+
+ThLeftNormalForm parallelLeftNormalForm(const BraidGroup& G, const Word& w, size_t chunks) {
+  return parallelNormalForm<ThLeftNormalForm>(G, w, chunks);
+}
+
+} // namespace braidgroup
+} // namespace crag
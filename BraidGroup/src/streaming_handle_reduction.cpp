@@ -0,0 +1,94 @@
+#include "streaming_handle_reduction.h"
+
+#include <stdexcept>
+
+#include "ShortBraidForm.h"
+
+namespace crag {
+namespace braidgroup {
+
+StreamingHandleReduction::StreamingHandleReduction(int n, size_t window, Sink sink, Mode mode)
+  : n_(n), window_(window), sink_(std::move(sink)), mode_(mode) {
+  if (n < 2) {
+    throw std::invalid_argument("Braid group must have rank at least 2.");
+  }
+
+  if (window < 2) {
+    throw std::invalid_argument("Window must contain at least 2 letters.");
+  }
+
+  buffer_.reserve(window);
+}
+
+void StreamingHandleReduction::push_back(int g) {
+  buffer_.push_back(g);
+  ++consumed_;
+
+  if (buffer_.size() >= window_) {
+    reduce_(window_ / 2);
+  }
+}
+
+void StreamingHandleReduction::push_back(const Word& w) {
+  for (const auto g : w) {
+    push_back(g);
+  }
+}
+
+void StreamingHandleReduction::finish() {
+  reduce_(0);
+}
+
+void StreamingHandleReduction::reduce_(size_t keep) {
+  const Word w(buffer_.begin(), buffer_.end());
+  const auto reduced = (mode_ == Mode::DEHORNOY ? dehornoy(n_, w) : shortenBraid(n_, w)).toVector();
+
+  buffer_.clear();
+
+  if (reduced.size() <= keep) {
+    buffer_.insert(buffer_.end(), reduced.begin(), reduced.end());
+    return;
+  }
+
+  const auto stable_end = reduced.end() - keep;
+
+  sink_(Word(reduced.begin(), stable_end));
+  emitted_ += stable_end - reduced.begin();
+
+  buffer_.insert(buffer_.end(), stable_end, reduced.end());
+}
+
+namespace {
+
+Word streamingReduce(int n, const Word& w, size_t window, StreamingHandleReduction::Mode mode) {
+  std::vector<int> result;
+  result.reserve(w.length());
+
+  StreamingHandleReduction reduction(
+      n, window, [&result](const Word& piece) { result.insert(result.end(), piece.begin(), piece.end()); }, mode);
+
+  reduction.push_back(w);
+  reduction.finish();
+
+  return Word(std::move(result));
+}
+} // namespace
+
+Word streamingDehornoy(int n, const Word& w, size_t window) {
+  return streamingReduce(n, w, window, StreamingHandleReduction::Mode::DEHORNOY);
+}
+
+Word streamingShortenBraid(int n, const Word& w, size_t window) {
+  return streamingReduce(n, w, window, StreamingHandleReduction::Mode::SHORTEN);
+}
+
+StreamingReductionReport
+compareStreamingReduction(int n, const Word& w, size_t window, StreamingHandleReduction::Mode mode) {
+  const auto streaming = streamingReduce(n, w, window, mode);
+  const auto full = mode == StreamingHandleReduction::Mode::DEHORNOY ? dehornoy(n, w) : shortenBraid(n, w);
+
+  return StreamingReductionReport{w.length(), streaming.length(), full.length()};
+}
+
+} // namespace braidgroup
+} // namespace crag
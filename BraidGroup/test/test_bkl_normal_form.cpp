@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include "BKLLeftNormalForm.h"
+
+#include <random>
+#include <set>
+#include <vector>
+
+#include "Word.h"
+#include "braid_group.h"
+#include "random_word.h"
+
+namespace crag {
+namespace braidgroup {
+namespace {
+
+//! All simple elements of the given rank (products of bands which stay simple).
+std::vector<BKLSimpleElement> allSimpleElements(size_t rank) {
+  std::set<BKLSimpleElement> result = {BKLSimpleElement(rank)};
+  std::vector<BKLSimpleElement> frontier = {BKLSimpleElement(rank)};
+
+  while (!frontier.empty()) {
+    std::vector<BKLSimpleElement> next;
+
+    for (const auto& s : frontier) {
+      for (size_t t = 1; t < rank; ++t) {
+        for (size_t r = 0; r < t; ++r) {
+          try {
+            const auto p = s * BKLSimpleElement::band(rank, r, t);
+
+            if (result.insert(p).second) {
+              next.push_back(p);
+            }
+          } catch (const std::invalid_argument&) {
+          }
+        }
+      }
+    }
+
+    frontier = std::move(next);
+  }
+
+  return std::vector<BKLSimpleElement>(result.begin(), result.end());
+}
+
+TEST(BKLSimpleElement, Catalan) {
+  EXPECT_EQ(14, allSimpleElements(4).size());
+  EXPECT_EQ(132, allSimpleElements(6).size());
+}
+
+TEST(BKLSimpleElement, Arithmetic) {
+  const size_t n = 6;
+  const auto delta = BKLSimpleElement::getTinyTwist(n);
+
+  for (const auto& s : allSimpleElements(n)) {
+    EXPECT_EQ(s, BKLSimpleElement(s.toPermutation()));
+    EXPECT_EQ(delta, s * s.rightComplement());
+    EXPECT_EQ(delta, s.leftComplement() * s);
+    EXPECT_EQ(s.rightComplement(), delta.leftQuotient(s));
+    EXPECT_EQ(n - 1, s.length() + s.rightComplement().length());
+    EXPECT_EQ(BKLSimpleElement(s.toPermutation().tinyFlip(1)), s.tinyFlip(1));
+  }
+}
+
+TEST(BKLSimpleElement, Lattice) {
+  const size_t n = 6;
+  const auto all = allSimpleElements(n);
+
+  for (const auto& a : all) {
+    for (const auto& b : all) {
+      const auto meet = a.meet(b);
+      const auto join = a.join(b);
+
+      ASSERT_TRUE(meet.divides(a) && meet.divides(b));
+      ASSERT_TRUE(a.divides(join) && b.divides(join));
+
+      // divisibility is prefix order
+      ASSERT_EQ(join, a * join.leftQuotient(a));
+
+      for (const auto& c : all) {
+        if (c.divides(a) && c.divides(b)) {
+          ASSERT_TRUE(c.divides(meet));
+        }
+
+        if (a.divides(c) && b.divides(c)) {
+          ASSERT_TRUE(join.divides(c));
+        }
+      }
+    }
+  }
+}
+
+TEST(BKLLeftNormalForm, Word) {
+  std::mt19937_64 g(0);
+
+  for (const size_t n : {4, 5, 8, 16}) {
+    const BraidGroup B(n);
+
+    for (size_t i = 0; i < 50; ++i) {
+      const auto w = random::randomWord(n - 1, 5, 40, g);
+      const auto v = random::randomWord(n - 1, 5, 40, g);
+
+      const BKLLeftNormalForm nf(B, w);
+      const BKLLeftNormalForm nf_v(B, v);
+
+      EXPECT_EQ(nf, BKLLeftNormalForm(B, nf.getWord()));
+      EXPECT_EQ(BKLLeftNormalForm(B, w * v), nf * nf_v);
+      EXPECT_EQ(BKLLeftNormalForm(B, -w), -nf);
+      EXPECT_EQ(BKLLeftNormalForm(n), nf * -nf);
+    }
+  }
+}
+
+TEST(BKLLeftNormalForm, Conjugacy) {
+  std::mt19937_64 g(0);
+
+  for (const size_t n : {4, 5, 8}) {
+    const BraidGroup B(n);
+
+    for (size_t i = 0; i < 10; ++i) {
+      const BKLLeftNormalForm x(B, random::randomWord(n - 1, 10, 20, g));
+      const BKLLeftNormalForm c(B, random::randomWord(n - 1, 10, 20, g));
+      const auto y = -c * x * c;
+
+      const auto result = x.areConjugate(y);
+
+      ASSERT_TRUE(result.first);
+      EXPECT_EQ(y, -result.second * x * result.second);
+    }
+  }
+}
+
+TEST(BKLLeftNormalForm, NotConjugate) {
+  const size_t n = 5;
+  const BraidGroup B(n);
+
+  EXPECT_FALSE(BKLLeftNormalForm(B, Word({1, 2})).areConjugate(BKLLeftNormalForm(B, Word({1, 1}))).first);
+  EXPECT_FALSE(BKLLeftNormalForm(B, Word({1, 2, 3})).areConjugate(BKLLeftNormalForm(B, Word({1, 3, 3}))).first);
+}
+
+} // namespace
+} // namespace braidgroup
+} // namespace crag
@@ -2,6 +2,11 @@
 
 #include "colored_burau.h"
 
+#include "Fp.h"
+#include "GF2k.h"
+#include "e_multiplication_tree.h"
+#include "packed_colored_burau.h"
+
 #include "braid_group.h"
 #include "random_word.h"
 
@@ -164,6 +169,14 @@ TEST(ColoredBurau, B_n_mapping_over_gf256) {
   testBnMapping<GF256>(10);
 }
 
+TEST(ColoredBurau, B_n_mapping_over_gf2k) {
+  testBnMapping<finitefield::GF256>(10);
+}
+
+TEST(ColoredBurau, B_n_mapping_over_fp) {
+  testBnMapping<finitefield::Fp<1237>>(10);
+}
+
 TEST(ColoredBurau, EMultiplication1) {
   const auto m = Matrix<ZZ5>(3, {ZZ5(3), ZZ5(2), ZZ5(1), ZZ5(1), ZZ5(4), ZZ5(2), ZZ5(3), ZZ5(3), ZZ5(0)});
   const auto p = Permutation({2, 0, 1});
@@ -243,6 +256,182 @@ TEST(ColoredBurau, Hash) {
   }
 }
 
+TEST(ColoredBurau, PackedEMultiplication) {
+  using FF = GF256;
+
+  const size_t n = 16;
+  std::vector<FF> t_values(n, FF(0));
+
+  std::mt19937 g(0);
+
+  for (size_t i = 0; i < n; ++i) {
+    t_values[i] = finitefield::generateNonZeroNonUnit<FF>(g);
+  }
+
+  for (size_t i = 0; i < 100; ++i) {
+    const auto random_w = random::randomWord(n - 1, 20, 30, g);
+    const auto expected = project(random_w, t_values);
+    const auto packed = projectPacked(random_w, t_values);
+
+    EXPECT_EQ(expected, packed.toProjectionElement()) << "case: i = " << i;
+    EXPECT_EQ(std::hash<CBProjectionElement<FF>>()(expected), std::hash<PackedCBProjectionElement<FF>>()(packed));
+
+    // continue from a converted element
+    const auto suffix = random::randomWord(n - 1, 5, 10, g);
+    EXPECT_EQ(expected * suffix, (PackedCBProjectionElement<FF>(expected) * suffix).toProjectionElement());
+  }
+}
+
+TEST(ColoredBurau, PackedEMultiplicationGF2k) {
+  // GF2k is the same field as GF256, its elements are the bit masks of the coefficients
+  using FF = finitefield::GF256;
+
+  const auto toGF256 = [](const FF& x) {
+    std::vector<finitefield::ZZ<2>> coefficients;
+
+    for (auto bits = x.value(); bits != 0; bits >>= 1) {
+      coefficients.push_back(finitefield::ZZ<2>(static_cast<int>(bits & 1)));
+    }
+
+    return GF256(GF256::RingElement(coefficients.begin(), coefficients.end()));
+  };
+
+  const size_t n = 16;
+  std::mt19937 g(0);
+
+  std::vector<FF> t_values;
+  std::vector<GF256> gf256_t_values;
+
+  for (size_t i = 0; i < n; ++i) {
+    t_values.push_back(finitefield::generateNonZeroNonUnit<FF>(g));
+    gf256_t_values.push_back(toGF256(t_values.back()));
+  }
+
+  for (size_t i = 0; i < 20; ++i) {
+    const auto random_w = random::randomWord(n - 1, 20, 30, g);
+    const auto result = projectPacked(random_w, t_values);
+    const auto expected = projectPacked(random_w, gf256_t_values);
+
+    ASSERT_EQ(expected.permutation(), result.permutation());
+
+    for (size_t r = 0; r < n; ++r) {
+      for (size_t c = 0; c < n; ++c) {
+        EXPECT_EQ(expected(r, c), toGF256(result(r, c)));
+      }
+    }
+  }
+}
+
+TEST(ColoredBurau, PackedEMultiplicationFp) {
+  // Fp<p> and ZZ<p> are the same field, so the projections and their hashes agree
+  using FF = finitefield::Fp<1237>;
+  using ZZ = finitefield::ZZ<1237>;
+
+  std::mt19937 g(0);
+
+  for (const size_t n : {8, 16, 21}) {
+    std::vector<FF> t_values;
+    std::vector<ZZ> zz_t_values;
+
+    for (size_t i = 0; i < n; ++i) {
+      zz_t_values.push_back(finitefield::generateNonZeroNonUnit<ZZ>(g));
+      t_values.push_back(FF(zz_t_values.back().value()));
+    }
+
+    for (size_t i = 0; i < 20; ++i) {
+      const auto random_w = random::randomWord(n - 1, 20, 30, g);
+      const auto result = projectPacked(random_w, t_values);
+      const auto expected = projectPacked(random_w, zz_t_values);
+
+      EXPECT_EQ(std::hash<PackedCBProjectionElement<ZZ>>()(expected), std::hash<PackedCBProjectionElement<FF>>()(result));
+      EXPECT_EQ(result, EMultiplicationTree<FF>(t_values, random_w, 4).projection());
+    }
+  }
+}
+
+TEST(ColoredBurau, PackedZeroTValue) {
+  const std::vector<ZZ5> t_values = {ZZ5(2), ZZ5(0), ZZ5(3)};
+
+  EXPECT_NO_THROW(projectPacked(Word({1, 2}), t_values));
+  EXPECT_THROW(projectPacked(Word({-1}), t_values), std::logic_error);
+}
+
+TEST(ColoredBurau, PackedSegments) {
+  using FF = finitefield::ZZ<1237>;
+
+  const size_t n = 8;
+  std::mt19937 g(0);
+
+  std::vector<FF> t_values;
+  for (size_t i = 0; i < n; ++i) {
+    t_values.push_back(finitefield::generateNonZeroNonUnit<FF>(g));
+  }
+
+  for (size_t i = 0; i < 20; ++i) {
+    const auto u = random::randomWord(n - 1, 10, 20, g);
+    const auto v = random::randomWord(n - 1, 10, 20, g);
+
+    auto lhs = projectPacked(u, t_values);
+    const auto segment = projectPacked(v, lhs.currentTValues());
+
+    ASSERT_TRUE(lhs.isContinuedBy(segment));
+    EXPECT_EQ(projectPacked(u * v, t_values), lhs *= segment);
+  }
+}
+
+TEST(ColoredBurau, EMultiplicationTree) {
+  using FF = finitefield::ZZ<1237>;
+
+  const size_t n = 8;
+  std::mt19937 g(0);
+
+  std::vector<FF> t_values;
+  for (size_t i = 0; i < n; ++i) {
+    t_values.push_back(finitefield::generateNonZeroNonUnit<FF>(g));
+  }
+
+  const auto w = random::randomWord(n - 1, 300, 300, g);
+
+  EMultiplicationTree<FF> tree(t_values, w, 16);
+  EXPECT_EQ(projectPacked(w, t_values), tree.projection());
+
+  auto expected = w.toVector();
+  std::uniform_int_distribution<size_t> position(0, w.length() - 1);
+
+  for (size_t i = 0; i < 100; ++i) {
+    const auto pos = position(g) % expected.size();
+    const auto len = std::min<size_t>(i % 5, expected.size() - pos);
+
+    // inverting letters keeps the permutation, random words usually change it
+    const auto u = i % 2 == 0 ? Word(-expected[pos]) : random::randomWord(n - 1, 0, 6, g);
+
+    auto letters = std::vector<int>(expected.begin(), expected.begin() + pos);
+    const auto u_letters = u.toVector();
+    letters.insert(letters.end(), u_letters.begin(), u_letters.end());
+    letters.insert(letters.end(), expected.begin() + pos + len, expected.end());
+
+    const auto projection = projectPacked(Word(letters), t_values);
+    EXPECT_EQ(projection, tree.projectReplaced(pos, len, u)) << "case: i = " << i;
+
+    if (i % 3 == 0) {
+      tree.replace(pos, len, u);
+      expected = std::move(letters);
+
+      EXPECT_EQ(expected.size(), tree.length());
+      EXPECT_EQ(projection, tree.projection()) << "case: i = " << i;
+    }
+  }
+
+  EXPECT_EQ(expected, tree.letters());
+
+  // cancelling letters are kept, so the positions refer to the same letters as before
+  EMultiplicationTree<FF> small(t_values, Word({1, 2}), 16);
+  small.replace(1, 0, Word(-1));
+  EXPECT_EQ(3, small.length());
+  EXPECT_EQ(std::vector<int>({1, -1, 2}), small.letters());
+  EXPECT_EQ(projectPacked(Word(2), t_values), small.projection());
+}
+
 TEST(Permutation, Ex_01) {
   const size_t n = 16;
   std::mt19937_64 g(0);
@@ -2,6 +2,8 @@
 
 #include "fast_identity_check.h"
 
+#include "batch_identity_check.h"
+
 #include "braid_group.h"
 #include "random_word.h"
 
@@ -86,6 +88,94 @@ TEST(FastIdCheck, HashVector) {
     EXPECT_EQ(h, hasher(other_words));
   }
 }
+TEST(FastIdCheck, Batch) {
+  using FF = finitefield::ZZ<199>;
+
+  const size_t n = 10;
+
+  BatchIdentityChecker<FF> checker(n);
+  std::mt19937_64 g(0);
+
+  std::vector<Word> words;
+  std::vector<bool> expected;
+
+  for (size_t i = 0; i < 50; ++i) {
+    const auto w = random::randomWord(n - 1, 10, 20, g);
+    const auto c = random::randomWord(n - 1, 10, 20, g);
+
+    words.push_back(-c * w * c * -w);
+    expected.push_back(false);
+
+    // trivial, but not freely trivial
+    words.push_back(-c * w * c * -c * -w * c);
+    expected.push_back(true);
+  }
+
+  const auto result = checker.areTrivial(words);
+
+  ASSERT_EQ(words.size(), result.size());
+
+  for (size_t i = 0; i < words.size(); ++i) {
+    EXPECT_EQ(expected[i], result[i]);
+  }
+
+  // only the trivial words reach handle reduction
+  const auto stats = checker.stats();
+  EXPECT_EQ(100, stats.filtered);
+  EXPECT_EQ(50, stats.filter_rejected);
+  EXPECT_EQ(50, stats.reduced);
+  EXPECT_EQ(0, stats.reduction_rejected);
+
+  checker.resetStats();
+  EXPECT_EQ(0, checker.stats().filtered);
+
+  EXPECT_TRUE(checker.areAllTrivial(std::vector<Word>{words[1], words[3]}));
+  EXPECT_FALSE(checker.areAllTrivial(std::vector<Word>{words[1], words[2]}));
+  EXPECT_TRUE(checker.areAllTrivial(std::vector<Word>{}));
+
+  const auto batches = checker.areAllTrivial(std::vector<std::vector<Word>>{
+      {words[1], words[3], words[5]},
+      {words[1], words[0], words[5]},
+      {},
+  });
+
+  ASSERT_EQ(3, batches.size());
+  EXPECT_TRUE(batches[0]);
+  EXPECT_FALSE(batches[1]);
+  EXPECT_TRUE(batches[2]);
+}
+
+TEST(FastIdCheck, BatchFilterMiss) {
+  // over Z/3 all t values are -1, so the colored Burau image of x1^6 is trivial,
+  // such words pass the filter and must be rejected by handle reduction
+  using FF = finitefield::ZZ<3>;
+
+  const size_t n = 4;
+
+  BatchIdentityChecker<FF> checker(n);
+  std::mt19937_64 g(0);
+
+  const auto x1_6 = Word(1) * Word(1) * Word(1) * Word(1) * Word(1) * Word(1);
+
+  std::vector<Word> words;
+
+  for (size_t i = 0; i < 20; ++i) {
+    const auto c = random::randomWord(n - 1, 5, 10, g);
+    words.push_back(-c * x1_6 * c);
+  }
+
+  const auto result = checker.areTrivial(words);
+
+  for (size_t i = 0; i < words.size(); ++i) {
+    EXPECT_FALSE(result[i]);
+  }
+
+  const auto stats = checker.stats();
+  EXPECT_EQ(0, stats.filter_rejected);
+  EXPECT_EQ(words.size(), stats.reduced);
+  EXPECT_EQ(words.size(), stats.reduction_rejected);
+}
+
 } // namespace
 } // namespace braidgroup
 } // namespace crag
\ No newline at end of file
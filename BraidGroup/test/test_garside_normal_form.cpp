@@ -0,0 +1,361 @@
+#include <gtest/gtest.h>
+
+#include "garside_normal_form.h"
+
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include "PackedPermutation.h"
+#include "Permutation.h"
+#include "ThLeftNormalForm.h"
+#include "ThRightNormalForm.h"
+#include "braid_group.h"
+#include "parallel_normal_form.h"
+#include "random_word.h"
+#include "summit_set_search.h"
+
+namespace crag {
+namespace braidgroup {
+namespace garside {
+namespace {
+
+std::vector<Permutation> randomDecomposition(size_t rank, size_t length) {
+  std::vector<Permutation> result;
+
+  for (size_t i = 0; i < length; ++i) {
+    result.push_back(Permutation::random(rank));
+  }
+
+  return result;
+}
+
+TEST(GarsideNormalForm, RightWeightedPairs) {
+  for (const int n : {5, 12, 64, 70}) {
+    const auto omega = Permutation::getHalfTwistPermutation(n);
+
+    for (int attempt = 0; attempt < 100; ++attempt) {
+      auto p1 = Permutation::random(n);
+      auto p2 = Permutation::random(n);
+
+      // make every other pair right-weighted
+      if (attempt % 2) {
+        p1 *= -p1.RightGCD(omega * -p2);
+      }
+
+      const auto trivial_meet = p1.RightGCD(omega * -p2).isTrivial();
+
+      EXPECT_EQ(trivial_meet, transform(n, p1, p2) == Transformation::NoChange);
+    }
+  }
+}
+
+TEST(GarsideNormalForm, HalfTwistIsAbsorbed) {
+  const int n = 6;
+  const auto omega = Permutation::getHalfTwistPermutation(n);
+
+  std::vector<Permutation> decomp = {omega, omega};
+  int power = 0;
+
+  adjustDecomposition(n, power, decomp);
+
+  EXPECT_EQ(2, power);
+  EXPECT_TRUE(decomp.empty());
+}
+
+TEST(GarsideNormalForm, FactorsAreLeftWeighted) {
+  const int n = 8;
+  const auto omega = Permutation::getHalfTwistPermutation(n);
+
+  for (int attempt = 0; attempt < 20; ++attempt) {
+    auto decomp = randomDecomposition(n, 10);
+    int power = 0;
+
+    adjustDecomposition(n, power, decomp);
+
+    for (auto it = decomp.begin(); it != decomp.end(); ++it) {
+      EXPECT_FALSE(it->isTrivial());
+      EXPECT_NE(omega, *it);
+
+      const auto next = std::next(it);
+
+      if (next != decomp.end()) {
+        auto p1 = *it;
+        auto p2 = *next;
+
+        EXPECT_EQ(Transformation::NoChange, transform(n, p1, p2));
+      }
+    }
+  }
+}
+
+TEST(GarsideNormalForm, PackedPermutationFactors) {
+  for (const int n : {4, 9, 16, 32}) {
+    for (int attempt = 0; attempt < 10; ++attempt) {
+      auto decomp = randomDecomposition(n, 12);
+
+      std::vector<PackedPermutation> packed_decomp;
+      packed_decomp.reserve(decomp.size());
+      for (const auto& p : decomp) {
+        packed_decomp.emplace_back(p);
+      }
+
+      int power = 0;
+      int packed_power = 0;
+
+      adjustDecomposition(n, power, decomp);
+      adjustDecomposition(n, packed_power, packed_decomp);
+
+      EXPECT_EQ(power, packed_power);
+      ASSERT_EQ(decomp.size(), packed_decomp.size());
+
+      auto it = decomp.begin();
+      for (const auto& p : packed_decomp) {
+        EXPECT_EQ(*it++, p.toPermutation());
+      }
+    }
+  }
+}
+
+TEST(GarsideNormalForm, NormalizedPrefixIsSkipped) {
+  const int n = 7;
+
+  for (int attempt = 0; attempt < 20; ++attempt) {
+    auto decomp = randomDecomposition(n, 8);
+    int power = 0;
+    adjustDecomposition(n, power, decomp);
+
+    const auto normalized = decomp.size();
+    const auto tail = randomDecomposition(n, 5);
+    decomp.insert(decomp.end(), tail.begin(), tail.end());
+
+    auto expected = decomp;
+    int expected_power = power;
+
+    adjustDecomposition(n, expected_power, expected);
+    adjustDecomposition(n, power, decomp, normalized);
+
+    EXPECT_EQ(expected_power, power);
+    EXPECT_EQ(expected, decomp);
+  }
+}
+
+TEST(GarsideNormalForm, RightNormalFormOperations) {
+  const size_t n = 6;
+  const BraidGroup B(n);
+  std::mt19937 g(0);
+
+  for (int attempt = 0; attempt < 20; ++attempt) {
+    const auto u = random::randomWord(n - 1, 30, g);
+    const auto v = random::randomWord(n - 1, 30, g);
+
+    const ThRightNormalForm nf_u(B, u);
+    const ThRightNormalForm nf_v(B, v);
+
+    EXPECT_EQ(ThRightNormalForm(B, u * v), nf_u * nf_v);
+    EXPECT_EQ(ThRightNormalForm(B, -u), -nf_u);
+    EXPECT_TRUE((nf_u * -nf_u).isTrivial());
+    EXPECT_EQ(nf_u, ThRightNormalForm(B, nf_u.getWord()));
+
+    const auto cycled = nf_u.cycle();
+    EXPECT_EQ(cycled.first, -cycled.second * nf_u * cycled.second);
+
+    const auto decycled = nf_u.decycle();
+    EXPECT_EQ(decycled.first, -decycled.second * nf_u * decycled.second);
+  }
+}
+
+TEST(GarsideNormalForm, IncrementalRightNormalForm) {
+  for (const size_t n : {4, 7}) {
+    const BraidGroup B(n);
+    std::mt19937 g(n);
+
+    for (int attempt = 0; attempt < 10; ++attempt) {
+      const auto w = random::randomWord(n - 1, 60, g);
+
+      ThRightNormalForm appended(n);
+      ThRightNormalForm prepended(n);
+      std::vector<int> reversed;
+
+      for (const auto x : w) {
+        appended.push_back(x);
+        prepended.push_front(x);
+        reversed.insert(reversed.begin(), x);
+
+        EXPECT_EQ(ThRightNormalForm(B, Word(reversed)), prepended);
+      }
+
+      EXPECT_EQ(ThRightNormalForm(B, w), appended);
+
+      // the form is read only at the end, so the flips from several inverse generators are pending
+      auto chained = appended;
+      Word chained_word = w;
+      for (int i = 0; i < 20; ++i) {
+        const int x = std::uniform_int_distribution<int>(1, n - 1)(g) * (i % 3 ? -1 : 1);
+        const int y = std::uniform_int_distribution<int>(1, n - 1)(g) * (i % 2 ? -1 : 1);
+        chained.push_front(x);
+        chained.conjugate(y);
+        chained_word = Word(-y) * Word(x) * chained_word * Word(y);
+      }
+      EXPECT_EQ(ThRightNormalForm(B, chained_word), chained);
+
+      for (int i = 0; i < 10; ++i) {
+        const int x = std::uniform_int_distribution<int>(1, n - 1)(g) * (i % 2 ? 1 : -1);
+        const auto s = Permutation::random(n);
+
+        auto conjugated = appended;
+        conjugated.conjugate(x);
+        EXPECT_EQ(ThRightNormalForm(B, Word(-x) * w * Word(x)), conjugated);
+
+        conjugated = appended;
+        conjugated.conjugate(s);
+        EXPECT_EQ(-ThRightNormalForm(s) * appended * ThRightNormalForm(s), conjugated);
+
+        auto multiplied = appended;
+        multiplied.multiplyLeft(s);
+        multiplied.multiplyRight(s);
+        EXPECT_EQ(ThRightNormalForm(s) * appended * ThRightNormalForm(s), multiplied);
+      }
+    }
+  }
+}
+
+TEST(GarsideNormalForm, AreConjugate) {
+  for (const size_t n : {4, 5}) {
+    const BraidGroup B(n);
+    std::mt19937 g(2);
+
+    for (int attempt = 0; attempt < 5; ++attempt) {
+      const auto w = random::randomWord(n - 1, 10, g);
+      const auto c = random::randomWord(n - 1, 10, g);
+
+      const ThRightNormalForm nf1(B, w);
+      const ThRightNormalForm nf2(B, -c * w * c);
+
+      const auto result = nf1.areConjugate(nf2);
+
+      ASSERT_TRUE(result.first);
+      EXPECT_EQ(nf1, -result.second * nf2 * result.second);
+
+      const ThLeftNormalForm left_nf1(B, w);
+      const ThLeftNormalForm left_nf2(B, -c * w * c);
+
+      const auto uss_result = left_nf1.areConjugate_uss(left_nf2);
+
+      ASSERT_TRUE(uss_result.first);
+      EXPECT_EQ(left_nf1, -uss_result.second * left_nf2 * uss_result.second);
+    }
+  }
+}
+
+TEST(GarsideNormalForm, SummitSetSearch) {
+  using summit::Clock;
+  using Meeting = summit::Meeting<int>;
+
+  // the vertices are integers, the neighbours of v are v-1 and v+1, and the value of a vertex is
+  // the number of steps from the start
+  const auto expand = [](const std::pair<int, int>& v, const summit::SummitSets<int, int>& sets,
+                         std::vector<std::vector<std::pair<int, int>>>& paths) {
+    for (const int next : {v.first - 1, v.first + 1}) {
+      if (sets.isChecked(next)) {
+        continue;
+      }
+      paths.push_back({{next, v.second + 1}});
+      if (sets.isInOther(next)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  const auto search = [&](size_t max_vertices, Clock::time_point deadline) {
+    std::unordered_map<int, int> new1 = {{0, 0}}, checked1, new2 = {{10, 0}}, checked2;
+    return summit::findMeeting(new1, checked1, new2, checked2, max_vertices, deadline, expand);
+  };
+
+  const auto met = search(1000, Clock::time_point::max());
+  ASSERT_EQ(Meeting::Status::Met, met.status);
+  EXPECT_EQ(10, met.first + met.second);
+
+  // the sets meet at 5 after processing the vertices at distance at most 4 from the starts
+  EXPECT_EQ(Meeting::Status::NotMet, search(4, Clock::time_point::max()).status);
+
+  EXPECT_EQ(Meeting::Status::Expired, search(1000, Clock::now()).status);
+}
+
+TEST(GarsideNormalForm, LeftNormalFormOperations) {
+  const size_t n = 6;
+  const BraidGroup B(n);
+  std::mt19937 g(1);
+
+  for (int attempt = 0; attempt < 20; ++attempt) {
+    const auto u = random::randomWord(n - 1, 30, g);
+    const auto v = random::randomWord(n - 1, 30, g);
+
+    const ThLeftNormalForm nf_u(B, u);
+    const ThLeftNormalForm nf_v(B, v);
+
+    EXPECT_EQ(ThLeftNormalForm(B, u * v), nf_u * nf_v);
+    EXPECT_EQ(ThLeftNormalForm(B, -u), -nf_u);
+    EXPECT_EQ(nf_u, ThLeftNormalForm(B, nf_u.getWord()));
+    EXPECT_EQ(nf_u, ThRightNormalForm(B, u).operator ThLeftNormalForm());
+
+    const auto cycled = nf_u.cycle();
+    EXPECT_EQ(cycled.first, -cycled.second * nf_u * cycled.second);
+
+    const auto decycled = nf_u.decycle();
+    EXPECT_EQ(decycled.first, -decycled.second * nf_u * decycled.second);
+  }
+}
+
+TEST(GarsideNormalForm, NormalFormHash) {
+  const size_t n = 5;
+  const BraidGroup B(n);
+  std::mt19937 g(4);
+
+  std::unordered_set<ThRightNormalForm> right_forms;
+  std::unordered_set<ThLeftNormalForm> left_forms;
+
+  for (int attempt = 0; attempt < 20; ++attempt) {
+    const auto u = random::randomWord(n - 1, 20, g);
+    const auto v = random::randomWord(n - 1, 20, g);
+
+    // the same braid given by different words
+    EXPECT_EQ(ThRightNormalForm(B, u * v).hash(), ThRightNormalForm(B, u * -v * v * v).hash());
+    EXPECT_EQ(ThLeftNormalForm(B, u * v).hash(), ThLeftNormalForm(B, u * -v * v * v).hash());
+
+    right_forms.insert(ThRightNormalForm(B, u));
+    right_forms.insert(ThRightNormalForm(B, u * v * -v));
+    left_forms.insert(ThLeftNormalForm(B, u));
+    left_forms.insert(ThLeftNormalForm(B, u * v * -v));
+  }
+
+  EXPECT_EQ(20, right_forms.size());
+  EXPECT_EQ(20, left_forms.size());
+}
+
+TEST(GarsideNormalForm, ParallelNormalForm) {
+  const size_t n = 6;
+  const BraidGroup B(n);
+  std::mt19937 g(3);
+
+  EXPECT_EQ(ThRightNormalForm(n), parallelRightNormalForm(B, Word()));
+  EXPECT_THROW(parallelRightNormalForm(B, Word(), 0), std::invalid_argument);
+
+  for (int attempt = 0; attempt < 5; ++attempt) {
+    const auto w = random::randomWord(n - 1, 200, g);
+
+    EXPECT_EQ(ThRightNormalForm(B, w), parallelRightNormalForm(B, w));
+    EXPECT_EQ(ThLeftNormalForm(B, w), parallelLeftNormalForm(B, w));
+
+    for (const size_t chunks : {1, 2, 3, 8, 1000}) {
+      EXPECT_EQ(ThRightNormalForm(B, w), parallelRightNormalForm(B, w, chunks));
+      EXPECT_EQ(ThLeftNormalForm(B, w), parallelLeftNormalForm(B, w, chunks));
+    }
+  }
+}
+
+} // namespace
+} // namespace garside
+} // namespace braidgroup
+} // namespace crag
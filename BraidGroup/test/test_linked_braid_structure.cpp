@@ -4,6 +4,7 @@
 #include "LinkedBraidStructure.h"
 #include "ShortBraidForm.h"
 #include "random_word.h"
+#include "streaming_handle_reduction.h"
 
 namespace crag {
 namespace {
@@ -34,6 +35,48 @@ TEST(LinkedBraidStructure, Equivalence) {
   }
 }
 
+TEST(LinkedBraidStructure, Undo) {
+  const size_t n = 8;
+
+  std::mt19937_64 g(0);
+
+  for (size_t i = 0; i < 20; ++i) {
+    const auto w = random::randomWord(n - 1, 200, 1000, g);
+
+    LinkedBraidStructure lbs(n - 1, w);
+    std::list<LinkedBraidStructureTransform> transforms;
+
+    lbs.removeRightHandles(&transforms);
+    lbs.removeLeftHandles(&transforms);
+    EXPECT_TRUE(areEqualBraids(n, w, lbs.translateIntoWord()));
+
+    lbs.undo(transforms);
+    EXPECT_EQ(w.length(), lbs.size());
+    EXPECT_EQ(LinkedBraidStructure(n - 1, w).translateIntoWord(), lbs.translateIntoWord());
+  }
+}
+
+TEST(LinkedBraidStructure, ReusesErasedNodes) {
+  LinkedBraidStructure lbs(2);
+  lbs.push_back(1);
+  lbs.push_back(2);
+  lbs.push_back(-2);
+
+  std::list<LinkedBraidStructureTransform> transforms;
+  lbs.removeLeftHandles(&transforms);
+  EXPECT_EQ(1, lbs.size());
+
+  // the new nodes take the numbers of the erased ones instead of growing the arena
+  transforms.push_back(lbs.push_back(1));
+  transforms.push_back(lbs.push_front(2));
+  EXPECT_EQ(1, transforms.back().theNumber);
+  EXPECT_EQ(2, std::prev(transforms.end(), 2)->theNumber);
+  EXPECT_EQ(Word({2, 1, 1}), lbs.translateIntoWord());
+
+  lbs.undo(transforms);
+  EXPECT_EQ(Word({1, 2, -2}), lbs.translateIntoWord());
+}
+
 TEST(LinkedBraidStructure, LongWords) {
   const size_t n = 16;
 
@@ -46,5 +89,64 @@ TEST(LinkedBraidStructure, LongWords) {
     EXPECT_TRUE(areEqualBraids(n, w, w_short));
   }
 }
+
+TEST(LinkedBraidStructure, ParallelLongWords) {
+  const size_t n = 16;
+
+  std::mt19937_64 g(0);
+
+  for (size_t i = 0; i < 2; ++i) {
+    const auto w = random::randomWord(n - 1, 20000, g);
+
+    EXPECT_EQ(shortenBraid2(n, w), parallelShortenBraid2(n, w));
+    EXPECT_TRUE(areEqualBraids(n, w, parallelShortenBraid2(n, w, true)));
+  }
+}
+
+TEST(LinkedBraidStructure, Streaming) {
+  const size_t n = 8;
+
+  std::mt19937_64 g(0);
+
+  for (size_t i = 0; i < 5; ++i) {
+    const auto w = random::randomWord(n - 1, 5000, g);
+
+    for (const size_t window : {2, 64, 1000, 10000}) {
+      const auto w_dehornoy = braidgroup::streamingDehornoy(n, w, window);
+      const auto w_short = braidgroup::streamingShortenBraid(n, w, window);
+
+      EXPECT_TRUE(areEqualBraids(n, w, w_dehornoy));
+      EXPECT_TRUE(areEqualBraids(n, w, w_short));
+    }
+
+    // the window covers the whole word
+    EXPECT_EQ(dehornoy(n, w), braidgroup::streamingDehornoy(n, w, 2 * w.length()));
+  }
+}
+
+TEST(LinkedBraidStructure, StreamingReport) {
+  const size_t n = 8;
+
+  std::mt19937_64 g(0);
+  const auto w = random::randomWord(n - 1, 5000, g);
+
+  std::vector<int> pieces;
+  braidgroup::StreamingHandleReduction reduction(
+      n, 500, [&pieces](const Word& piece) { pieces.insert(pieces.end(), piece.begin(), piece.end()); });
+
+  reduction.push_back(w);
+  EXPECT_EQ(w.length(), reduction.consumed());
+  EXPECT_LT(reduction.consumed() - reduction.emitted(), 500);
+
+  reduction.finish();
+  EXPECT_EQ(pieces.size(), reduction.emitted());
+
+  const auto report = braidgroup::compareStreamingReduction(n, w, 500);
+  EXPECT_EQ(w.length(), report.input_length);
+  EXPECT_EQ(dehornoy(n, w).length(), report.full_length);
+  EXPECT_EQ(report.streaming_length, report.full_length + report.lost());
+
+  EXPECT_THROW(braidgroup::StreamingHandleReduction(n, 1, [](const Word&) {}), std::invalid_argument);
+}
 } // namespace
 } // namespace crag
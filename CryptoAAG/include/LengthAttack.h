@@ -10,6 +10,8 @@
 #define _LengthAttack_H_
 
 #include "Word.h"
+#include <set>
+#include <unordered_set>
 #include <vector>
 using namespace std;
 
@@ -25,6 +27,16 @@ enum findKey_LengthBasedResult {
 
 typedef pair< int , vector< Word > > ELT;
 
+//! Hash of a tuple (its weight is determined by the tuple itself)
+struct ELT_Hash {
+  size_t operator()( const ELT& elt ) const {
+    return hash< vector< Word > >()( elt.second );
+  }
+};
+
+//! Set of already processed tuples
+typedef unordered_set< ELT , ELT_Hash > ELT_Set;
+
 //
 //  LENGTH-BASED ATTACK CLASS INTERFACE
 //
@@ -85,8 +97,8 @@ public:
 						       int sec = 9999999, ostream& out = cout );
 private:												
 	int  sbgpGeneratorsWeight( const vector< Word >& A );
-	void addNewElt( const vector< Word >& A , set< ELT >& checkedElements , set< ELT >& uncheckedElements );
-	void tryElt( int N , const ELT& cur , const vector< Word >& B , set< ELT >& checkedElements , set< ELT >& uncheckedElements );
+	void addNewElt( const vector< Word >& A , ELT_Set& checkedElements , set< ELT >& uncheckedElements );
+	void tryElt( int N , const ELT& cur , const vector< Word >& B , ELT_Set& checkedElements , set< ELT >& uncheckedElements );
 	bool check_ifVectorsEqual( int N , const vector< Word >& A1 , const vector< Word >& A2 );	
 };
 
@@ -122,9 +134,9 @@ public:
 						       int sec = 9999999, ostream& out = cout );
 private:												
 	int  sbgpGeneratorsWeight( const vector< Word >& A );
-	void addNewElt( const vector< Word >& A , set< ELT >& checkedElements , set< ELT >& uncheckedElements );
-	void tryElt( int N , const ELT& cur , const vector< Word >& B , set< ELT >& checkedElements , set< ELT >& uncheckedElements );
-	void tryElt( int N , const ELT& cur , const vector< Word >& B , set< ELT >& checkedElements , set< ELT >& uncheckedElements, ostream& out );
+	void addNewElt( const vector< Word >& A , ELT_Set& checkedElements , set< ELT >& uncheckedElements );
+	void tryElt( int N , const ELT& cur , const vector< Word >& B , ELT_Set& checkedElements , set< ELT >& uncheckedElements );
+	void tryElt( int N , const ELT& cur , const vector< Word >& B , ELT_Set& checkedElements , set< ELT >& uncheckedElements, ostream& out );
 	bool check_ifVectorsEqual( int N , const vector< Word >& A1 , const vector< Word >& A2 );	
 };
 
@@ -164,9 +176,9 @@ public:
 	void addProducts(  const vector<Word>& elem_set, vector<Word>& ext_set, vector<Word>& ext_set_sg_gens, const Word& sel_gen, int sel_gen_sg );
 	void addAllProducts(  const vector<Word>& elem_set, vector<Word>& ext_set, vector<Word>& ext_set_sg_gens );
 	int  sbgpGeneratorsWeight( const vector< Word >& A );
-	void addNewElt( const vector< Word >& A , set< ELT >& checkedElements , set< ELT >& uncheckedElements );
-	void tryElt( int N , const ELT& cur , const vector< Word >& B , set< ELT >& checkedElements , set< ELT >& uncheckedElements );
-	void tryElt( int N , const ELT& cur , const vector< Word >& B , const vector<Word>& B_sg_gens,set< ELT >& checkedElements , 
+	void addNewElt( const vector< Word >& A , ELT_Set& checkedElements , set< ELT >& uncheckedElements );
+	void tryElt( int N , const ELT& cur , const vector< Word >& B , ELT_Set& checkedElements , set< ELT >& uncheckedElements );
+	void tryElt( int N , const ELT& cur , const vector< Word >& B , const vector<Word>& B_sg_gens,ELT_Set& checkedElements , 
 		     set< ELT >& uncheckedElements,
 		     bool is_B_extended,
 		     ostream& out );
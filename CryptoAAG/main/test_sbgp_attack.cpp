@@ -9,6 +9,7 @@
 
 #include <set>
 #include <map>
+#include <unordered_map>
 #include <iterator>
 #include <iostream>
 #include <fstream>
@@ -66,7 +67,7 @@ bool areSeparate( int N , const Word& w1 , const Word& w2 )
 //---------------------------------------------------------------------------//
 
 
-bool reducePair( int N , set< Word >& new_elts , map< Word , bool >& checked_elts , map< Word , Word >& conj_elts , Word w1 , Word w2 , Word cw2 , ostream& os=cout )
+bool reducePair( int N , set< Word >& new_elts , map< Word , bool >& checked_elts , unordered_map< Word , Word >& conj_elts , Word w1 , Word w2 , Word cw2 , ostream& os=cout )
 {
   if( areSeparate( N , w1 , w2 ) ) 
     return false;
@@ -117,7 +118,7 @@ bool reducePair( int N , set< Word >& new_elts , map< Word , bool >& checked_elt
 //---------------------------------------------------------------------------//
 
 
-void reduceSbgpPresentation( int N , set< Word >& _new_elts , set< Word >& _checked_elts , map< Word , Word >& conj_elts , const Word& w , ostream& os=cout )
+void reduceSbgpPresentation( int N , set< Word >& _new_elts , set< Word >& _checked_elts , unordered_map< Word , Word >& conj_elts , const Word& w , ostream& os=cout )
 {
   set< Word > new_elts;
   new_elts.insert( w );
@@ -153,8 +154,8 @@ void reduceSbgpPresentation( int N , set< Word >& _new_elts , set< Word >& _chec
   }
 
   // clean conj_elts;
-  map< Word , Word > conj_elts_copy = conj_elts;
-  map< Word , Word >::iterator ce_it = conj_elts_copy.begin( );
+  unordered_map< Word , Word > conj_elts_copy = conj_elts;
+  unordered_map< Word , Word >::iterator ce_it = conj_elts_copy.begin( );
   for( ; ce_it!=conj_elts_copy.end( ) ; ++ce_it ) {
     Word w = (*ce_it).first;
     if( checked_elts.find(w)==checked_elts.end( ) )
@@ -213,7 +214,7 @@ int check_if_belongs( int N , const set< Word >& new_elts , const set< Word >& c
 //---------------------------------------------------------------------------//
 
 
-void add_elt( int N , set< Word >& new_elts , set< Word >& checked_elts , map< Word , Word >& conj_elts , Word w , Word conj_w , int limit , ostream& os=cout ) 
+void add_elt( int N , set< Word >& new_elts , set< Word >& checked_elts , unordered_map< Word , Word >& conj_elts , Word w , Word conj_w , int limit , ostream& os=cout ) 
 {
   Word nw = shortBraidForm( N , w );
 
@@ -238,7 +239,7 @@ void add_elt( int N , set< Word >& new_elts , set< Word >& checked_elts , map< W
 //---------------------------------------------------------------------------//
 
 
-vector< Word > precomputeShortWords( int N , set< Word >& new_elts , set< Word >& checked_elts , map< Word , Word >& conj_elts , ostream& os=cout )
+vector< Word > precomputeShortWords( int N , set< Word >& new_elts , set< Word >& checked_elts , unordered_map< Word , Word >& conj_elts , ostream& os=cout )
 {
   vector< Word > result;
 
@@ -302,7 +303,7 @@ vector< Word > precomputeShortWords( int N , set< Word >& new_elts , set< Word >
 //---------------------------------------------------------------------------//
 
 
-void locally_perturbate_elts( int N , set< Word >& new_elts , set< Word >& checked_elts , map< Word , Word >& conj_elts , ostream& os=cout )
+void locally_perturbate_elts( int N , set< Word >& new_elts , set< Word >& checked_elts , unordered_map< Word , Word >& conj_elts , ostream& os=cout )
 {
   vector< Word > result;
   
@@ -376,7 +377,7 @@ void locally_perturbate_elts( int N , set< Word >& new_elts , set< Word >& check
 //---------------------------------------------------------------------------//
 
 
-void completeShortWords( int N , set< Word >& new_elts , set< Word >& checked_elts , map< Word , Word >& conj_elts , ostream& os=cout )
+void completeShortWords( int N , set< Word >& new_elts , set< Word >& checked_elts , unordered_map< Word , Word >& conj_elts , ostream& os=cout )
 {
   typedef pair< int , Word > PIW;
   set< int > to_check;
@@ -483,7 +484,7 @@ vector< Word > simplify_braid_sbgp( int N , vector< Word > sbgp , const vector<
   set< Word > checked_elts;
 
   // here we store conjugated to the generating set
-  map< Word , Word > conj_elts;
+  unordered_map< Word , Word > conj_elts;
   // initial setup
   for( int i=0 ; i<sbgp.size( ) ; ++i ) {
     new_elts.insert( sbgp[i] );
@@ -21,7 +21,7 @@ int LengthAttack_A2::sbgpGeneratorsWeight( const vector<Word>& A )
   return result;
 }
 
-void LengthAttack_A2::addNewElt( const vector<Word>& A , set< ELT >& checkedElements , set< ELT >& uncheckedElements )
+void LengthAttack_A2::addNewElt( const vector<Word>& A , ELT_Set& checkedElements , set< ELT >& uncheckedElements )
 {
   int weight = sbgpGeneratorsWeight( A );
   ELT new_elt( weight , A );
@@ -33,7 +33,7 @@ void LengthAttack_A2::addNewElt( const vector<Word>& A , set< ELT >& checkedElem
 }
 
 
-void LengthAttack_A2::tryElt( int N , const ELT& cur , const vector< Word >& B , set< ELT >& checkedElements , set< ELT >& uncheckedElements, ostream& out )
+void LengthAttack_A2::tryElt( int N , const ELT& cur , const vector< Word >& B , ELT_Set& checkedElements , set< ELT >& uncheckedElements, ostream& out )
 {
   // we better vary this value, depending on parameters of A and B
   int MAX_DELTA = 0;
@@ -126,7 +126,7 @@ bool LengthAttack_A2::check_ifVectorsEqual( int N , const vector< Word >& A1 , c
 
 findKey_LengthBasedResult LengthAttack_A2::findKey_LengthBased( int N , const vector< Word >& A1 , const vector< Word >& A2 , const vector< Word >& B , int sec, ostream& out )
 {
-  set< ELT > checkedElements;
+  ELT_Set checkedElements;
   set< ELT > uncheckedElements;
 
   int init_time = time( 0 );
@@ -104,7 +104,7 @@ int LengthAttack_A3::sbgpGeneratorsWeight( const vector<Word>& A )
   return result;
 }
 
-void LengthAttack_A3::addNewElt( const vector<Word>& A , set< ELT >& checkedElements , set< ELT >& uncheckedElements )
+void LengthAttack_A3::addNewElt( const vector<Word>& A , ELT_Set& checkedElements , set< ELT >& uncheckedElements )
 {
   int weight = sbgpGeneratorsWeight( A );
   ELT new_elt( weight , A );
@@ -117,7 +117,7 @@ void LengthAttack_A3::addNewElt( const vector<Word>& A , set< ELT >& checkedElem
 
 
 void LengthAttack_A3::tryElt( int N , const ELT& cur , const vector< Word >& B , const vector<Word>& B_sg_gens,
-	     set< ELT >& checkedElements , set< ELT >& uncheckedElements, 
+	     ELT_Set& checkedElements , set< ELT >& uncheckedElements, 
 	     bool is_B_extended,
 	     ostream& out )
 {
@@ -247,7 +247,7 @@ bool LengthAttack_A3::check_ifVectorsEqual( int N , const vector< Word >& A1 , c
 
 findKey_LengthBasedResult LengthAttack_A3::findKey_LengthBased( int N , const vector< Word >& A1 , const vector< Word >& A2 , const vector< Word >& B , int sec, ostream& out )
 {
-  set< ELT > checkedElements;
+  ELT_Set checkedElements;
   set< ELT > uncheckedElements;
 
   int init_time = time( 0 );
@@ -155,6 +155,18 @@ public:
     return t1.WL < t2.WL && t1.WR < t2.WR;
   }
 
+  //! Tuple equality (auxiliary members are ignored)
+  friend bool operator==(const TTPTuple &t1, const TTPTuple &t2) {
+    return t1.WL == t2.WL && t1.WR == t2.WR;
+  }
+
+  //! Tuple hash consistent with operator==
+  size_t hash() const {
+    const auto l = std::hash<vector<Word>>()(WL);
+    const auto r = std::hash<vector<Word>>()(WR);
+    return l ^ (r + 0x9e3779b9 + (l << 6) + (l >> 2));
+  }
+
   void printPowers() const;
 
   //! Auxiliary member used in TTP-attack: conjugator used to get this tuple
@@ -18,6 +18,8 @@
 #include "AEProtocol.h"
 #include "ThLeftNormalForm.h"
 #include "Word.h"
+#include <set>
+#include <unordered_set>
 #include <vector>
 
 using namespace std;
@@ -25,6 +27,16 @@ using namespace std;
 class TTPTuple;
 typedef pair<int, TTPTuple> NODE;
 
+//! Hash of a node (its weight is determined by the tuple itself)
+struct NODE_Hash {
+  size_t operator()(const NODE& node) const {
+    return node.second.hash();
+  }
+};
+
+//! Set of already processed nodes
+typedef unordered_set<NODE, NODE_Hash> NODE_Set;
+
 //
 //
 //  THE LENGTH_BASED ATTACK TO REDUCE ELEMENTS AND RECOVER THE COMMON CONJUGATOR 
@@ -41,10 +53,10 @@ public:
 private:												
  
   //! Add NODE(weight,T) to checked/unchecked (if it is not in one of those sets yet).
-  void addNewElt(const TTPTuple &T, const set<NODE> &checkedElements, set<NODE> &uncheckedElements);
+  void addNewElt(const TTPTuple &T, const NODE_Set &checkedElements, set<NODE> &uncheckedElements);
   //! Conjugate cur with each generator (and inverse). Compute Weight. Add to set checked/unchecked.
-  void tryNode(int N, bool use_special_gens, const NODE& cur, const vector<Word> &gens, const set<NODE> &checkedElements, set<NODE> &uncheckedElements);
-  bool process_conjugates(int N, const NODE& cur, const vector<Word> &gens, const set<NODE> &checkedElements, set<NODE> &uncheckedElements);
+  void tryNode(int N, bool use_special_gens, const NODE& cur, const vector<Word> &gens, const NODE_Set &checkedElements, set<NODE> &uncheckedElements);
+  bool process_conjugates(int N, const NODE& cur, const vector<Word> &gens, const NODE_Set &checkedElements, set<NODE> &uncheckedElements);
 
 
   TTPTuple savTuple;
@@ -104,7 +104,7 @@ static bool fixDeltas(int n, TTPTuple &t) {
   return result;
 }
 
-void TTPLBA::addNewElt(const TTPTuple& T, const set<NODE>& checkedElements, set<NODE>& uncheckedElements) {
+void TTPLBA::addNewElt(const TTPTuple& T, const NODE_Set& checkedElements, set<NODE>& uncheckedElements) {
   NODE new_node(T.length(), T);
 
   if (checkedElements.count(new_node) != 0) {
@@ -120,7 +120,7 @@ void TTPLBA::addNewElt(const TTPTuple& T, const set<NODE>& checkedElements, set<
 
 
 bool TTPLBA::process_conjugates(int N, const NODE& cur, const vector<Word>& gens,
-                        const set<NODE>& checkedElements,
+                        const NODE_Set& checkedElements,
                         set<NODE>& uncheckedElements) {
   vector<TTPTuple> new_tuples(gens.size());
 
@@ -155,7 +155,7 @@ bool TTPLBA::process_conjugates(int N, const NODE& cur, const vector<Word>& gens
 }
 
 void TTPLBA::tryNode(int N, bool use_special_gens, const NODE& cur, const vector<Word>& gens,
-                     const set<NODE>& checkedElements,
+                     const NODE_Set& checkedElements,
                      set<NODE>& uncheckedElements) {
   // 1. Conjugate by a long terminal segments of WL[0] and WR[0].
   // This dramatically reduces weight on the first iterations of the process
@@ -258,7 +258,7 @@ bool TTPLBA::reduce(int N, const BSets &bs, const TTPTuple &theTuple,
   int init_time = time(0);
   int maxIterations = 100000;
 
-  set<NODE> checkedElements;
+  NODE_Set checkedElements;
   set<NODE> uncheckedElements;
 
   // TTPTuple initTuple(theTuple.WL, theTuple.WR, Word());
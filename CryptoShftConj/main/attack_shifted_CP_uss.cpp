@@ -73,7 +73,7 @@ NF centr_attack( int N , const NF& p1_2 , const NF& p2_2 , const NF& candidate2
   NF s2( N+2 , Word(1) );
   
   // Elements from the centralizer
-  NF c1( N+1 ,  2 , list< Permutation >( ) );
+  NF c1( N+1 ,  2 , vector< Permutation >( ) );
   c1 = c1.increaseRank( N+2 );
   NF c2 = (-delta2*p1_2*delta2) * s2 * -delta;
   Word wc3 = Word( N )*Word( N );
@@ -34,7 +34,7 @@ Word centr_attack( int N , const Word& p1 , const Word& p2 , const Word& candida
 
 
   // Elements from the centralizer
-  Word c1 = NF( N+1 ,  2 , list< Permutation >( ) ).getWord( );
+  Word c1 = NF( N+1 ,  2 , vector< Permutation >( ) ).getWord( );
   Word c2 =  generatorShift( p1 ) * Word(1) * -delta;
   Word c3 = Word( N )*Word( N );
   for( int i=N-1 ; i>=1; --i ) {
@@ -0,0 +1,57 @@
+#pragma once
+
+#ifndef CRAG_FREE_REDUCTION_H
+#define CRAG_FREE_REDUCTION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Word;
+
+namespace crag {
+namespace reduction {
+
+//! Implementations of the reduction kernels.
+enum class Kernel {
+  Scalar,
+  SSE2,
+  AVX2
+};
+
+//! The fastest kernel supported by this CPU (detected once at runtime).
+Kernel bestKernel();
+
+//! Checks if the kernel can be used on this CPU.
+bool isSupported(Kernel kernel);
+
+//! Freely reduces the word w[0, size) in place, assuming that its prefix [0, reduced) is already reduced.
+//! Returns the length of the reduced word.
+//! If untouched is not null, it receives the length of the longest prefix of w which was not modified.
+//! Vector kernels push whole blocks of letters without adjacent cancellations at once
+//! and fall back to the letter-by-letter stack pass only around cancellations.
+size_t freelyReduce(int* w, size_t reduced, size_t size, size_t* untouched = nullptr, Kernel kernel = bestKernel());
+
+//! Scalar versions for compact letter types.
+size_t freelyReduce(std::int16_t* w, size_t reduced, size_t size, size_t* untouched = nullptr, Kernel kernel = bestKernel());
+
+size_t freelyReduce(std::int8_t* w, size_t reduced, size_t size, size_t* untouched = nullptr, Kernel kernel = bestKernel());
+
+//! Returns the largest k <= size / 2 such that w_i w_{size - 1 - i} = 1 for all i < k,
+//! i.e., the length of the conjugator removed by cyclic reduction.
+size_t cyclicReductionLength(const int* w, size_t size, Kernel kernel = bestKernel());
+
+size_t cyclicReductionLength(const std::int16_t* w, size_t size, Kernel kernel = bestKernel());
+
+size_t cyclicReductionLength(const std::int8_t* w, size_t size, Kernel kernel = bestKernel());
+
+//! Freely reduces each of the words in parallel (words left unreduced by insert/replace).
+void freelyReduce(std::vector<Word>& words);
+
+//! Cyclically reduces each of the (freely reduced) words in parallel.
+void cyclicallyReduce(std::vector<Word>& words);
+
+} // namespace reduction
+} // namespace crag
+
+#endif // CRAG_FREE_REDUCTION_H
@@ -3,255 +3,180 @@
 //
 // Principal Authors: Alexander Ushakov
 //
-// Revision History:
-//
 
-#ifndef _Word_H_
-#define _Word_H_
+#ifndef CRAG_POWER_WORD_H
+#define CRAG_POWER_WORD_H
 
+#include <memory>
+#include <ostream>
+#include <vector>
 
-#include "ObjectOf.h"
-#include "PowerWord.h"
-#include "WordRep.h"
 #include "PowerWordIterator.h"
-#include <string>
-#include <strstream>
-using namespace std;
-
-
-//---------------------------------------------------------------------------//
-//-------------------------------- PowerWord --------------------------------//
-//---------------------------------------------------------------------------//
-
-
-class PowerWord : public ObjectOf< PowerWordRep >
-{
-  // friend class WordIterator;
-  
- public:
-  typedef ConstPowerWordIterator const_iterator;
-  typedef PowerWordIterator iterator;
-  
-  /////////////////////////////////////////////////////////
-  //                                                     //
-  //  Constructors                                       //
-  //                                                     //
-  /////////////////////////////////////////////////////////
-
+#include "PowerWordRep.h"
+#include "Word.h"
+
+//! Class PowerWord - a reduced word kept as a sequence of powers of generators.
+/*!
+  Words with long runs of the same letter (e.g. \f$\Delta^k\f$ or powers of generators) take space proportional
+  to the number of runs. The representation is shared between copies (with thread-safe reference counting)
+  and is copied on the first modification of a shared word.
+*/
+class PowerWord {
 public:
+  typedef std::pair<int, int> PII;
+  typedef PowerWordIterator const_iterator;
 
-  typedef pair< int , int > PII;
-
-  PowerWord( ) : ObjectOf< PowerWordRep >( new WordRep() ) { }
-  PowerWord( const vector< int >& gens ) : ObjectOf< PowerWordRep >( new PowerWordRep( gens ) ) { }
-  PowerWord( const list< int >& gens ) : ObjectOf< PowerWordRep >( new PowerWordRep( gens ) ) { }
-  PowerWord( const vector< PII >& gens ) : ObjectOf< PowerWordRep >( new PowerWordRep( gens ) ) { }
-  PowerWord( const list< PII >& gens ) : ObjectOf< PowerWordRep >( new PowerWordRep( gens ) ) { }
- 
-  PowerWord( int g , int p=1 ) : ObjectOf< PowerWordRep >( new PowerWordRep( g , p ) ) { }
-  // Cast constructor.
-  
-  // copy constructor supplied by compiler
-  // destructor supplied by compiler
-  
- 
-  /////////////////////////////////////////////////////////
-  //                                                     //
-  //  Operators                                          //
-  //                                                     //
-  /////////////////////////////////////////////////////////
-public:
+  //! Creates the empty word.
+  PowerWord()
+    : impl_ptr_(std::make_shared<PowerWordRep>()) {}
+
+  //! Creates the word x_g^p.
+  explicit PowerWord(int g, int p = 1)
+    : impl_ptr_(std::make_shared<PowerWordRep>(g, p)) {}
+
+  //! Creates a word from a sequence of letters (the result is reduced).
+  explicit PowerWord(const std::vector<int>& gens)
+    : impl_ptr_(std::make_shared<PowerWordRep>(gens)) {}
 
-  bool operator < ( const PowerWord& wr ) const {
-    return (*look() < *wr.look( ) );
+  //! Creates a word from a sequence of runs (generator, power) (the result is reduced).
+  explicit PowerWord(const std::vector<PII>& runs)
+    : impl_ptr_(std::make_shared<PowerWordRep>(runs)) {}
+
+  //! Compresses a word into runs (a single pass over the letters).
+  explicit PowerWord(const Word& w)
+    : impl_ptr_(std::make_shared<PowerWordRep>(w.begin(), w.end())) {}
+
+  //! Iteration over letters, runs are expanded lazily.
+  const_iterator begin() const {
+    return const_iterator(impl_ptr_->runs().data(), 0);
   }
-  bool operator > ( const PowerWord& wr ) const {
-    return (*look() > *wr.look( ) );
+
+  const_iterator end() const {
+    return const_iterator(impl_ptr_->runs().data() + impl_ptr_->runs().size(), 0);
   }
-  
-  bool operator == ( const PowerWord& wr ) const {
-    return (*look() == *wr.look( ) );
+
+  //! The sequence of runs (generator, power), generators are positive.
+  const std::vector<PII>& runs() const {
+    return impl_ptr_->runs();
   }
-  bool operator != ( const PowerWord& wr ) const {
-    return !(*look() == *wr.look( ) );
+
+  //! Number of letters.
+  size_t length() const {
+    return impl_ptr_->length();
   }
-  
-  inline PowerWord& operator *= ( const PowerWord& w ) { 
-    *change( ) *= *w.look(); 
-    return *this;
+
+  bool empty() const {
+    return impl_ptr_->empty();
   }
-  
-  inline PowerWord operator * ( const PowerWord& w ) const { 
-    PowerWord result( *this );
-    result *= w;
-    return result;
+
+  bool operator<(const PowerWord& other) const {
+    return *impl_ptr_ < *other.impl_ptr_;
   }
 
-  inline PowerWord operator - ( ) const { 
-    PowerWord result;
-    (*result.change( )) = look( )->inverse( );
-    return result;
+  bool operator>(const PowerWord& other) const {
+    return other < *this;
   }
 
+  bool operator==(const PowerWord& other) const {
+    return impl_ptr_ == other.impl_ptr_ || *impl_ptr_ == *other.impl_ptr_;
+  }
 
-  /////////////////////////////////////////////////////////
-  //                                                     //
-  //  Accessors                                          //
-  //                                                     //
-  /////////////////////////////////////////////////////////
-	
- public:
-  
-  const_iterator begin( ) const { return const_iterator(*this); }
-  const_iterator end  ( ) const { return const_iterator(*this,false); }
-  iterator       begin( )       { return iterator(*this); }
-  iterator       end  ( )       { return iterator(*this,false); }
-  
-  PowerWord& freelyReduce( ) { return freelyReduce( begin() , end( ) ); }
-  PowerWord& freelyReduce( const_iterator beg , const_iterator end );
-  // freely reduces a segment of a word specified by [beg,end]. 
-  // Most of the operations produce freely reduced words,
-  // except operations insert, remove. The function takes linear time to performs
-  // which is not efficient. So, either try to avoid uses of functions insert and remove
-  // or try to bound the changes in variables beg and end
-  
-  static PowerWord randomWord( int gens , int wLen );
-  // generates a pseudo random reduced word 
-  
-  inline const list< PII >& getList( ) const { return look( )->getList( ); }
-  // get a list representing the Word
-  inline list< PII >& getList( ) { return change( )->getList( ); }
-  // get a list representing the Word
-  
-  inline int length( ) const { return look( )->length( ); }
-  // the length of the Word
-
-  inline void push_back ( int gen , int power ) { change()->pushGeneratorBack ( gen , power ); }
-  inline void push_front( int gen , int power ) { change()->pushGeneratorFront( gen , power ); }
-  inline void push_back ( const pair< int , int >& g ) { change()->pushGeneratorBack ( g.first , g.second ); }
-  inline void push_front( const pair< int , int >& g ) { change()->pushGeneratorFront( g.first , g.second ); }
-
-  int getPower( PowerWord& base ) const { return look( )->getPower( *base.change( ) ); }
-  // determines the power of the Word 
-  // (not as an element of the corresponding Free Group)
-
-  bool doesContain( const int& gen ) const {
-    return look( )->doesContain( gen );
+  bool operator!=(const PowerWord& other) const {
+    return !(*this == other);
   }
-  // Checks if the Word contains a generator
 
-  inline void cyclicLeftShift( )  { change( )->cyclicLeftShift(  ); }
-  // Shifts the word one position to the left
-  inline void cyclicRightShift( ) { change( )->cyclicRightShift( ); }
-  // Shifts the word one position to the right
+  //! Multiply the word on the right by another word (takes time linear in the number of runs of other).
+  PowerWord& operator*=(const PowerWord& other) {
+    clone_();
+    *impl_ptr_ *= *other.impl_ptr_;
+    return *this;
+  }
 
-  inline PowerWord cyclicallyReduce( ) const {
-    Word result( *this );
-    result.change( ) -> cyclicallyReduce( );
+  PowerWord operator*(const PowerWord& other) const & {
+    PowerWord result(*this);
+    result *= other;
     return result;
   }
-  // Returns the cyclically reduced Word
-  
-  inline void cyclicallyReduceWord( ) { change( ) -> cyclicallyReduce( ); }
-  // Cyclically reduces the Word
-
-  inline PowerWord cyclicallyReduce( PowerWord& conjugator ) const {
-    PowerWord result( *this );
-    result.change( ) -> cyclicallyReduce( *conjugator.change( ) );
-    return result;
+
+  PowerWord operator*(const PowerWord& other) && {
+    *this *= other;
+    return std::move(*this);
   }
-  inline void cyclicallyReduceWord( PowerWord& conjugator ) { 
-    change( ) -> cyclicallyReduce( *conjugator.change( ) ); 
+
+  //! Returns the inverse word.
+  PowerWord inverse() const {
+    return PowerWord(impl_ptr_->inverse());
   }
-  
-  inline PowerWord inverse( ) const {
-    PowerWord result;
-    (*result.change( )) = look( )->inverse( );
-    return result;
+
+  PowerWord operator-() const {
+    return inverse();
   }
-  
-  inline PowerWord cyclicallyPermute( int n ) const {
-    Word result( *this );
-    result.change( ) -> cyclicallyPermute( n );
-    return result;
+
+  //! Returns w^t.
+  PowerWord power(int t) const;
+
+  //! Multiplies the word on the right by x_g^p.
+  void push_back(int g, int p = 1) {
+    clone_();
+    impl_ptr_->pushBack(g, p);
   }
-  // n>0 => left-shift permute
-  // n<0 => rigth-shift permute
-  
-  inline PowerWord initialSegment( int len ) const {
-    PowerWord result( *this );
-    result.change( ) -> initialSegment( len );
-    return result;		
+
+  //! Multiplies the word on the left by x_g^p.
+  void push_front(int g, int p = 1) {
+    clone_();
+    impl_ptr_->pushFront(g, p);
   }
-  
-  inline PowerWord terminalSegment( int len ) const {
-    PowerWord result( *this );
-    result.change( ) -> terminalSegment( len );
-    return result;			
+
+  //! Returns the cyclically reduced word.
+  PowerWord cyclicallyReduce() const {
+    PowerWord conjugator;
+    return cyclicallyReduce(conjugator);
   }
-  
-  inline PowerWord segment( int from , int to ) const {
-    Word result( *this );
-    result.change( ) -> segment( from , to );
-    return result;	
+
+  //! Returns the cyclically reduced word u such that w = c^{-1} u c, where c is the conjugator.
+  PowerWord cyclicallyReduce(PowerWord& conjugator) const {
+    PowerWordRep result = *impl_ptr_;
+    conjugator = PowerWord(result.cyclicallyReduce());
+    return PowerWord(std::move(result));
   }
-  
-  inline int exponentSum( const int& gen ) const {
-    return look( )->exponentSum( gen );
+
+  //! Sum of the powers of x_g.
+  int exponentSum(int g) const {
+    return impl_ptr_->exponentSum(g);
   }
-  
-  int isIn( const int& gen ) const {
-    return look( )->isIn( gen );
+
+  //! Checks if x_g occurs in the word.
+  bool doesContain(int g) const {
+    return impl_ptr_->contains(g);
   }
-  
-  Word power( int t ) const;
 
-  void insert( const PowerWord& wr , int pos ) {
-    change( ) -> insert( *wr.look( ) , pos );
+  std::vector<int> toVector() const {
+    return impl_ptr_->toVector();
   }
 
-  /////////////////////////////////////////////////////////
-  //                                                     //
-  //  Internal functions                                 //
-  //                                                     //
-  /////////////////////////////////////////////////////////
+  //! Expands the word.
+  Word toWord() const {
+    return Word(toVector());
+  }
 
- private:
+  friend std::ostream& operator<<(std::ostream& out, const PowerWord& w) {
+    return out << *w.impl_ptr_;
+  }
 
-	 
-  /////////////////////////////////////////////////////////
-  //                                                     //
-  //  I/O                                                //
-  //                                                     //
-  /////////////////////////////////////////////////////////
+private:
+  explicit PowerWord(PowerWordRep w)
+    : impl_ptr_(std::make_shared<PowerWordRep>(std::move(w))) {}
 
-  
-  friend ostream& operator << ( ostream& os , const PowerWord& w ) {
-    return w.look( )->printOn( os );
-  }
-  
-  ostream& printOn ( ostream& os ) const {
-    return look( )->printOn( os );
-  }
-  
-  /*
-    friend ostream& operator << ( ostream& os , const Word& w ) {
-    os << *w.look( );
-    return os;
+  //! Makes the representation unique before a modification.
+  void clone_() {
+    if (impl_ptr_.use_count() == 1) {
+      return;
     }
-  */
-  
-
 
-  /////////////////////////////////////////////////////////
-  //                                                     //
-  //  Data members                                       //
-  //                                                     //
-  /////////////////////////////////////////////////////////
+    impl_ptr_ = std::make_shared<PowerWordRep>(*impl_ptr_);
+  }
 
-  private:
-		
+  std::shared_ptr<PowerWordRep> impl_ptr_;
 };
 
-
-#endif
+#endif // CRAG_POWER_WORD_H
@@ -3,138 +3,80 @@
 //
 // Principal Authors: Alexander Ushakov
 //
-// Revision History:
-//
-
-#ifndef _WordIterator_H_
-#define _WordIterator_H_
-
-
-#include "list"
-using namespace std;
-
-class Word;
-
-//---------------------------------------------------------------------------//
-//------------------------------- WordIterator ------------------------------//
-//---------------------------------------------------------------------------//
-
-
-class WordIterator
-{
-	friend class ConstWordIterator;
-
-public:
-	typedef pair< int , int > PII;
-
-  /////////////////////////////////////////////////////////
-  //                                                     //
-  //  Constructors                                       //
-  //                                                     //
-  /////////////////////////////////////////////////////////
-public:
-	WordIterator( );
-	WordIterator( Word& w , bool begin=true );
-
-  /////////////////////////////////////////////////////////
-  //                                                     //
-  //  Operators                                          //
-  //                                                     //
-  /////////////////////////////////////////////////////////
-public:
-	bool operator!= ( const WordIterator& WI ) const;
-	bool operator== ( const WordIterator& WI ) const;
-
-	const WordIterator& operator++ ( );
-	      WordIterator  operator++ ( int doomy );
-	const WordIterator& operator-- ( );
-	      WordIterator  operator-- ( int doomy );
-	PII  operator*  ( ) const;
-
-  /////////////////////////////////////////////////////////
-  //                                                     //
-  //  Accessors:                                         //
-  //                                                     //
-  /////////////////////////////////////////////////////////
-
-public:
-
-  /////////////////////////////////////////////////////////
-  //                                                     //
-  //  Data members                                       //
-  //                                                     //
-  /////////////////////////////////////////////////////////
-private:
 
-	Word* theWord;
-  list< PII >::iterator theIterator;
-	int theOffset;
+#ifndef CRAG_POWER_WORD_ITERATOR_H
+#define CRAG_POWER_WORD_ITERATOR_H
 
-};
-
-
-//---------------------------------------------------------------------------//
-//----------------------------- ConstWordIterator ---------------------------//
-//---------------------------------------------------------------------------//
-
-
-class ConstWordIterator
-{
-	frient class Word;
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <utility>
 
+//! Bidirectional iterator over the letters of a word given by runs (generator, power).
+//! Letters are produced on the fly, x_g^p yields |p| letters g (or -g if p < 0).
+class PowerWordIterator {
 public:
-	typedef pair< int , int > PII;
-
-  /////////////////////////////////////////////////////////
-  //                                                     //
-  //  Constructors                                       //
-  //                                                     //
-  /////////////////////////////////////////////////////////
-public:
-	ConstWordIterator( );
-	ConstWordIterator( const Word& w , bool begin=true );
-	ConstWordIterator( const WordIterator& WI );
-
-  /////////////////////////////////////////////////////////
-  //                                                     //
-  //  Operators                                          //
-  //                                                     //
-  /////////////////////////////////////////////////////////
-public:
-	ConstWordIterator& operator= ( const WordIterator& WI );
-
-	bool operator!= ( const ConstWordIterator& WI ) const;
-	bool operator== ( const ConstWordIterator& WI ) const;
-
-	const ConstWordIterator& operator++ ( );
-	      ConstWordIterator  operator++ ( int doomy );
-	const ConstWordIterator& operator-- ( );
-	      ConstWordIterator  operator-- ( int doomy );
-	PII  operator*  ( ) const;
+  typedef std::pair<int, int> PII;
+
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = int;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const int*;
+  using reference = int;
+
+  PowerWordIterator()
+    : run_(nullptr), offset_(0) {}
+
+  //! Points to the letter offset of the run.
+  PowerWordIterator(const PII* run, int offset)
+    : run_(run), offset_(offset) {}
+
+  int operator*() const {
+    return run_->second > 0 ? run_->first : -run_->first;
+  }
+
+  PowerWordIterator& operator++() {
+    if (++offset_ == std::abs(run_->second)) {
+      ++run_;
+      offset_ = 0;
+    }
+
+    return *this;
+  }
+
+  PowerWordIterator operator++(int) {
+    auto copy = *this;
+    ++*this;
+    return copy;
+  }
+
+  PowerWordIterator& operator--() {
+    if (offset_ == 0) {
+      --run_;
+      offset_ = std::abs(run_->second);
+    }
+
+    --offset_;
+    return *this;
+  }
+
+  PowerWordIterator operator--(int) {
+    auto copy = *this;
+    --*this;
+    return copy;
+  }
+
+  bool operator==(const PowerWordIterator& other) const {
+    return run_ == other.run_ && offset_ == other.offset_;
+  }
+
+  bool operator!=(const PowerWordIterator& other) const {
+    return !(*this == other);
+  }
 
-  /////////////////////////////////////////////////////////
-  //                                                     //
-  //  Accessors:                                         //
-  //                                                     //
-  /////////////////////////////////////////////////////////
-
-public:
-
-
-  /////////////////////////////////////////////////////////
-  //                                                     //
-  //  Data members                                       //
-  //                                                     //
-  /////////////////////////////////////////////////////////
 private:
-
-	const Word* theWord;
-  list< PII >::const_iterator theIterator;
-	int theOffset;
-
+  const PII* run_;
+  int offset_;
 };
 
-
-#endif
-
-
+#endif // CRAG_POWER_WORD_ITERATOR_H
@@ -3,179 +3,105 @@
 //
 // Principal Authors: Alexander Ushakov
 //
-// Revision History:
-//
-
-#ifndef _PowerWordRep_H_
-#define _PowerWordRep_H_
-
-
-
-#include "RefCounter.h"
-
-#include "vector"
-#include "list"
-#include "iostream"
-using namespace std;
-
-
-
-//---------------------------------------------------------------------------//
-//------------------------------ PowerWordRep -------------------------------//
-//---------------------------------------------------------------------------//
 
+#ifndef CRAG_POWER_WORD_REP_H
+#define CRAG_POWER_WORD_REP_H
+
+#include <cstddef>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//! Represents a group word as a sequence of runs \f$x_{g_1}^{p_1} \ldots x_{g_k}^{p_k}\f$.
+/*!
+  Runs are kept in a vector of pairs (generator, power) with generator > 0 and power != 0.
+  Adjacent runs always have different generators, so the word is freely reduced,
+  and operations on runs (multiplication, inversion, cyclic reduction) take time linear in the number of runs.
+*/
+class PowerWordRep {
+public:
+  typedef std::pair<int, int> PII;
 
-class PowerWordRep : public RefCounter
-{
-  friend class PowerWord;
-  typedef pair< int , int > PII;
+  //! Creates the empty word.
+  PowerWordRep() {}
 
-  /////////////////////////////////////////////////////////
-  //                                                     //
-  //  Constructors                                       //
-  //                                                     //
-  /////////////////////////////////////////////////////////
+  //! Creates the word x_g^p (g may be negative, which stands for the inverse generator).
+  explicit PowerWordRep(int g, int p = 1);
 
-private:
+  //! Creates a word from a sequence of letters (the result is reduced).
+  explicit PowerWordRep(const std::vector<int>& gens);
 
-  PowerWordRep( );
-  PowerWordRep( const list< PII >& gens );
-  PowerWordRep( const vector< PII >& gens );
-  PowerWordRep( const PowerWordRep& wr );
+  //! Creates a word from a sequence of runs (the result is reduced).
+  explicit PowerWordRep(const std::vector<PII>& runs);
 
-  PowerWordRep( const list< int >& gens );
-  PowerWordRep( const vector< int >& gens );
-  // special constructors, here we assume that -x is the inverse of x
+  //! Creates a word from a sequence of letters [begin, end) (the result is reduced).
+  template<class InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+  PowerWordRep(InputIterator begin, InputIterator end) {
+    for (auto it = begin; it != end; ++it) {
+      pushBack(*it, 1);
+    }
+  }
 
-  PowerWordRep( int g , int p = 1 );
+  //! The sequence of runs (generator, power).
+  const std::vector<PII>& runs() const {
+    return runs_;
+  }
 
-  PowerWordRep operator=( const PowerWordRep wr );
+  //! Number of letters.
+  size_t length() const {
+    return length_;
+  }
 
-public:
+  bool empty() const {
+    return runs_.empty();
+  }
 
+  //! Multiplies the word on the right by x_g^p. Takes O(1) time.
+  void pushBack(int g, int p);
 
-  /////////////////////////////////////////////////////////
-  //                                                     //
-  //  Operators                                          //
-  //                                                     //
-  /////////////////////////////////////////////////////////
-private:
+  //! Multiplies the word on the left by x_g^p. Takes time linear in the number of runs.
+  void pushFront(int g, int p);
 
-  PowerWordRep& operator *= ( const PowerWordRep& w );
-  bool     operator <  ( const PowerWordRep& wr ) const;
-  bool     operator >  ( const PowerWordRep& wr ) const;
-  bool     operator == ( const PowerWordRep& wr ) const;
+  PowerWordRep& operator*=(const PowerWordRep& other);
 
-  inline PowerWordRep  operator * ( const PowerWordRep& w ) const {
-    PowerWordRep result( *this );
-    result *= w;
+  PowerWordRep operator*(const PowerWordRep& other) const {
+    PowerWordRep result(*this);
+    result *= other;
     return result;
   }
-	
-  /////////////////////////////////////////////////////////
-  //                                                     //
-  //  Accessors:                                         //
-  //                                                     //
-  /////////////////////////////////////////////////////////
-
-public:
-
-  PowerWordRep* clone( ) const { return new PowerWordRep( *this ); }
-
-  const list< PII >& getList( ) const { return theElements; }
-  list< PII >& getList( ) { return theElements; }
 
-	
-private:
-
-  bool doesContain( int gen ) const;
-
-  inline int length( ) const { return theLength; }
-
-  int exponentSum( int gen ) const;
-  int isIn( int gen ) const;
-
-  int getPower( PowerWordRep& base ) const;
-
-
-  ////////////////////////////////////////////
-  //                                        //
-  //  Manipulators                          //
-  //                                        //
-  ////////////////////////////////////////////
-	
-private:
-
-  PowerWordRep inverse( ) const;
-
-  void cyclicallyReduce( );
-  void cyclicallyReduce( PowerWordRep& conjugator );
-
-  void cyclicLeftShift( );
-  // the leftmost symbol goes to the rightmost position
-  void cyclicRightShift( );
-  // the rightmost symbol goes to the leftmost position
+  PowerWordRep inverse() const;
 
-  void cyclicallyPermute( int n );
-  // n>0 => left-shift permute
-  // n<0 => rigth-shift permute
+  //! Cyclically reduces the word, so that it is the conjugate c^{-1} w c of the result.
+  //! Returns the conjugator c.
+  PowerWordRep cyclicallyReduce();
 
-  void segment( int from , int to );
-  // cut [from, to) part of the word
-  // whole word is [0,length) part of itself
-  void  initialSegment( int to   );
-  void terminalSegment( int from );
+  //! Sum of the powers of x_g in the word.
+  int exponentSum(int g) const;
 
-  void insert( const PowerWordRep& wr , int pos );
+  //! Checks if x_g occurs in the word.
+  bool contains(int g) const;
 
+  //! Returns the sequence of letters.
+  std::vector<int> toVector() const;
 
-  /////////////////////////////////////////////////////////
-  //                                                     //
-  //  I/O:                                               //
-  //                                                     //
-  /////////////////////////////////////////////////////////
-
-public:
-
-  // friend ostream& operator << ( ostream& os , const PowerWordRep& wr ) {
-  ostream& printOn( ostream& os ) const {
-    list< PII >::const_iterator w_it = theElements.begin( );
-    for( ; w_it!=theElements.end( ) ; ++w_it ) {
-			int g = (*w_it).first;
-			int p = (*w_it).second;
-      if( w_it!=theElements.begin( ) ) os << " ";
-      os << 'x' << g;
-			if( p!=1 ) os << '^' << p;
-    }
-    return os;
+  bool operator==(const PowerWordRep& other) const {
+    return runs_ == other.runs_;
   }
 
+  bool operator!=(const PowerWordRep& other) const {
+    return runs_ != other.runs_;
+  }
 
-  /////////////////////////////////////////////////////////
-  //                                                     //
-  //  Internal functions:                                //
-  //                                                     //
-  /////////////////////////////////////////////////////////
-
-private:
-
-	void pushGeneratorBack( int g , int p );
-	void pushGeneratorFront( int g , int p );
-
-  /////////////////////////////////////////////////////////
-  //                                                     //
-  //  Data members                                       //
-  //                                                     //
-  /////////////////////////////////////////////////////////
+  //! Compares words by length first, then lexicographically by runs.
+  bool operator<(const PowerWordRep& other) const;
 
 private:
-
-  list< PII > theElements;
-	// list of pairs (gen#,power)
-
-	int theLength;
-	// the total length of the word (the total sum of power)
+  std::vector<PII> runs_;
+  size_t length_ = 0;
 };
 
+std::ostream& operator<<(std::ostream& out, const PowerWordRep& w);
 
-#endif
+#endif // CRAG_POWER_WORD_REP_H
@@ -0,0 +1,436 @@
+#pragma once
+
+#ifndef CRAG_SMALL_LETTER_VECTOR_H
+#define CRAG_SMALL_LETTER_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace crag {
+
+//! Random access iterator over letters stored in a narrow integer type.
+//! Reference is either Letter& (mutable iteration) or int (read-only iteration, letters are widened on access).
+template<typename Letter, typename Reference>
+class LetterIterator {
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = int;
+  using difference_type = std::ptrdiff_t;
+  using pointer = Letter*;
+  using reference = Reference;
+
+  LetterIterator()
+    : ptr_(nullptr) {}
+
+  explicit LetterIterator(Letter* ptr)
+    : ptr_(ptr) {}
+
+  //! Mutable iterators convert to read-only ones.
+  template<typename OtherLetter, typename OtherReference,
+    typename = typename std::enable_if<std::is_convertible<OtherLetter*, Letter*>::value>::type>
+  LetterIterator(const LetterIterator<OtherLetter, OtherReference>& other)
+    : ptr_(other.base()) {}
+
+  Letter* base() const {
+    return ptr_;
+  }
+
+  reference operator*() const {
+    return *ptr_;
+  }
+
+  reference operator[](difference_type n) const {
+    return ptr_[n];
+  }
+
+  LetterIterator& operator++() {
+    ++ptr_;
+    return *this;
+  }
+
+  LetterIterator operator++(int) {
+    auto copy = *this;
+    ++ptr_;
+    return copy;
+  }
+
+  LetterIterator& operator--() {
+    --ptr_;
+    return *this;
+  }
+
+  LetterIterator operator--(int) {
+    auto copy = *this;
+    --ptr_;
+    return copy;
+  }
+
+  LetterIterator& operator+=(difference_type n) {
+    ptr_ += n;
+    return *this;
+  }
+
+  LetterIterator& operator-=(difference_type n) {
+    ptr_ -= n;
+    return *this;
+  }
+
+  friend LetterIterator operator+(LetterIterator it, difference_type n) {
+    return it += n;
+  }
+
+  friend LetterIterator operator+(difference_type n, LetterIterator it) {
+    return it += n;
+  }
+
+  friend LetterIterator operator-(LetterIterator it, difference_type n) {
+    return it -= n;
+  }
+
+  friend difference_type operator-(const LetterIterator& a, const LetterIterator& b) {
+    return a.ptr_ - b.ptr_;
+  }
+
+  friend bool operator==(const LetterIterator& a, const LetterIterator& b) {
+    return a.ptr_ == b.ptr_;
+  }
+
+  friend bool operator!=(const LetterIterator& a, const LetterIterator& b) {
+    return a.ptr_ != b.ptr_;
+  }
+
+  friend bool operator<(const LetterIterator& a, const LetterIterator& b) {
+    return a.ptr_ < b.ptr_;
+  }
+
+  friend bool operator>(const LetterIterator& a, const LetterIterator& b) {
+    return a.ptr_ > b.ptr_;
+  }
+
+  friend bool operator<=(const LetterIterator& a, const LetterIterator& b) {
+    return a.ptr_ <= b.ptr_;
+  }
+
+  friend bool operator>=(const LetterIterator& a, const LetterIterator& b) {
+    return a.ptr_ >= b.ptr_;
+  }
+
+private:
+  Letter* ptr_;
+};
+
+//! Sequence of group letters stored as narrow signed integers (e.g. int8_t for braid groups B_n with n <= 127).
+//! Up to InlineCapacity letters are kept inside the object itself, longer words go to the heap.
+//! Interface mirrors the subset of std::vector<int> used by WordRep, read-only iteration yields int.
+template<typename Letter, size_t InlineCapacity>
+class SmallLetterVector {
+  static_assert(std::is_integral<Letter>::value && std::is_signed<Letter>::value, "Letter must be a signed integer.");
+  static_assert(InlineCapacity > 0, "Inline capacity must be positive.");
+
+public:
+  using value_type = Letter;
+  using size_type = size_t;
+  using iterator = LetterIterator<Letter, Letter&>;
+  using const_iterator = LetterIterator<const Letter, int>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  //! Checks if a letter can be stored.
+  static constexpr bool fits(int g) {
+    return g >= std::numeric_limits<Letter>::min() && g <= std::numeric_limits<Letter>::max();
+  }
+
+  SmallLetterVector()
+    : data_(inline_), size_(0), capacity_(InlineCapacity) {}
+
+  SmallLetterVector(std::initializer_list<int> letters)
+    : SmallLetterVector(letters.begin(), letters.end()) {}
+
+  explicit SmallLetterVector(const std::vector<int>& letters)
+    : SmallLetterVector(letters.begin(), letters.end()) {}
+
+  template<typename InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+  SmallLetterVector(InputIterator first, InputIterator last)
+    : SmallLetterVector() {
+    insert(end(), first, last);
+  }
+
+  SmallLetterVector(const SmallLetterVector& other)
+    : SmallLetterVector() {
+    reserve(other.size_);
+    copy_(data_, other.data_, other.size_);
+    size_ = other.size_;
+  }
+
+  SmallLetterVector(SmallLetterVector&& other) noexcept
+    : SmallLetterVector() {
+    steal_(other);
+  }
+
+  SmallLetterVector& operator=(const SmallLetterVector& other) {
+    if (this != &other) {
+      size_ = 0;
+      reserve(other.size_);
+      copy_(data_, other.data_, other.size_);
+      size_ = other.size_;
+    }
+
+    return *this;
+  }
+
+  SmallLetterVector& operator=(SmallLetterVector&& other) noexcept {
+    if (this != &other) {
+      release_();
+      steal_(other);
+    }
+
+    return *this;
+  }
+
+  ~SmallLetterVector() {
+    release_();
+  }
+
+  iterator begin() {
+    return iterator(data_);
+  }
+
+  const_iterator begin() const {
+    return const_iterator(data_);
+  }
+
+  iterator end() {
+    return iterator(data_ + size_);
+  }
+
+  const_iterator end() const {
+    return const_iterator(data_ + size_);
+  }
+
+  const_iterator cbegin() const {
+    return begin();
+  }
+
+  const_iterator cend() const {
+    return end();
+  }
+
+  reverse_iterator rbegin() {
+    return reverse_iterator(end());
+  }
+
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+
+  reverse_iterator rend() {
+    return reverse_iterator(begin());
+  }
+
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  int front() const {
+    return data_[0];
+  }
+
+  Letter& front() {
+    return data_[0];
+  }
+
+  int back() const {
+    return data_[size_ - 1];
+  }
+
+  Letter& back() {
+    return data_[size_ - 1];
+  }
+
+  Letter* data() {
+    return data_;
+  }
+
+  const Letter* data() const {
+    return data_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  size_t capacity() const {
+    return capacity_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  //! Checks if the letters are kept in the inline buffer.
+  bool isInline() const {
+    return data_ == inline_;
+  }
+
+  void reserve(size_t capacity) {
+    if (capacity <= capacity_) {
+      return;
+    }
+
+    auto data = new Letter[capacity];
+    copy_(data, data_, size_);
+
+    release_();
+
+    data_ = data;
+    capacity_ = capacity;
+  }
+
+  void clear() {
+    size_ = 0;
+  }
+
+  void push_back(int g) {
+    grow_(size_ + 1);
+    data_[size_++] = narrow_(g);
+  }
+
+  void pop_back() {
+    --size_;
+  }
+
+  void resize(size_t size) {
+    grow_(size);
+
+    if (size > size_) {
+      std::fill(data_ + size_, data_ + size, Letter(0));
+    }
+
+    size_ = size;
+  }
+
+  iterator insert(const_iterator position, int g) {
+    const auto offset = position - cbegin();
+    const auto value = narrow_(g);
+
+    grow_(size_ + 1);
+    std::memmove(data_ + offset + 1, data_ + offset, (size_ - offset) * sizeof(Letter));
+    data_[offset] = value;
+    ++size_;
+
+    return begin() + offset;
+  }
+
+  template<typename ForwardIterator>
+  iterator insert(const_iterator position, ForwardIterator first, ForwardIterator last) {
+    const auto offset = position - cbegin();
+    const auto count = static_cast<size_t>(std::distance(first, last));
+
+    if (count == 0) {
+      return begin() + offset;
+    }
+
+    grow_(size_ + count);
+
+    // append the new letters and rotate them into place
+    auto dst = data_ + size_;
+    for (auto it = first; it != last; ++it) {
+      *dst++ = narrow_(*it);
+    }
+
+    std::rotate(data_ + offset, data_ + size_, data_ + size_ + count);
+    size_ += count;
+
+    return begin() + offset;
+  }
+
+  iterator erase(const_iterator position) {
+    return erase(position, position + 1);
+  }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    const auto from = first - cbegin();
+    const auto to = last - cbegin();
+
+    std::memmove(data_ + from, data_ + to, (size_ - to) * sizeof(Letter));
+    size_ -= to - from;
+
+    return begin() + from;
+  }
+
+  void swap(SmallLetterVector& other) noexcept {
+    SmallLetterVector tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+
+  bool operator==(const SmallLetterVector& other) const {
+    return size_ == other.size_ && std::equal(data_, data_ + size_, other.data_);
+  }
+
+  bool operator!=(const SmallLetterVector& other) const {
+    return !(*this == other);
+  }
+
+private:
+  static Letter narrow_(int g) {
+    if (!fits(g)) {
+      throw std::invalid_argument("Letter does not fit into the compact word storage.");
+    }
+
+    return static_cast<Letter>(g);
+  }
+
+  static void copy_(Letter* dst, const Letter* src, size_t count) {
+    if (count > 0) {
+      std::memcpy(dst, src, count * sizeof(Letter));
+    }
+  }
+
+  void grow_(size_t size) {
+    if (size > capacity_) {
+      reserve(std::max(size, 2 * capacity_));
+    }
+  }
+
+  void release_() {
+    if (!isInline()) {
+      delete[] data_;
+    }
+
+    data_ = inline_;
+    capacity_ = InlineCapacity;
+  }
+
+  //! Takes over the letters of other, which is left empty. This object must be inline and empty.
+  void steal_(SmallLetterVector& other) {
+    if (other.isInline()) {
+      copy_(inline_, other.inline_, other.size_);
+    } else {
+      data_ = other.data_;
+      capacity_ = other.capacity_;
+
+      other.data_ = other.inline_;
+      other.capacity_ = InlineCapacity;
+    }
+
+    size_ = other.size_;
+    other.size_ = 0;
+  }
+
+  Letter* data_;
+  size_t size_;
+  size_t capacity_;
+  Letter inline_[InlineCapacity];
+};
+
+} // namespace crag
+
+#endif // CRAG_SMALL_LETTER_VECTOR_H
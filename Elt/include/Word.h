@@ -7,6 +7,7 @@
 #ifndef CRAG_WORD_H
 #define CRAG_WORD_H
 
+#include <functional>
 #include <string>
 #include <set>
 #include <map>
@@ -78,6 +79,11 @@ public:
     return !(*this == other);
   }
 
+  //! Hash of the word (cached, so it takes O(1) time).
+  size_t hash() const {
+    return impl_ptr_->hash();
+  }
+
   //! Multiply the word on the right by another word (the result is reduced)
   Word& operator*=(const Word& other) {
     clone_();
@@ -87,12 +93,18 @@ public:
   }
 
   //! Multiply two words (the result is reduced)
-  Word operator*(const Word& other) const {
+  Word operator*(const Word& other) const & {
     Word result(*this);
     result *= other;
     return result;
   }
 
+  //! Multiply two words reusing the storage of this temporary (the result is reduced)
+  Word operator*(const Word& other) && {
+    *this *= other;
+    return std::move(*this);
+  }
+
   //! Conjugate a word by another word (the result is reduced)
   Word& operator^=(const Word& conjugator) {
     clone_();
@@ -101,12 +113,17 @@ public:
     return *this;
   }
 
-  Word operator^(const Word& conjugator) const {
+  Word operator^(const Word& conjugator) const & {
     Word result(*this);
     result ^= conjugator;
     return result;
   }
 
+  Word operator^(const Word& conjugator) && {
+    *this ^= conjugator;
+    return std::move(*this);
+  }
+
   //! Conjugate a word by another word (the result is reduced)
   Word& operator^=(int power) {
     clone_();
@@ -115,18 +132,30 @@ public:
     return *this;
   }
 
-  Word operator^(int power) const {
+  Word operator^(int power) const & {
     Word result(*this);
     result ^= power;
     return result;
   }
 
+  Word operator^(int power) && {
+    *this ^= power;
+    return std::move(*this);
+  }
+
   //! Invert a word (works the same as inverse).
-  Word operator-() const {
+  Word operator-() const & {
     WordRep inverse = impl_ptr_->inverse();
     return Word(std::move(inverse));
   }
 
+  //! Invert a temporary word in place.
+  Word operator-() && {
+    clone_();
+    impl_ptr_->invert();
+    return std::move(*this);
+  }
+
   const_iterator begin() const {
     return impl_ptr_->begin();
   }
@@ -174,9 +203,16 @@ public:
     return impl_ptr_->toList();
   }
 
+#ifndef CRAG_COMPACT_WORDS
   const std::vector<int>& toVector() const {
     return impl_ptr_->toVector();
   }
+#else
+  //! The compact layout has no std::vector<int> to refer to, so the letters are copied.
+  std::vector<int> toVector() const {
+    return impl_ptr_->toVector();
+  }
+#endif
 
     //! Get the length of the word.
   inline size_t length() const {
@@ -405,8 +441,13 @@ private:
   }
 
 private:
-  //! Clones the underlying word rep.
+  //! Clones the underlying word rep unless this word is its only owner (copy-on-write).
+  //! Must be called before any modification of *impl_ptr_.
   void clone_() {
+    if (impl_ptr_.use_count() == 1) {
+      return;
+    }
+
     WordRep copy = *impl_ptr_;
     impl_ptr_ = std::make_shared<WordRep>(std::move(copy));
   }
@@ -422,4 +463,27 @@ Word abelianization(const Word& w);
 //! m[i] is the number of occurrences of x_{i}^{+/- 1} in w.
 std::map<size_t, size_t> occurrences(const Word& w);
 
+namespace std {
+
+template<>
+struct hash<Word> {
+  size_t operator()(const Word& w) const {
+    return w.hash();
+  }
+};
+
+template<>
+struct hash<std::vector<Word>> {
+  size_t operator()(const std::vector<Word>& words) const {
+    size_t result = words.size();
+
+    for (const auto& w : words) {
+      result ^= w.hash() + 0x9e3779b9 + (result << 6) + (result >> 2);
+    }
+
+    return result;
+  }
+};
+} // namespace std
+
 #endif // CRAG_WORD_H
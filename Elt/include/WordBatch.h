@@ -0,0 +1,225 @@
+#pragma once
+
+#ifndef CRAG_WORD_BATCH_H
+#define CRAG_WORD_BATCH_H
+
+#include <iterator>
+#include <vector>
+
+#include "Word.h"
+
+namespace crag {
+
+//! Read-only view of a word stored in a WordBatch (the letters [begin, end)).
+class WordView {
+public:
+  WordView(const int* begin, const int* end)
+    : begin_(begin), end_(end) {}
+
+  const int* begin() const {
+    return begin_;
+  }
+
+  const int* end() const {
+    return end_;
+  }
+
+  size_t length() const {
+    return end_ - begin_;
+  }
+
+  size_t size() const {
+    return end_ - begin_;
+  }
+
+  bool empty() const {
+    return begin_ == end_;
+  }
+
+  int operator[](size_t i) const {
+    return begin_[i];
+  }
+
+  //! Same value as toWord().hash().
+  size_t hash() const {
+    return WordRep::hash(begin_, end_);
+  }
+
+  Word toWord() const {
+    return Word(begin_, end_);
+  }
+
+  bool operator==(const WordView& other) const;
+
+  bool operator!=(const WordView& other) const {
+    return !(*this == other);
+  }
+
+private:
+  const int* begin_;
+  const int* end_;
+};
+
+//! Read-only view of a tuple of words stored in a WordBatch.
+class WordTuple {
+public:
+  class const_iterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = WordView;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = WordView;
+
+    const_iterator(const int* letters, const size_t* offset)
+      : letters_(letters), offset_(offset) {}
+
+    WordView operator*() const {
+      return WordView(letters_ + offset_[0], letters_ + offset_[1]);
+    }
+
+    const_iterator& operator++() {
+      ++offset_;
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      auto copy = *this;
+      ++offset_;
+      return copy;
+    }
+
+    bool operator==(const const_iterator& other) const {
+      return offset_ == other.offset_;
+    }
+
+    bool operator!=(const const_iterator& other) const {
+      return offset_ != other.offset_;
+    }
+
+  private:
+    const int* letters_;
+    const size_t* offset_;
+  };
+
+  WordTuple(const int* letters, const size_t* offsets, size_t size)
+    : letters_(letters), offsets_(offsets), size_(size) {}
+
+  //! Number of words in the tuple.
+  size_t size() const {
+    return size_;
+  }
+
+  WordView operator[](size_t i) const {
+    return WordView(letters_ + offsets_[i], letters_ + offsets_[i + 1]);
+  }
+
+  const_iterator begin() const {
+    return const_iterator(letters_, offsets_);
+  }
+
+  const_iterator end() const {
+    return const_iterator(letters_, offsets_ + size_);
+  }
+
+  //! Sum of the lengths of the words.
+  size_t totalLength() const {
+    return offsets_[size_] - offsets_[0];
+  }
+
+  //! Same value as std::hash<std::vector<Word>>()(toVector()).
+  size_t hash() const;
+
+  std::vector<Word> toVector() const;
+
+  bool operator==(const WordTuple& other) const;
+
+  bool operator!=(const WordTuple& other) const {
+    return !(*this == other);
+  }
+
+private:
+  const int* letters_;
+  const size_t* offsets_;
+  size_t size_;
+};
+
+//! A batch of tuples of words of the same size stored in one contiguous buffer.
+/*!
+  Letters of all words go one after another into a single array, the word boundaries are kept in an array of
+  offsets (compressed sparse row layout): the word j of the tuple i is [offsets[k], offsets[k + 1]) with
+  k = i * tupleSize() + j. Thus a batch of N tuples takes two allocations instead of N * tupleSize() words
+  with their own representations, and is traversed sequentially.
+
+  Words are kept freely reduced. Views returned by operator[] are invalidated by push_back.
+*/
+class WordBatch {
+public:
+  //! Creates an empty batch of tuples of the given size. Throws if tuple_size is 0.
+  explicit WordBatch(size_t tuple_size = 1);
+
+  //! Packs tuples. Throws if they have different sizes.
+  explicit WordBatch(const std::vector<std::vector<Word>>& tuples);
+
+  //! Packs a single tuple.
+  static WordBatch fromTuple(const std::vector<Word>& tuple);
+
+  //! Number of tuples.
+  size_t size() const {
+    return (offsets_.size() - 1) / tuple_size_;
+  }
+
+  bool empty() const {
+    return offsets_.size() == 1;
+  }
+
+  size_t tupleSize() const {
+    return tuple_size_;
+  }
+
+  //! Total number of letters in the batch.
+  size_t totalLength() const {
+    return letters_.size();
+  }
+
+  WordTuple operator[](size_t i) const {
+    return WordTuple(letters_.data(), offsets_.data() + i * tuple_size_, tuple_size_);
+  }
+
+  //! Appends a tuple. Throws if the size of the tuple is not tupleSize().
+  void push_back(const std::vector<Word>& tuple);
+
+  void push_back(const WordTuple& tuple);
+
+  void reserve(size_t tuples, size_t letters);
+
+  //! Returns the batch where every word w is replaced with c^{-1} w c.
+  WordBatch conjugate(const Word& c) const;
+
+  //! Returns the batch which consists of the tuples conjugated by each of the conjugators:
+  //! the tuple i conjugated by conjugators[j] goes to the position i * conjugators.size() + j.
+  WordBatch conjugate(const std::vector<Word>& conjugators) const;
+
+  std::vector<std::vector<Word>> toVectors() const;
+
+  //! The underlying letters and offsets (for testing purposes).
+  const std::vector<int>& letters() const {
+    return letters_;
+  }
+
+  const std::vector<size_t>& offsets() const {
+    return offsets_;
+  }
+
+private:
+  //! Appends the reduced form of u^{-1} w u as a new word, where uinv = u^{-1}.
+  void pushConjugate_(WordView w, const std::vector<int>& u, const std::vector<int>& uinv);
+
+  size_t tuple_size_;
+  std::vector<int> letters_;
+  std::vector<size_t> offsets_;
+};
+
+} // namespace crag
+
+#endif // CRAG_WORD_BATCH_H
@@ -8,16 +8,32 @@
 #define CRAG_WORDREP_H
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <list>
 #include <ostream>
 #include <stdexcept>
 #include <vector>
 
+#include "SmallLetterVector.h"
+
 //! Represents a group word.
 //! Usually a word is kept reduced, except for the cases when insert/replace functions are used.
+//! If CRAG_COMPACT_WORDS is defined (to 8 or 16), letters are stored as int8_t/int16_t with a small inline buffer,
+//! which is enough for braid groups and other groups with few generators. Otherwise letters are stored as int.
 class WordRep {
 private:
+#if defined(CRAG_COMPACT_WORDS) && CRAG_COMPACT_WORDS == 16
+  using letter_t = std::int16_t;
+  using storage_t = crag::SmallLetterVector<letter_t, 16>;
+#elif defined(CRAG_COMPACT_WORDS)
+  using letter_t = std::int8_t;
+  using storage_t = crag::SmallLetterVector<letter_t, 32>;
+#else
+  using letter_t = int;
   using storage_t = std::vector<int>;
+#endif
 
 public:
   using iterator = storage_t::iterator;
@@ -39,6 +55,8 @@ public:
 
   std::string toString() const;
 
+  //! Mutable iterators are meant for positioning only (see insert/replace/freelyReduce),
+  //! writing letters through them would invalidate the cached hash.
   iterator begin();
 
   const_iterator begin() const;
@@ -59,18 +77,10 @@ public:
     return elements_.front();
   }
 
-  int& front() {
-    return elements_.front();
-  }
-
   int back() const {
     return elements_.back();
   }
 
-  int& back() {
-    return elements_.back();
-  }
-
   // relational operators
   bool operator==(const WordRep& other) const;
 
@@ -80,6 +90,13 @@ public:
 
   bool operator>(const WordRep& other) const;
 
+  //! Hash of this word. It is derived from a polynomial hash of the letters which is cached and kept
+  //! up to date by every modifying operation (in O(1) for push/pop at both ends).
+  size_t hash() const;
+
+  //! Hash of the word given by letters [begin, end), equal to hash() of the corresponding WordRep.
+  static size_t hash(const int* begin, const int* end);
+
   //! Conjugate a word by another word
   WordRep& operator^=(const WordRep& conjugator);
 
@@ -131,9 +148,14 @@ public:
 
   WordRep inverse() const;
 
+  //! Inverts this word in place.
+  void invert();
+
   //! Make a word trivial
   inline void clear() {
     elements_.clear();
+    hash_ = 0;
+    power_ = 1;
   }
 
   //! Freely reduces this word.
@@ -212,6 +234,7 @@ public:
   }
 
   void pop_back() {
+    hashPopBack_(elements_.back());
     elements_.pop_back();
   }
 
@@ -220,6 +243,7 @@ public:
   }
 
   void pop_front() {
+    hashPopFront_(elements_.front());
     elements_.erase(elements_.begin());
   }
 
@@ -227,15 +251,26 @@ public:
     return std::list<int>(elements_.begin(), elements_.end());
   }
 
+#ifndef CRAG_COMPACT_WORDS
   const std::vector<int>& toVector() const {
     return elements_;
   }
+#else
+  std::vector<int> toVector() const {
+    return std::vector<int>(elements_.begin(), elements_.end());
+  }
+#endif
 
 private:
   inline void validate_(int g) const {
     if (g == 0) {
       throw std::invalid_argument("Zero indices are not allowed.");
     }
+
+    // the range is symmetric, so that the inverse of every stored letter can be stored too
+    if (g < -std::numeric_limits<letter_t>::max() || g > std::numeric_limits<letter_t>::max()) {
+      throw std::invalid_argument("Index does not fit into the word storage.");
+    }
   }
 
   template<typename Iterator>
@@ -255,8 +290,27 @@ private:
   //! Multiply on the left and reduce
   void reduced_push_front_(int g);
 
+  //! Updates the hash when g is appended to the end.
+  void hashPushBack_(int g);
+
+  //! Updates the hash when g is removed from the end.
+  void hashPopBack_(int g);
+
+  //! Updates the hash when g is prepended to the beginning.
+  void hashPushFront_(int g);
+
+  //! Updates the hash when g is removed from the beginning.
+  void hashPopFront_(int g);
+
+  //! Recomputes the hash from scratch.
+  void rehash_();
+
   // list of generators, negative integers represent inverses of positive integers
   storage_t elements_;
+
+  // polynomial hash sum_i l_i * B^{n - 1 - i} and B^n modulo 2^64, where n is the length of the word
+  std::uint64_t hash_ = 0;
+  std::uint64_t power_ = 1;
 };
 
 template<class InputIterator>
@@ -283,13 +337,17 @@ void WordRep::insert(iterator position, InputIterator begin, InputIterator end)
   validate_(begin, end);
 
   elements_.insert(position, begin, end);
+  rehash_();
 }
 
 template<class InputIterator>
 void WordRep::replace(iterator position, InputIterator b, InputIterator e) {
   for (; position != end() && b != e; ++position, ++b) {
+    validate_(*b);
     *position = *b;
   }
+
+  rehash_();
 }
 
 template<class InputIterator>
@@ -0,0 +1,136 @@
+#pragma once
+
+#ifndef CRAG_WORD_ROPE_H
+#define CRAG_WORD_ROPE_H
+
+#include <memory>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "Word.h"
+
+//! Represents a group word as a persistent balanced tree of letter chunks (a rope).
+/*!
+  Intended for very long words which are edited a lot: concatenation, subword extraction and
+  insertion take \f$O(\log n)\f$ time (plus the number of cancelled letters at the join point),
+  and copies share all unchanged chunks. Letter access is \f$O(\log n)\f$, so for letter-by-letter
+  processing convert the rope to a Word first.
+
+  As for Word, operator* reduces the result at the join point, while insert does not perform reduction.
+*/
+class WordRope {
+public:
+  //! Creates the empty word.
+  WordRope() {}
+
+  //! Constructs a rope from a word (the word is assumed to be reduced).
+  explicit WordRope(const Word& w);
+
+  //! Constructs a rope by its presentation (if the word defined in gens is not reduced then it reduces it).
+  explicit WordRope(const std::vector<int>& gens);
+
+  inline size_t length() const {
+    return size_(root_);
+  }
+
+  inline size_t size() const {
+    return size_(root_);
+  }
+
+  inline bool empty() const {
+    return root_ == nullptr;
+  }
+
+  //! Returns the letter at the given position. Throws if pos >= size().
+  int at(size_t pos) const;
+
+  int front() const {
+    return at(0);
+  }
+
+  int back() const {
+    return at(size() - 1);
+  }
+
+  //! Multiply the word on the right by another word (the result is reduced at the join point)
+  WordRope& operator*=(const WordRope& other);
+
+  //! Multiply two words (the result is reduced at the join point)
+  WordRope operator*(const WordRope& other) const {
+    WordRope result(*this);
+    result *= other;
+    return result;
+  }
+
+  //! Returns subword [from, to).
+  WordRope subword(size_t from, size_t to) const;
+
+  //! Inserts a word at the given position (at the end if pos >= size()).
+  //! Reduction is not performed!
+  void insert(size_t pos, const WordRope& w);
+
+  //! Removes the segment [from, to).
+  //! Reduction is not performed!
+  void erase(size_t from, size_t to);
+
+  //! Returns the inverse word (takes linear time).
+  WordRope inverse() const;
+
+  //! Freely reduces this word (takes linear time).
+  void freelyReduce();
+
+  std::vector<int> toVector() const;
+
+  //! Converts the rope to a word (the result is reduced).
+  Word toWord() const {
+    return Word(toVector());
+  }
+
+  bool operator==(const WordRope& other) const;
+
+  bool operator!=(const WordRope& other) const {
+    return !(*this == other);
+  }
+
+  //! Height of the underlying tree (for testing purposes).
+  int height() const {
+    return height_(root_);
+  }
+
+private:
+  struct Node;
+  using node_ptr = std::shared_ptr<const Node>;
+
+  explicit WordRope(node_ptr root)
+    : root_(std::move(root)) {}
+
+  static size_t size_(const node_ptr& node);
+
+  static int height_(const node_ptr& node);
+
+  //! Makes a leaf from a range of letters, nullptr for the empty range.
+  static node_ptr makeLeaf_(std::vector<int>::const_iterator begin, std::vector<int>::const_iterator end);
+
+  static node_ptr makeNode_(node_ptr left, node_ptr right);
+
+  //! Builds a balanced tree over letters [begin, end).
+  static node_ptr build_(std::vector<int>::const_iterator begin, std::vector<int>::const_iterator end);
+
+  //! Makes a node of two trees whose heights differ by at most 2.
+  static node_ptr balance_(node_ptr left, node_ptr right);
+
+  //! Concatenates two trees (no reduction).
+  static node_ptr join_(node_ptr left, node_ptr right);
+
+  //! Splits a tree into [0, pos) and [pos, size).
+  static std::pair<node_ptr, node_ptr> split_(const node_ptr& node, size_t pos);
+
+  static void collect_(const node_ptr& node, std::vector<int>& result);
+
+  node_ptr root_;
+};
+
+std::ostream& operator<<(std::ostream& out, const WordRope& w);
+
+#endif // CRAG_WORD_ROPE_H
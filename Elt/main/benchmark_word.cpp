@@ -0,0 +1,236 @@
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "FreeReduction.h"
+#include "Word.h"
+#include "random_word.h"
+
+static void BM_WordPushBack(benchmark::State& state) {
+  std::mt19937 g(1233);
+  std::uniform_int_distribution<> d(1, 8);
+
+  const size_t n = state.range(0);
+
+  while (state.KeepRunning()) {
+    Word w;
+
+    for (size_t i = 0; i < n; ++i) {
+      w.push_back(d(g));
+    }
+
+    benchmark::DoNotOptimize(w);
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+static void BM_WordMultiplyTemporaries(benchmark::State& state) {
+  std::mt19937 g(1233);
+  std::uniform_int_distribution<> d(1, 8);
+
+  const size_t n = state.range(0);
+
+  while (state.KeepRunning()) {
+    Word w;
+
+    for (size_t i = 0; i < n; ++i) {
+      w = std::move(w) * Word(d(g));
+    }
+
+    benchmark::DoNotOptimize(w);
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+static void BM_WordConjugateTemporary(benchmark::State& state) {
+  const auto w = Word::randomWord(8, state.range(0));
+  const Word c({1, 2, 3});
+
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(-(w * c) ^ c);
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+//! Reduces a random word over two generators where about a half of the letters cancel.
+static void freelyReduceLongWord(benchmark::State& state, crag::reduction::Kernel kernel) {
+  if (!crag::reduction::isSupported(kernel)) {
+    state.SkipWithError("Kernel is not supported.");
+    return;
+  }
+
+  std::mt19937 g(1233);
+  std::uniform_int_distribution<> d(-2, 1);
+
+  std::vector<int> w(state.range(0));
+  for (auto& letter : w) {
+    const auto x = d(g);
+    letter = x >= 0 ? x + 1 : x;
+  }
+
+  std::vector<int> copy;
+
+  while (state.KeepRunning()) {
+    copy = w;
+    benchmark::DoNotOptimize(crag::reduction::freelyReduce(copy.data(), 0, copy.size(), nullptr, kernel));
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+static void BM_FreelyReduceScalar(benchmark::State& state) {
+  freelyReduceLongWord(state, crag::reduction::Kernel::Scalar);
+}
+
+static void BM_FreelyReduceBest(benchmark::State& state) {
+  freelyReduceLongWord(state, crag::reduction::bestKernel());
+}
+
+//! Reduces a reduced word (the common case when multiplying words), so whole blocks are pushed at once.
+static void BM_FreelyReduceReducedWord(benchmark::State& state) {
+  auto w = Word::randomWord(8, state.range(0)).toVector();
+
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(crag::reduction::freelyReduce(w.data(), 0, w.size()));
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+static void BM_WordMultiply(benchmark::State& state) {
+  std::mt19937 g(1233);
+
+  const auto u = crag::random::randomWord(8, state.range(0), g);
+  const auto v = crag::random::randomWord(8, state.range(0), g);
+
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(u * v);
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+static void BM_WordInverse(benchmark::State& state) {
+  std::mt19937 g(1233);
+
+  const auto w = crag::random::randomWord(8, state.range(0), g);
+
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(w.inverse());
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+static void BM_WordConjugate(benchmark::State& state) {
+  std::mt19937 g(1233);
+
+  const auto w = crag::random::randomWord(8, state.range(0), g);
+  const auto c = crag::random::randomWord(8, 10, g);
+
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(w ^ c);
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+static void BM_WordFreelyReduce(benchmark::State& state) {
+  std::mt19937 g(1233);
+
+  const auto w = crag::random::randomWord(8, state.range(0), g);
+
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(w.freelyReduce());
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+//! The conjugator takes a half of the word.
+static void BM_WordCyclicallyReduce(benchmark::State& state) {
+  std::mt19937 g(1233);
+
+  const auto u = crag::random::randomWord(8, state.range(0) / 2, g).cyclicallyReduce();
+  const auto c = crag::random::randomWord(8, state.range(0) / 4, g);
+  const auto w = u ^ c;
+
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(w.cyclicallyReduce());
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+static void BM_WordSubword(benchmark::State& state) {
+  std::mt19937 g(1233);
+
+  const size_t n = state.range(0);
+  const auto w = crag::random::randomWord(8, n, g);
+
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(w.subword(n / 4, 3 * n / 4));
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+//! The word is a power of a word of length 10.
+static void BM_WordRoot(benchmark::State& state) {
+  std::mt19937 g(1233);
+
+  const auto base = crag::random::randomWord(8, 10, g).cyclicallyReduce();
+  const auto w = base.power(std::max<int>(1, state.range(0) / base.length()));
+
+  Word root;
+
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(w.getPower(root));
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+static void BM_WordExponentSum(benchmark::State& state) {
+  std::mt19937 g(1233);
+
+  const auto w = crag::random::randomWord(8, state.range(0), g);
+
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(w.exponentSum(3));
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+static void BM_RandomWord(benchmark::State& state) {
+  std::mt19937 g(1233);
+
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(crag::random::randomWord(8, state.range(0), g));
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+
+BENCHMARK(BM_WordPushBack)->RangeMultiplier(4)->Range(16, 1 << 18)->Complexity();
+BENCHMARK(BM_WordMultiplyTemporaries)->RangeMultiplier(4)->Range(16, 1 << 18)->Complexity();
+BENCHMARK(BM_WordConjugateTemporary)->RangeMultiplier(4)->Range(16, 1 << 18)->Complexity();
+BENCHMARK(BM_WordMultiply)->RangeMultiplier(10)->Range(10, 1000000)->Complexity();
+BENCHMARK(BM_WordInverse)->RangeMultiplier(10)->Range(10, 1000000)->Complexity();
+BENCHMARK(BM_WordConjugate)->RangeMultiplier(10)->Range(10, 1000000)->Complexity();
+BENCHMARK(BM_WordFreelyReduce)->RangeMultiplier(10)->Range(10, 1000000)->Complexity();
+BENCHMARK(BM_WordCyclicallyReduce)->RangeMultiplier(10)->Range(10, 1000000)->Complexity();
+BENCHMARK(BM_WordSubword)->RangeMultiplier(10)->Range(10, 1000000)->Complexity();
+BENCHMARK(BM_WordRoot)->RangeMultiplier(10)->Range(10, 1000000)->Complexity();
+BENCHMARK(BM_WordExponentSum)->RangeMultiplier(10)->Range(10, 1000000)->Complexity();
+BENCHMARK(BM_RandomWord)->RangeMultiplier(10)->Range(10, 1000000)->Complexity();
+BENCHMARK(BM_FreelyReduceScalar)->RangeMultiplier(4)->Range(1 << 10, 1 << 20)->Complexity();
+BENCHMARK(BM_FreelyReduceBest)->RangeMultiplier(4)->Range(1 << 10, 1 << 20)->Complexity();
+BENCHMARK(BM_FreelyReduceReducedWord)->RangeMultiplier(4)->Range(1 << 10, 1 << 20)->Complexity();
+
+BENCHMARK_MAIN();
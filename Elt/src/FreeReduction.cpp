@@ -0,0 +1,285 @@
+#include "FreeReduction.h"
+
+#include <algorithm>
+
+#include "Word.h"
+#include "parallel.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CRAG_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace crag {
+namespace reduction {
+
+namespace {
+
+//! Processes letter w[i] by the stack pass, [0, top) is the reduced part.
+template<typename Letter>
+inline void stackStep(Letter* w, size_t i, size_t& top, size_t& untouched) {
+  if (top > 0 && w[top - 1] + w[i] == 0) {
+    --top;
+    untouched = std::min(untouched, top);
+  } else {
+    w[top++] = w[i];
+  }
+}
+
+template<typename Letter>
+size_t freelyReduceScalar(Letter* w, size_t reduced, size_t size, size_t& untouched) {
+  size_t top = reduced;
+
+  for (size_t i = reduced; i < size; ++i) {
+    stackStep(w, i, top, untouched);
+  }
+
+  return top;
+}
+
+template<typename Letter>
+size_t cyclicReductionLengthScalar(const Letter* w, size_t size) {
+  size_t k = 0;
+
+  while (k < size / 2 && w[k] + w[size - 1 - k] == 0) {
+    ++k;
+  }
+
+  return k;
+}
+
+#ifdef CRAG_X86_KERNELS
+
+// In the vector kernels a block of B letters w[i, i + B) is pushed at once if it does not cancel with the top of
+// the stack and has no adjacent cancelling letters inside. Otherwise the letters up to the first cancellation are
+// processed by the stack pass. The block is loaded before it is stored, so in-place processing is safe (top <= i).
+
+size_t freelyReduceSSE2(int* w, size_t reduced, size_t size, size_t& untouched) {
+  size_t top = reduced;
+  size_t i = reduced;
+
+  const auto zero = _mm_setzero_si128();
+
+  while (i + 5 <= size) {
+    if (top > 0 && w[top - 1] + w[i] == 0) {
+      stackStep(w, i++, top, untouched);
+      continue;
+    }
+
+    const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(w + i));
+    const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(w + i + 1));
+    const auto mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_add_epi32(a, b), zero))) & 0x7;
+
+    if (mask == 0) {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(w + top), a);
+      top += 4;
+      i += 4;
+    } else {
+      const auto stop = i + __builtin_ctz(mask) + 2;
+      for (; i < stop; ++i) {
+        stackStep(w, i, top, untouched);
+      }
+    }
+  }
+
+  for (; i < size; ++i) {
+    stackStep(w, i, top, untouched);
+  }
+
+  return top;
+}
+
+__attribute__((target("avx2")))
+size_t freelyReduceAVX2(int* w, size_t reduced, size_t size, size_t& untouched) {
+  size_t top = reduced;
+  size_t i = reduced;
+
+  const auto zero = _mm256_setzero_si256();
+
+  while (i + 9 <= size) {
+    if (top > 0 && w[top - 1] + w[i] == 0) {
+      stackStep(w, i++, top, untouched);
+      continue;
+    }
+
+    const auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i));
+    const auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i + 1));
+    const auto mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_add_epi32(a, b), zero))) & 0x7F;
+
+    if (mask == 0) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(w + top), a);
+      top += 8;
+      i += 8;
+    } else {
+      const auto stop = i + __builtin_ctz(mask) + 2;
+      for (; i < stop; ++i) {
+        stackStep(w, i, top, untouched);
+      }
+    }
+  }
+
+  for (; i < size; ++i) {
+    stackStep(w, i, top, untouched);
+  }
+
+  return top;
+}
+
+size_t cyclicReductionLengthSSE2(const int* w, size_t size) {
+  size_t k = 0;
+  const auto zero = _mm_setzero_si128();
+
+  while (k + 4 <= size / 2) {
+    const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(w + k));
+    auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(w + size - k - 4));
+    b = _mm_shuffle_epi32(b, _MM_SHUFFLE(0, 1, 2, 3));
+
+    if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_add_epi32(a, b), zero)) != 0xFFFF) {
+      break;
+    }
+
+    k += 4;
+  }
+
+  while (k < size / 2 && w[k] + w[size - 1 - k] == 0) {
+    ++k;
+  }
+
+  return k;
+}
+
+__attribute__((target("avx2")))
+size_t cyclicReductionLengthAVX2(const int* w, size_t size) {
+  size_t k = 0;
+  const auto zero = _mm256_setzero_si256();
+  const auto reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+
+  while (k + 8 <= size / 2) {
+    const auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + k));
+    auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + size - k - 8));
+    b = _mm256_permutevar8x32_epi32(b, reverse);
+
+    if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_add_epi32(a, b), zero)) != -1) {
+      break;
+    }
+
+    k += 8;
+  }
+
+  while (k < size / 2 && w[k] + w[size - 1 - k] == 0) {
+    ++k;
+  }
+
+  return k;
+}
+
+#endif
+
+template<typename Letter>
+size_t freelyReduceImpl(Letter* w, size_t reduced, size_t size, size_t* untouched) {
+  size_t u = reduced;
+  const auto result = freelyReduceScalar(w, reduced, size, u);
+
+  if (untouched) {
+    *untouched = u;
+  }
+
+  return result;
+}
+
+} // namespace
+
+Kernel bestKernel() {
+  static const Kernel kernel = [] () {
+    if (isSupported(Kernel::AVX2)) {
+      return Kernel::AVX2;
+    }
+
+    if (isSupported(Kernel::SSE2)) {
+      return Kernel::SSE2;
+    }
+
+    return Kernel::Scalar;
+  }();
+
+  return kernel;
+}
+
+bool isSupported(Kernel kernel) {
+  switch (kernel) {
+    case Kernel::Scalar:
+      return true;
+#ifdef CRAG_X86_KERNELS
+    case Kernel::SSE2:
+      return __builtin_cpu_supports("sse2");
+    case Kernel::AVX2:
+      return __builtin_cpu_supports("avx2");
+#endif
+    default:
+      return false;
+  }
+}
+
+size_t freelyReduce(int* w, size_t reduced, size_t size, size_t* untouched, Kernel kernel) {
+  size_t u = reduced;
+  size_t result = 0;
+
+  switch (kernel) {
+#ifdef CRAG_X86_KERNELS
+    case Kernel::AVX2:
+      result = freelyReduceAVX2(w, reduced, size, u);
+      break;
+    case Kernel::SSE2:
+      result = freelyReduceSSE2(w, reduced, size, u);
+      break;
+#endif
+    default:
+      result = freelyReduceScalar(w, reduced, size, u);
+  }
+
+  if (untouched) {
+    *untouched = u;
+  }
+
+  return result;
+}
+
+size_t freelyReduce(std::int16_t* w, size_t reduced, size_t size, size_t* untouched, Kernel) {
+  return freelyReduceImpl(w, reduced, size, untouched);
+}
+
+size_t freelyReduce(std::int8_t* w, size_t reduced, size_t size, size_t* untouched, Kernel) {
+  return freelyReduceImpl(w, reduced, size, untouched);
+}
+
+size_t cyclicReductionLength(const int* w, size_t size, Kernel kernel) {
+  switch (kernel) {
+#ifdef CRAG_X86_KERNELS
+    case Kernel::AVX2:
+      return cyclicReductionLengthAVX2(w, size);
+    case Kernel::SSE2:
+      return cyclicReductionLengthSSE2(w, size);
+#endif
+    default:
+      return cyclicReductionLengthScalar(w, size);
+  }
+}
+
+size_t cyclicReductionLength(const std::int16_t* w, size_t size, Kernel) {
+  return cyclicReductionLengthScalar(w, size);
+}
+
+size_t cyclicReductionLength(const std::int8_t* w, size_t size, Kernel) {
+  return cyclicReductionLengthScalar(w, size);
+}
+
+void freelyReduce(std::vector<Word>& words) {
+  parallel::forEach(words.size(), [&](size_t i) { words[i] = words[i].freelyReduce(); });
+}
+
+void cyclicallyReduce(std::vector<Word>& words) {
+  parallel::forEach(words.size(), [&](size_t i) { words[i].cyclicallyReduceWord(); });
+}
+
+} // namespace reduction
+} // namespace crag
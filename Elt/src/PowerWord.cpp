@@ -3,65 +3,28 @@
 //
 // Principal Authors: Alexander Ushakov
 //
-// Revision History:
-//
 
-#include "stdlib.h"
 #include "PowerWord.h"
-#include <strstream>
-using namespace std;
-
-
-PowerWord& PowerWord::freelyReduce( const_iterator beg , const_iterator end )
-{
-  list< PII >::const_iterator b = beg.theIterator;
-  list< PII >::const_iterator e = end.theIterator;
-  
-  for( const_iterator cur_it=beg ; cur_it!=end ; ++cur_it ) {
-    
-    const_iterator cur_it2 = cur_it;
-    if( ++cur_it2==this->end( ) )
-      break;
-  }
-  
-  return *this;
-}
-
 
-//=========================================================
+#include <cstdlib>
 
+PowerWord PowerWord::power(int t) const {
+  // w = c^{-1} u c with cyclically reduced u, so w^t = c^{-1} u^t c and u^t involves no cancellations
+  PowerWord conjugator;
+  const auto u = cyclicallyReduce(conjugator);
+  const auto base = t < 0 ? u.inverse() : u;
 
-PowerWord PowerWord::power( int t ) const
-{
-  if( t==0 ) return PowerWord( );
-  
-  PowerWord result = ( t<0 ? this->inverse() : *this );
-  for( int i=1 ; i<abs( t ) ; ++i )
-    result *= ( t<0 ? this->inverse() : *this );
-  return result;
-}
-
-
-//=========================================================
+  PowerWordRep result = conjugator.impl_ptr_->inverse();
 
-
-PowerWord PowerWord::randomPowerWord( int gens , int wLen )
-{
-  if( wLen==0 )	return PowerWord( );
-  
-  int old = 0;
-  list< int > result;
-  for( int i=0 ; i<wLen ; ++i ) {
-    int div = i==0 ? 2*gens : 2*gens-1;
-    int g = ::rand()%div-gens;
-    g = g>=0 ? g+1 : g;
-    if( g+old==0 )
-      g = gens;
-    result.push_back( old = g );
+  if (base.runs().size() == 1) {
+    result.pushBack(base.runs().front().first, base.runs().front().second * std::abs(t));
+  } else {
+    for (int i = 0; i < std::abs(t); ++i) {
+      result *= *base.impl_ptr_;
+    }
   }
-  
-  return result;
-}
 
+  result *= *conjugator.impl_ptr_;
 
-//=========================================================
+  return PowerWord(std::move(result));
+}
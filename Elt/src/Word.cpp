@@ -13,14 +13,16 @@
 Word& Word::push_back(const Word& w) {
   clone_();
 
-  for (const auto g : w) {
-    impl_ptr_->push_back(g);
-  }
+  *impl_ptr_ *= *w.impl_ptr_;
 
   return *this;
 }
 
 Word& Word::push_front(const Word& w) {
+  if (&w == this) {
+    return push_front(w.clone());
+  }
+
   clone_();
 
   auto it = w.end();
@@ -46,7 +48,8 @@ Word Word::randomWord(int gens, int wLen) {
   if (wLen == 0) return Word();
 
   int old = 0;
-  std::list<int> result;
+  std::vector<int> result;
+  result.reserve(wLen);
   for (int i = 0; i < wLen; ++i) {
     int div = i == 0 ? 2 * gens : 2 * gens - 1;
     // int g = ::rand()%div-gens;
@@ -0,0 +1,178 @@
+#include "WordBatch.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "FreeReduction.h"
+
+namespace crag {
+
+bool WordView::operator==(const WordView& other) const {
+  return size() == other.size() && std::equal(begin_, end_, other.begin_);
+}
+
+size_t WordTuple::hash() const {
+  size_t result = size_;
+
+  for (const auto w : *this) {
+    result ^= w.hash() + 0x9e3779b9 + (result << 6) + (result >> 2);
+  }
+
+  return result;
+}
+
+std::vector<Word> WordTuple::toVector() const {
+  std::vector<Word> result;
+  result.reserve(size_);
+
+  for (const auto w : *this) {
+    result.push_back(w.toWord());
+  }
+
+  return result;
+}
+
+bool WordTuple::operator==(const WordTuple& other) const {
+  if (size_ != other.size_) {
+    return false;
+  }
+
+  for (size_t i = 0; i < size_; ++i) {
+    if ((*this)[i] != other[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+WordBatch::WordBatch(size_t tuple_size)
+  : tuple_size_(tuple_size), offsets_(1, 0) {
+  if (tuple_size == 0) {
+    throw std::invalid_argument("Tuple size must be positive.");
+  }
+}
+
+WordBatch::WordBatch(const std::vector<std::vector<Word>>& tuples)
+  : WordBatch(tuples.empty() ? 1 : tuples.front().size()) {
+  size_t letters = 0;
+
+  for (const auto& tuple : tuples) {
+    for (const auto& w : tuple) {
+      letters += w.length();
+    }
+  }
+
+  reserve(tuples.size(), letters);
+
+  for (const auto& tuple : tuples) {
+    push_back(tuple);
+  }
+}
+
+WordBatch WordBatch::fromTuple(const std::vector<Word>& tuple) {
+  return WordBatch(std::vector<std::vector<Word>>{tuple});
+}
+
+void WordBatch::push_back(const std::vector<Word>& tuple) {
+  if (tuple.size() != tuple_size_) {
+    throw std::invalid_argument("Bad tuple size.");
+  }
+
+  for (const auto& w : tuple) {
+    for (const auto g : w) {
+      letters_.push_back(g);
+    }
+
+    offsets_.push_back(letters_.size());
+  }
+}
+
+void WordBatch::push_back(const WordTuple& tuple) {
+  if (tuple.size() != tuple_size_) {
+    throw std::invalid_argument("Bad tuple size.");
+  }
+
+  // copy the letters and the offsets first, tuple may point into this batch
+  // and both letters_ and offsets_ can be reallocated below
+  const std::vector<int> letters(tuple[0].begin(), tuple[0].begin() + tuple.totalLength());
+  const auto shift = letters_.size();
+
+  std::vector<size_t> offsets;
+  offsets.reserve(tuple_size_);
+
+  for (const auto w : tuple) {
+    offsets.push_back(shift + (w.end() - tuple[0].begin()));
+  }
+
+  letters_.insert(letters_.end(), letters.begin(), letters.end());
+  offsets_.insert(offsets_.end(), offsets.begin(), offsets.end());
+}
+
+void WordBatch::reserve(size_t tuples, size_t letters) {
+  letters_.reserve(letters);
+  offsets_.reserve(tuples * tuple_size_ + 1);
+}
+
+WordBatch WordBatch::conjugate(const Word& c) const {
+  return conjugate(std::vector<Word>{c});
+}
+
+WordBatch WordBatch::conjugate(const std::vector<Word>& conjugators) const {
+  std::vector<std::vector<int>> us;
+  std::vector<std::vector<int>> uinvs;
+  size_t conjugators_length = 0;
+
+  for (const auto& c : conjugators) {
+    us.push_back(c.toVector());
+    uinvs.push_back(c.inverse().toVector());
+    conjugators_length += c.length();
+  }
+
+  WordBatch result(tuple_size_);
+  result.reserve(
+      size() * conjugators.size(), conjugators.size() * letters_.size() + 2 * size() * tuple_size_ * conjugators_length);
+
+  for (size_t i = 0; i < size(); ++i) {
+    const auto tuple = (*this)[i];
+
+    for (size_t j = 0; j < conjugators.size(); ++j) {
+      for (const auto w : tuple) {
+        result.pushConjugate_(w, us[j], uinvs[j]);
+      }
+    }
+  }
+
+  return result;
+}
+
+std::vector<std::vector<Word>> WordBatch::toVectors() const {
+  std::vector<std::vector<Word>> result;
+  result.reserve(size());
+
+  for (size_t i = 0; i < size(); ++i) {
+    result.push_back((*this)[i].toVector());
+  }
+
+  return result;
+}
+
+void WordBatch::pushConjugate_(WordView w, const std::vector<int>& u, const std::vector<int>& uinv) {
+  const auto begin = letters_.size();
+
+  // all three parts are reduced, so cancellations may happen only at the join points
+  letters_.insert(letters_.end(), uinv.begin(), uinv.end());
+  letters_.insert(letters_.end(), w.begin(), w.end());
+
+  auto length = reduction::freelyReduce(letters_.data() + begin, uinv.size(), letters_.size() - begin);
+  letters_.resize(begin + length);
+
+  letters_.insert(letters_.end(), u.begin(), u.end());
+
+  length = reduction::freelyReduce(letters_.data() + begin, length, letters_.size() - begin);
+  letters_.resize(begin + length);
+
+  offsets_.push_back(letters_.size());
+}
+
+} // namespace crag
@@ -7,9 +7,54 @@
 
 #include "WordRep.h"
 
+#include "FreeReduction.h"
+
 #include <cmath>
 #include <sstream>
 
+namespace {
+
+// Base of the polynomial hash. It is odd, hence invertible modulo 2^64.
+const std::uint64_t kHashBase = 0x9E3779B97F4A7C15ull;
+
+std::uint64_t inverseModulo2To64(std::uint64_t a) {
+  // Newton iteration, each step doubles the number of correct bits
+  std::uint64_t result = a;
+
+  for (int i = 0; i < 6; ++i) {
+    result *= 2 - a * result;
+  }
+
+  return result;
+}
+
+const std::uint64_t kHashBaseInverse = inverseModulo2To64(kHashBase);
+
+inline std::uint64_t letterCode(int g) {
+  return static_cast<std::uint64_t>(static_cast<std::int64_t>(g));
+}
+
+std::uint64_t hashBasePower(size_t n) {
+  std::uint64_t result = 1;
+  std::uint64_t base = kHashBase;
+
+  for (; n > 0; n >>= 1, base *= base) {
+    if (n & 1) {
+      result *= base;
+    }
+  }
+
+  return result;
+}
+
+// splitmix64 finalizer, spreads the polynomial hash over all bits
+size_t finalizeHash(std::uint64_t h) {
+  h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+  h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+  return static_cast<size_t>(h ^ (h >> 31));
+}
+} // namespace
+
 WordRep::WordRep(const std::list<int>& gens)
   : elements_(gens.begin(), gens.end()) {
   validate_();
@@ -26,6 +71,7 @@ WordRep::WordRep(std::vector<int> gens)
 WordRep::WordRep(int g)
   : elements_({g}) {
   validate_();
+  rehash_();
 }
 
 WordRep::WordRep(std::initializer_list<int> gens)
@@ -91,14 +137,40 @@ WordRep& WordRep::operator^=(const WordRep& conjugator) {
   result *= *this;
   result *= conjugator;
 
-  elements_.swap(result.elements_);
+  *this = std::move(result);
 
   return *this;
 }
 
 WordRep& WordRep::operator*=(const WordRep& other) {
-  for (const auto g : other.elements_) {
-    reduced_push_back_(g);
+  if (&other == this) {
+    const auto copy = other;
+    return *this *= copy;
+  }
+
+  // cancellation at the join point
+  auto it = other.elements_.begin();
+
+  for (; it != other.elements_.end() && !elements_.empty() && elements_.back() + *it == 0; ++it) {
+    pop_back();
+  }
+
+  // reduce the rest (it is reduced already unless other is not)
+  const auto old_size = size();
+  elements_.insert(elements_.end(), it, other.elements_.end());
+
+  size_t untouched = 0;
+  const auto new_size = crag::reduction::freelyReduce(elements_.data(), old_size, elements_.size(), &untouched);
+  elements_.resize(new_size);
+
+  if (untouched < old_size) {
+    rehash_();
+  } else {
+    const auto data = elements_.data();
+
+    for (size_t i = old_size; i < new_size; ++i) {
+      hashPushBack_(data[i]);
+    }
   }
 
   return *this;
@@ -118,7 +190,7 @@ void WordRep::cyclicLeftShift() {
   }
 
   reduced_push_back_(elements_.front());
-  elements_.erase(elements_.begin());
+  pop_front();
 }
 
 void WordRep::cyclicRightShift() {
@@ -127,7 +199,7 @@ void WordRep::cyclicRightShift() {
   }
 
   reduced_push_front_(elements_.back());
-  elements_.pop_back();
+  pop_back();
 }
 
 
@@ -171,18 +243,30 @@ int WordRep::exponentSum(int gen) const {
 }
 
 WordRep WordRep::inverse() const {
-  storage_t elements;
-  elements.reserve(size());
+  WordRep result;
+  result.elements_.reserve(size());
 
   for (auto it = elements_.rbegin(); it != elements_.rend(); ++it) {
-    elements.push_back(-*it);
+    result.elements_.push_back(-*it);
   }
 
-  return WordRep(std::move(elements));
+  result.rehash_();
+
+  return result;
+}
+
+void WordRep::invert() {
+  std::reverse(elements_.begin(), elements_.end());
+
+  for (auto& el : elements_) {
+    el = -el;
+  }
+
+  rehash_();
 }
 
 bool WordRep::operator==(const WordRep& other) const {
-  return elements_ == other.elements_;
+  return hash_ == other.hash_ && elements_ == other.elements_;
 }
 
 bool WordRep::operator!=(const WordRep& other) const {
@@ -218,10 +302,25 @@ bool WordRep::operator>(const WordRep& other) const {
   return other < *this;
 }
 
+size_t WordRep::hash() const {
+  return finalizeHash(hash_);
+}
+
+size_t WordRep::hash(const int* begin, const int* end) {
+  std::uint64_t h = 0;
+
+  for (auto it = begin; it != end; ++it) {
+    h = h * kHashBase + letterCode(*it);
+  }
+
+  return finalizeHash(h);
+}
+
 void WordRep::insert(iterator position, int g) {
   validate_({g});
 
   elements_.insert(position, g);
+  rehash_();
 }
 
 void WordRep::insert(size_t position, int g) {
@@ -236,6 +335,9 @@ void WordRep::insert(size_t position, int g) {
 void WordRep::replace(iterator position, int g) {
   validate_({g});
 
+  const auto weight = hashBasePower(std::distance(position, elements_.end()) - 1);
+  hash_ += (letterCode(g) - letterCode(*position)) * weight;
+
   *position = g;
 }
 
@@ -302,6 +404,7 @@ void WordRep::initialSegment(size_t to) {
   to = std::min(to, size());
 
   elements_.resize(to);
+  rehash_();
 }
 
 void WordRep::terminalSegment(size_t from) {
@@ -313,25 +416,25 @@ void WordRep::terminalSegment(size_t from) {
   std::advance(it, from);
 
   elements_.erase(elements_.begin(), it);
+  rehash_();
 }
 
 WordRep WordRep::cyclicallyReduce() {
   WordRep conjugator;
 
-  // TODO: rewrite using iterators to avoid erase
-  while (elements_.size() > 1) {
-    const auto b = elements_.front();
-    const auto e = elements_.back();
+  const auto k = crag::reduction::cyclicReductionLength(elements_.data(), size());
 
-    if (e + b != 0) {
-      break;
-    }
+  if (k == 0) {
+    return conjugator;
+  }
 
-    elements_.pop_back();
-    elements_.erase(elements_.begin());
+  const auto suffix = elements_.begin() + (size() - k);
+  conjugator.elements_.insert(conjugator.elements_.end(), suffix, elements_.end());
+  conjugator.rehash_();
 
-    conjugator.elements_.insert(conjugator.elements_.begin(), e);
-  }
+  elements_.erase(suffix, elements_.end());
+  elements_.erase(elements_.begin(), elements_.begin() + k);
+  rehash_();
 
   return conjugator;
 }
@@ -412,32 +515,13 @@ std::pair<WordRep, int> WordRep::root() const {
 
   auto base = *this;
   base.initialSegment( len );
-  return std::make_pair(base, size() / len);
+  // constructed in place, a converted temporary pair trips -Wfree-nonheap-object with the compact storage
+  return std::pair<WordRep, int>(std::move(base), static_cast<int>(size() / len));
 };
 
 void WordRep::freelyReduce() {
-  for (auto it = elements_.begin(); it != elements_.end();) {
-    auto next = it;
-    ++next;
-
-    if (next == elements_.end()) {
-      return;
-    }
-
-    if (*it + *next != 0) {
-      it = next;
-      continue;
-    }
-
-    // reduction
-    const auto is_beginning = (it == elements_.begin());
-
-    it = elements_.erase(elements_.erase(it));
-
-    if (!is_beginning) {
-      --it;
-    }
-  }
+  elements_.resize(crag::reduction::freelyReduce(elements_.data(), 0, elements_.size()));
+  rehash_();
 }
 
 void WordRep::freelyReduce(iterator begin, iterator end) {
@@ -456,21 +540,17 @@ void WordRep::freelyReduce(iterator begin, iterator end) {
   // put prefix and suffix back
   elements_.insert(elements_.begin(), prefix.begin(), prefix.end());
   elements_.insert(elements_.end(), suffix.begin(), suffix.end());
+  rehash_();
 }
 
 void WordRep::reduced_push_back_(int g) {
   validate_({g});
 
-  if (elements_.empty()) {
-    elements_.push_back(g);
-    return;
-  }
-
-  const int last_el = elements_.back();
-
-  if (last_el + g == 0) {
+  if (!elements_.empty() && elements_.back() + g == 0) {
+    hashPopBack_(elements_.back());
     elements_.pop_back();
   } else {
+    hashPushBack_(g);
     elements_.push_back(g);
   }
 }
@@ -478,20 +558,45 @@ void WordRep::reduced_push_back_(int g) {
 void WordRep::reduced_push_front_(int g) {
   validate_({g});
 
-  if (elements_.empty()) {
-    elements_.push_back(g);
-    return;
-  }
-
-  const int first_el = elements_.front();
-
-  if (first_el + g == 0) {
+  if (!elements_.empty() && elements_.front() + g == 0) {
+    hashPopFront_(elements_.front());
     elements_.erase(elements_.begin());
   } else {
+    hashPushFront_(g);
     elements_.insert(elements_.begin(), g);
   }
 }
 
+void WordRep::hashPushBack_(int g) {
+  hash_ = hash_ * kHashBase + letterCode(g);
+  power_ *= kHashBase;
+}
+
+void WordRep::hashPopBack_(int g) {
+  hash_ = (hash_ - letterCode(g)) * kHashBaseInverse;
+  power_ *= kHashBaseInverse;
+}
+
+void WordRep::hashPushFront_(int g) {
+  hash_ += letterCode(g) * power_;
+  power_ *= kHashBase;
+}
+
+void WordRep::hashPopFront_(int g) {
+  power_ *= kHashBaseInverse;
+  hash_ -= letterCode(g) * power_;
+}
+
+void WordRep::rehash_() {
+  hash_ = 0;
+  power_ = 1;
+
+  for (const auto g : elements_) {
+    hash_ = hash_ * kHashBase + letterCode(g);
+    power_ *= kHashBase;
+  }
+}
+
 std::ostream& operator<<(std::ostream& out, const WordRep& w) {
   if (w.empty()) {
     return out << "1";
@@ -0,0 +1,305 @@
+#include "WordRope.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+// Maximal number of letters kept in a single leaf
+const size_t kLeafSize = 128;
+} // namespace
+
+struct WordRope::Node {
+  // leaves keep letters, internal nodes keep two nonempty subtrees
+  std::vector<int> letters;
+  node_ptr left;
+  node_ptr right;
+  size_t size;
+  int height;
+};
+
+WordRope::WordRope(const Word& w) {
+  const auto gens = w.toVector();
+  root_ = build_(gens.begin(), gens.end());
+}
+
+WordRope::WordRope(const std::vector<int>& gens) {
+  if (std::find(gens.begin(), gens.end(), 0) != gens.end()) {
+    throw std::invalid_argument("Zero indices are not allowed.");
+  }
+
+  root_ = build_(gens.begin(), gens.end());
+  freelyReduce();
+}
+
+size_t WordRope::size_(const node_ptr& node) {
+  return node ? node->size : 0;
+}
+
+int WordRope::height_(const node_ptr& node) {
+  return node ? node->height : 0;
+}
+
+int WordRope::at(size_t pos) const {
+  if (pos >= size()) {
+    throw std::invalid_argument("Bad position.");
+  }
+
+  const Node* node = root_.get();
+
+  while (node->left) {
+    const auto left_size = node->left->size;
+
+    if (pos < left_size) {
+      node = node->left.get();
+    } else {
+      pos -= left_size;
+      node = node->right.get();
+    }
+  }
+
+  return node->letters[pos];
+}
+
+WordRope& WordRope::operator*=(const WordRope& other) {
+  auto left = root_;
+  auto right = other.root_;
+
+  // cancel letters at the join point
+  while (left && right) {
+    const auto l = WordRope(left).back();
+    const auto r = WordRope(right).front();
+
+    if (l + r != 0) {
+      break;
+    }
+
+    left = split_(left, size_(left) - 1).first;
+    right = split_(right, 1).second;
+  }
+
+  root_ = join_(std::move(left), std::move(right));
+
+  return *this;
+}
+
+WordRope WordRope::subword(size_t from, size_t to) const {
+  if (from > to) {
+    throw std::invalid_argument("Bad subword.");
+  }
+
+  to = std::min(to, size());
+  from = std::min(from, to);
+
+  const auto prefix = split_(root_, to).first;
+  return WordRope(split_(prefix, from).second);
+}
+
+void WordRope::insert(size_t pos, const WordRope& w) {
+  pos = std::min(pos, size());
+
+  auto parts = split_(root_, pos);
+  root_ = join_(join_(std::move(parts.first), w.root_), std::move(parts.second));
+}
+
+void WordRope::erase(size_t from, size_t to) {
+  if (from > to) {
+    throw std::invalid_argument("Bad segment.");
+  }
+
+  to = std::min(to, size());
+  from = std::min(from, to);
+
+  auto suffix = split_(root_, to).second;
+  auto prefix = split_(root_, from).first;
+  root_ = join_(std::move(prefix), std::move(suffix));
+}
+
+WordRope WordRope::inverse() const {
+  auto gens = toVector();
+
+  std::reverse(gens.begin(), gens.end());
+
+  for (auto& g : gens) {
+    g = -g;
+  }
+
+  return WordRope(build_(gens.begin(), gens.end()));
+}
+
+void WordRope::freelyReduce() {
+  auto gens = toVector();
+
+  auto top = gens.begin();
+
+  for (auto it = gens.begin(); it != gens.end(); ++it) {
+    if (top != gens.begin() && *(top - 1) + *it == 0) {
+      --top;
+    } else {
+      *top++ = *it;
+    }
+  }
+
+  if (top == gens.end()) {
+    return;
+  }
+
+  gens.erase(top, gens.end());
+  root_ = build_(gens.begin(), gens.end());
+}
+
+std::vector<int> WordRope::toVector() const {
+  std::vector<int> result;
+  result.reserve(size());
+
+  collect_(root_, result);
+
+  return result;
+}
+
+bool WordRope::operator==(const WordRope& other) const {
+  return root_ == other.root_ || (size() == other.size() && toVector() == other.toVector());
+}
+
+WordRope::node_ptr WordRope::makeLeaf_(std::vector<int>::const_iterator begin, std::vector<int>::const_iterator end) {
+  if (begin == end) {
+    return nullptr;
+  }
+
+  auto leaf = std::make_shared<Node>();
+  leaf->letters.assign(begin, end);
+  leaf->size = leaf->letters.size();
+  leaf->height = 1;
+
+  return leaf;
+}
+
+WordRope::node_ptr WordRope::makeNode_(node_ptr left, node_ptr right) {
+  auto node = std::make_shared<Node>();
+  node->size = left->size + right->size;
+  node->height = std::max(left->height, right->height) + 1;
+  node->left = std::move(left);
+  node->right = std::move(right);
+
+  return node;
+}
+
+WordRope::node_ptr WordRope::build_(std::vector<int>::const_iterator begin, std::vector<int>::const_iterator end) {
+  const auto len = static_cast<size_t>(std::distance(begin, end));
+
+  if (len <= kLeafSize) {
+    return makeLeaf_(begin, end);
+  }
+
+  const auto middle = begin + len / 2;
+  return makeNode_(build_(begin, middle), build_(middle, end));
+}
+
+WordRope::node_ptr WordRope::balance_(node_ptr left, node_ptr right) {
+  const auto hl = height_(left);
+  const auto hr = height_(right);
+
+  if (hl > hr + 1) {
+    // single or double right rotation
+    if (height_(left->left) >= height_(left->right)) {
+      return makeNode_(left->left, makeNode_(left->right, std::move(right)));
+    }
+
+    const auto& lr = left->right;
+    return makeNode_(makeNode_(left->left, lr->left), makeNode_(lr->right, std::move(right)));
+  }
+
+  if (hr > hl + 1) {
+    // single or double left rotation
+    if (height_(right->right) >= height_(right->left)) {
+      return makeNode_(makeNode_(std::move(left), right->left), right->right);
+    }
+
+    const auto& rl = right->left;
+    return makeNode_(makeNode_(std::move(left), rl->left), makeNode_(rl->right, right->right));
+  }
+
+  return makeNode_(std::move(left), std::move(right));
+}
+
+WordRope::node_ptr WordRope::join_(node_ptr left, node_ptr right) {
+  if (!left) {
+    return right;
+  }
+
+  if (!right) {
+    return left;
+  }
+
+  // keep leaves dense when short pieces are appended one by one
+  if (left->height == 1 && right->height == 1 && left->size + right->size <= kLeafSize) {
+    auto leaf = std::make_shared<Node>();
+    leaf->letters.reserve(left->size + right->size);
+    leaf->letters.insert(leaf->letters.end(), left->letters.begin(), left->letters.end());
+    leaf->letters.insert(leaf->letters.end(), right->letters.begin(), right->letters.end());
+    leaf->size = leaf->letters.size();
+    leaf->height = 1;
+
+    return leaf;
+  }
+
+  const auto hl = left->height;
+  const auto hr = right->height;
+
+  if (hl > hr + 1) {
+    return balance_(left->left, join_(left->right, std::move(right)));
+  }
+
+  if (hr > hl + 1) {
+    return balance_(join_(std::move(left), right->left), right->right);
+  }
+
+  return makeNode_(std::move(left), std::move(right));
+}
+
+std::pair<WordRope::node_ptr, WordRope::node_ptr> WordRope::split_(const node_ptr& node, size_t pos) {
+  if (!node) {
+    return std::make_pair(nullptr, nullptr);
+  }
+
+  if (pos == 0) {
+    return std::make_pair(nullptr, node);
+  }
+
+  if (pos >= node->size) {
+    return std::make_pair(node, nullptr);
+  }
+
+  if (node->height == 1) {
+    const auto middle = node->letters.begin() + pos;
+    return std::make_pair(makeLeaf_(node->letters.begin(), middle), makeLeaf_(middle, node->letters.end()));
+  }
+
+  const auto left_size = node->left->size;
+
+  if (pos <= left_size) {
+    auto parts = split_(node->left, pos);
+    return std::make_pair(std::move(parts.first), join_(std::move(parts.second), node->right));
+  }
+
+  auto parts = split_(node->right, pos - left_size);
+  return std::make_pair(join_(node->left, std::move(parts.first)), std::move(parts.second));
+}
+
+void WordRope::collect_(const node_ptr& node, std::vector<int>& result) {
+  if (!node) {
+    return;
+  }
+
+  if (node->height == 1) {
+    result.insert(result.end(), node->letters.begin(), node->letters.end());
+    return;
+  }
+
+  collect_(node->left, result);
+  collect_(node->right, result);
+}
+
+std::ostream& operator<<(std::ostream& out, const WordRope& w) {
+  return out << w.toWord();
+}
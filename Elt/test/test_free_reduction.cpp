@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "FreeReduction.h"
+#include "Word.h"
+
+using crag::reduction::Kernel;
+
+namespace {
+
+const Kernel kKernels[] = {Kernel::Scalar, Kernel::SSE2, Kernel::AVX2};
+
+//! Random word over few generators, so that there are many cancellations.
+std::vector<int> randomUnreducedWord(std::mt19937& g, size_t size, int rank) {
+  std::uniform_int_distribution<int> d(1, rank);
+  std::bernoulli_distribution sign;
+
+  std::vector<int> result(size);
+
+  for (auto& letter : result) {
+    letter = sign(g) ? d(g) : -d(g);
+  }
+
+  return result;
+}
+
+std::vector<int> reduceNaive(const std::vector<int>& w) {
+  std::vector<int> result;
+
+  for (const auto g : w) {
+    if (!result.empty() && result.back() + g == 0) {
+      result.pop_back();
+    } else {
+      result.push_back(g);
+    }
+  }
+
+  return result;
+}
+
+std::vector<int> reduce(std::vector<int> w, Kernel kernel, size_t reduced = 0) {
+  w.resize(crag::reduction::freelyReduce(w.data(), reduced, w.size(), nullptr, kernel));
+  return w;
+}
+
+TEST(FreeReduction, Simple) {
+  for (const auto kernel : kKernels) {
+    if (!crag::reduction::isSupported(kernel)) {
+      continue;
+    }
+
+    EXPECT_EQ(std::vector<int>(), reduce({}, kernel));
+    EXPECT_EQ(std::vector<int>(), reduce({1, -1}, kernel));
+    EXPECT_EQ(std::vector<int>({1, 3}), reduce({1, 2, -2, 3}, kernel));
+    EXPECT_EQ(std::vector<int>(), reduce({1, 2, 3, 4, 5, 6, 7, 8, 9, -9, -8, -7, -6, -5, -4, -3, -2, -1}, kernel));
+    EXPECT_EQ(std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}),
+              reduce({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}, kernel));
+  }
+}
+
+TEST(FreeReduction, RandomWords) {
+  std::mt19937 g(1728);
+
+  for (const auto size : {1, 5, 9, 17, 100, 1000, 10000}) {
+    for (const auto rank : {1, 2, 3, 10}) {
+      const auto w = randomUnreducedWord(g, size, rank);
+      const auto expected = reduceNaive(w);
+
+      for (const auto kernel : kKernels) {
+        if (crag::reduction::isSupported(kernel)) {
+          EXPECT_EQ(expected, reduce(w, kernel));
+        }
+      }
+    }
+  }
+}
+
+TEST(FreeReduction, ReducedPrefix) {
+  std::mt19937 g(1729);
+
+  for (int i = 0; i < 100; ++i) {
+    const auto prefix = reduceNaive(randomUnreducedWord(g, 50, 2));
+    const auto suffix = randomUnreducedWord(g, 50, 2);
+
+    auto w = prefix;
+    w.insert(w.end(), suffix.begin(), suffix.end());
+
+    const auto expected = reduceNaive(w);
+
+    for (const auto kernel : kKernels) {
+      if (!crag::reduction::isSupported(kernel)) {
+        continue;
+      }
+
+      auto copy = w;
+      size_t untouched = 0;
+      copy.resize(crag::reduction::freelyReduce(copy.data(), prefix.size(), copy.size(), &untouched, kernel));
+
+      EXPECT_EQ(expected, copy);
+      EXPECT_LE(untouched, prefix.size());
+      EXPECT_TRUE(std::equal(prefix.begin(), prefix.begin() + untouched, copy.begin()));
+    }
+  }
+}
+
+TEST(FreeReduction, CompactLetters) {
+  std::vector<std::int8_t> w8{1, 2, -2, 3, -3, -1, 4};
+  EXPECT_EQ(1, crag::reduction::freelyReduce(w8.data(), 0, w8.size()));
+  EXPECT_EQ(4, w8[0]);
+
+  std::vector<std::int16_t> w16{1000, -1000, 2000};
+  EXPECT_EQ(1, crag::reduction::freelyReduce(w16.data(), 0, w16.size()));
+  EXPECT_EQ(2000, w16[0]);
+}
+
+TEST(FreeReduction, CyclicReductionLength) {
+  std::mt19937 g(1730);
+
+  for (const auto kernel : kKernels) {
+    if (!crag::reduction::isSupported(kernel)) {
+      continue;
+    }
+
+    const std::vector<int> w{1, 2, 3, -2, -1};
+    EXPECT_EQ(2, crag::reduction::cyclicReductionLength(w.data(), w.size(), kernel));
+
+    const std::vector<int> v{1, -1};
+    EXPECT_EQ(1, crag::reduction::cyclicReductionLength(v.data(), v.size(), kernel));
+
+    EXPECT_EQ(0, crag::reduction::cyclicReductionLength(w.data(), 0, kernel));
+  }
+
+  for (int i = 0; i < 100; ++i) {
+    const auto core = reduceNaive(randomUnreducedWord(g, 30, 3));
+    const auto conjugator = reduceNaive(randomUnreducedWord(g, i, 3));
+
+    std::vector<int> w;
+    for (auto it = conjugator.rbegin(); it != conjugator.rend(); ++it) {
+      w.push_back(-*it);
+    }
+    w.insert(w.end(), core.begin(), core.end());
+    w.insert(w.end(), conjugator.begin(), conjugator.end());
+
+    const auto expected = crag::reduction::cyclicReductionLength(w.data(), w.size(), Kernel::Scalar);
+    EXPECT_LE(conjugator.size(), expected);
+
+    for (const auto kernel : kKernels) {
+      if (crag::reduction::isSupported(kernel)) {
+        EXPECT_EQ(expected, crag::reduction::cyclicReductionLength(w.data(), w.size(), kernel));
+      }
+    }
+  }
+}
+
+TEST(FreeReduction, Batch) {
+  std::mt19937 g(1731);
+
+  std::vector<Word> words;
+  std::vector<Word> reduced;
+  std::vector<Word> cyclically_reduced;
+
+  for (int i = 0; i < 50; ++i) {
+    const auto letters = randomUnreducedWord(g, 100, 3);
+    const auto core = reduceNaive(letters);
+
+    // insert leaves the word unreduced
+    Word w;
+    w.insert(0, letters.begin(), letters.end());
+    words.push_back(w);
+
+    reduced.push_back(Word(core));
+    cyclically_reduced.push_back(Word(core).cyclicallyReduce());
+  }
+
+  crag::reduction::freelyReduce(words);
+  EXPECT_EQ(reduced, words);
+
+  crag::reduction::cyclicallyReduce(words);
+  EXPECT_EQ(cyclically_reduced, words);
+}
+
+} // namespace
@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+
+#include "PowerWord.h"
+
+namespace {
+
+typedef std::pair<int, int> PII;
+
+TEST(PowerWord, Construction) {
+  EXPECT_TRUE(PowerWord().empty());
+  EXPECT_EQ(std::vector<PII>({{1, 2}, {2, -1}, {3, 1}}), PowerWord(std::vector<int>{1, 1, -2, 3}).runs());
+  EXPECT_EQ(std::vector<PII>({{1, 3}}), PowerWord(std::vector<PII>{{1, 2}, {2, 1}, {-2, 1}, {1, 1}}).runs());
+  EXPECT_EQ(std::vector<PII>({{2, -3}}), PowerWord(-2, 3).runs());
+  EXPECT_EQ(4, PowerWord(std::vector<int>{1, 1, -2, 3}).length());
+  EXPECT_THROW({ PowerWord(0); }, std::invalid_argument);
+}
+
+TEST(PowerWord, WordConversion) {
+  const auto w = Word::randomWord(3, 200) * Word(std::vector<int>(50, 2));
+  const PowerWord p(w);
+
+  EXPECT_EQ(w.length(), p.length());
+  EXPECT_EQ(w, p.toWord());
+  EXPECT_EQ(w.toVector(), std::vector<int>(p.begin(), p.end()));
+  EXPECT_EQ(PowerWord(Word({1, -2, -2, 3})), PowerWord(std::vector<PII>{{1, 1}, {2, -2}, {3, 1}}));
+}
+
+TEST(PowerWord, Iterator) {
+  const PowerWord w(std::vector<PII>{{1, 2}, {2, -3}});
+
+  EXPECT_EQ(std::vector<int>({1, 1, -2, -2, -2}), std::vector<int>(w.begin(), w.end()));
+
+  auto it = w.end();
+  EXPECT_EQ(-2, *--it);
+  std::advance(it, -2);
+  EXPECT_EQ(-2, *it);
+  EXPECT_EQ(1, *--it);
+}
+
+TEST(PowerWord, Multiplication) {
+  const PowerWord u(std::vector<PII>{{1, 2}, {2, 3}});
+  const PowerWord v(std::vector<PII>{{2, -3}, {1, -1}, {3, 2}});
+
+  EXPECT_EQ(PowerWord(std::vector<PII>{{1, 1}, {3, 2}}), u * v);
+  EXPECT_EQ(3, (u * v).length());
+  EXPECT_TRUE((u * u.inverse()).empty());
+  EXPECT_EQ(PowerWord(std::vector<PII>{{2, -3}, {1, -2}}), -u);
+
+  for (int i = 0; i < 20; ++i) {
+    const auto a = Word::randomWord(2, 30);
+    const auto b = Word::randomWord(2, 30);
+
+    EXPECT_EQ(a * b, (PowerWord(a) * PowerWord(b)).toWord());
+    EXPECT_EQ(-a, PowerWord(a).inverse().toWord());
+  }
+}
+
+TEST(PowerWord, CopyOnWrite) {
+  PowerWord u(1, 2);
+  const auto v = u;
+
+  u.push_back(2, 1);
+  u.push_front(1, -2);
+
+  EXPECT_EQ(PowerWord(1, 2), v);
+  EXPECT_EQ(PowerWord(2), u);
+}
+
+TEST(PowerWord, CyclicReduction) {
+  for (int i = 0; i < 50; ++i) {
+    const auto w = Word::randomWord(2, 20);
+    const auto c = Word::randomWord(2, 10);
+    const PowerWord p(w ^ c);
+
+    PowerWord conjugator;
+    const auto u = p.cyclicallyReduce(conjugator);
+
+    EXPECT_EQ((w ^ c).cyclicallyReduce(), u.toWord());
+    EXPECT_EQ(p, conjugator.inverse() * u * conjugator);
+  }
+}
+
+TEST(PowerWord, Power) {
+  const PowerWord delta(std::vector<int>{1, 2, 1});
+
+  EXPECT_EQ(delta.toWord().power(5), delta.power(5).toWord());
+  EXPECT_EQ(delta.toWord().power(-3), delta.power(-3).toWord());
+  EXPECT_TRUE(delta.power(0).empty());
+  EXPECT_EQ(PowerWord(2, -300), PowerWord(2, 3).power(-100));
+  EXPECT_EQ(1, PowerWord(2, 3).power(-100).runs().size());
+
+  const auto w = PowerWord(std::vector<int>{-1, 2, 3, 1});
+  EXPECT_EQ(w.toWord().power(4), w.power(4).toWord());
+}
+
+TEST(PowerWord, ExponentSum) {
+  const PowerWord w(std::vector<PII>{{1, 2}, {2, 3}, {1, -5}});
+
+  EXPECT_EQ(-3, w.exponentSum(1));
+  EXPECT_EQ(3, w.exponentSum(2));
+  EXPECT_TRUE(w.doesContain(-2));
+  EXPECT_FALSE(w.doesContain(3));
+}
+
+TEST(PowerWord, Print) {
+  std::stringstream s;
+  s << PowerWord(std::vector<PII>{{1, 2}, {2, -1}, {3, 1}});
+  EXPECT_EQ("x1^2 x2^-1 x3", s.str());
+}
+
+} // namespace
@@ -152,6 +152,61 @@ TEST(Word, PushFront_02) {
   EXPECT_EQ(Word({1, 2}), u);
 }
 
+TEST(Word, PushSelf) {
+  Word w({1, 2});
+
+  w.push_back(w);
+  EXPECT_EQ(Word({1, 2, 1, 2}), w);
+
+  w.push_front(w);
+  EXPECT_EQ(Word({1, 2, 1, 2, 1, 2, 1, 2}), w);
+
+  w *= w;
+  EXPECT_EQ(16, w.length());
+}
+
+TEST(Word, CopyOnWrite) {
+  Word w({1, 2});
+  auto u = w;
+
+  w.push_back(3);
+  u.push_back(-2);
+
+  EXPECT_EQ(Word({1, 2, 3}), w);
+  EXPECT_EQ(Word(1), u);
+}
+
+TEST(Word, Temporaries) {
+  const Word w({1, 2});
+  const Word c(3);
+
+  EXPECT_EQ(Word({1, 2, 3, 1}), Word({1, 2}) * c * Word(1));
+  EXPECT_EQ(Word({-2, -1}), -Word({1, 2}));
+  EXPECT_EQ(Word({-3, 1, 2, 3}), Word({1, 2}) ^ c);
+  EXPECT_EQ(Word({1, 2, 1, 2}), Word({1, 2}) ^ 2);
+  EXPECT_EQ(Word({-3, -2, -1}), -(w * c));
+
+  EXPECT_EQ(Word({1, 2}), w);
+  EXPECT_EQ(Word(3), c);
+}
+
+TEST(Word, Hash) {
+  const Word w({1, 2, 3});
+  auto u = Word({1, 2}) * Word({-2, -1, 1, 2});
+
+  u.push_back(3);
+
+  EXPECT_EQ(std::hash<Word>()(w), std::hash<Word>()(u));
+  EXPECT_NE(std::hash<Word>()(w), std::hash<Word>()(-w));
+
+  const std::vector<Word> a = {w, Word(1)};
+  const std::vector<Word> b = {u, Word(1)};
+  const std::vector<Word> c = {Word(1), w};
+
+  EXPECT_EQ(std::hash<std::vector<Word>>()(a), std::hash<std::vector<Word>>()(b));
+  EXPECT_NE(std::hash<std::vector<Word>>()(a), std::hash<std::vector<Word>>()(c));
+}
+
 TEST(Word, Pop) {
   Word w({1, 2, 3});
 
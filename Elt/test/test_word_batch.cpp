@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+
+#include "WordBatch.h"
+
+namespace crag {
+namespace {
+
+TEST(WordBatch, PackAndUnpack) {
+  const std::vector<std::vector<Word>> tuples = {{Word({1, 2}), Word(), Word({-3})}, {Word({4}), Word({1, 1}), Word({2, -1})}};
+
+  const WordBatch batch(tuples);
+
+  EXPECT_EQ(2, batch.size());
+  EXPECT_EQ(3, batch.tupleSize());
+  EXPECT_EQ(8, batch.totalLength());
+  EXPECT_EQ(std::vector<int>({1, 2, -3, 4, 1, 1, 2, -1}), batch.letters());
+  EXPECT_EQ(std::vector<size_t>({0, 2, 2, 3, 4, 6, 8}), batch.offsets());
+  EXPECT_EQ(tuples, batch.toVectors());
+
+  EXPECT_EQ(3, batch[1].size());
+  EXPECT_EQ(5, batch[1].totalLength());
+  EXPECT_TRUE(batch[0][1].empty());
+  EXPECT_EQ(Word({1, 1}), batch[1][1].toWord());
+  EXPECT_EQ(tuples[1], batch[1].toVector());
+}
+
+TEST(WordBatch, PushBack) {
+  WordBatch batch(2);
+
+  EXPECT_TRUE(batch.empty());
+  EXPECT_THROW({ batch.push_back({Word(1)}); }, std::invalid_argument);
+  EXPECT_THROW({ WordBatch(0); }, std::invalid_argument);
+
+  batch.push_back({Word(1), Word(2)});
+  batch.push_back(batch[0]);
+
+  EXPECT_EQ(2, batch.size());
+  EXPECT_EQ(batch[0], batch[1]);
+  EXPECT_EQ(std::vector<Word>({Word(1), Word(2)}), batch[1].toVector());
+}
+
+TEST(WordBatch, PushBackSelfReallocates) {
+  const std::vector<Word> first = {Word({1, 2}), Word(), Word({-3, 4, 5})};
+  const std::vector<Word> second = {Word(6), Word({-7, -7}), Word({8, 9, -1})};
+
+  WordBatch batch(3);
+  batch.push_back(first);
+  batch.push_back(second);
+
+  // every self-append outgrows letters_ and offsets_ sooner or later
+  for (int i = 0; i < 10; ++i) {
+    batch.push_back(batch[0]);
+    batch.push_back(batch[1]);
+  }
+
+  ASSERT_EQ(22, batch.size());
+
+  for (size_t i = 0; i < batch.size(); ++i) {
+    EXPECT_EQ(i % 2 ? second : first, batch[i].toVector());
+  }
+}
+
+TEST(WordBatch, Hash) {
+  const std::vector<Word> tuple = {Word({1, 2, -3}), Word({-2, 5}), Word()};
+  const auto batch = WordBatch::fromTuple(tuple);
+
+  for (size_t i = 0; i < tuple.size(); ++i) {
+    EXPECT_EQ(tuple[i].hash(), batch[0][i].hash());
+  }
+
+  EXPECT_EQ(std::hash<std::vector<Word>>()(tuple), batch[0].hash());
+}
+
+TEST(WordBatch, Conjugate) {
+  const std::vector<Word> tuple = {Word({1, 2, -1}), Word({3, 4}), Word()};
+  const std::vector<Word> conjugators = {Word(1), Word({-2, 3}), Word()};
+
+  const auto batch = WordBatch::fromTuple(tuple).conjugate(conjugators);
+
+  ASSERT_EQ(conjugators.size(), batch.size());
+
+  for (size_t j = 0; j < conjugators.size(); ++j) {
+    for (size_t i = 0; i < tuple.size(); ++i) {
+      EXPECT_EQ(tuple[i] ^ conjugators[j], batch[j][i].toWord());
+    }
+  }
+
+  const auto random_tuple = std::vector<Word>{Word::randomWord(3, 100), Word::randomWord(3, 50)};
+  const auto c = Word::randomWord(3, 30);
+  const auto conjugated = WordBatch::fromTuple(random_tuple).conjugate(c);
+
+  EXPECT_EQ(random_tuple[0] ^ c, conjugated[0][0].toWord());
+  EXPECT_EQ(random_tuple[1] ^ c, conjugated[0][1].toWord());
+}
+
+} // namespace
+} // namespace crag
@@ -367,4 +367,104 @@ TEST(WordRep, ReplaceRange) {
 
   EXPECT_THROW({ w.replace(100, v.begin(), v.end()); }, std::invalid_argument);
 }
+
+TEST(WordRep, LongWords) {
+  std::vector<int> v;
+
+  for (int i = 0; i < 100; ++i) {
+    v.push_back(i % 7 + 1);
+  }
+
+  WordRep w(v);
+  const auto u = w;
+  auto m = std::move(w);
+
+  EXPECT_EQ(v, u.toVector());
+  EXPECT_EQ(u, m);
+
+  m.initialSegment(3);
+  m.insert(1, v.begin(), v.end());
+  m.freelyReduce();
+
+  EXPECT_EQ(103, m.size());
+  EXPECT_EQ(WordRep(v), u);
+  EXPECT_EQ(WordRep(), u * u.inverse());
+}
+
+TEST(WordRep, Hash) {
+  // the cached hash must agree with the hash of a freshly built word
+  const auto check = [] (const WordRep& w) {
+    EXPECT_EQ(WordRep(w.toVector()).hash(), w.hash());
+  };
+
+  WordRep w({1, 2, 3, -4});
+  check(w);
+
+  EXPECT_EQ(WordRep({1, 2}).hash(), WordRep({1, 2}).hash());
+  EXPECT_NE(WordRep({1, 2}).hash(), WordRep({2, 1}).hash());
+  EXPECT_EQ(WordRep().hash(), WordRep({1, -1}).hash());
+
+  w.push_back(4);
+  check(w);
+  w.push_front(5);
+  check(w);
+  w.push_front(-5);
+  check(w);
+  w.pop_front();
+  check(w);
+  w.pop_back();
+  check(w);
+  w *= WordRep({3, 2, 5});
+  check(w);
+  w ^= WordRep({6, 7});
+  check(w);
+  w ^= 3;
+  check(w);
+  w.cyclicLeftShift();
+  check(w);
+  w.cyclicRightShift();
+  check(w);
+  w.cyclicallyPermute(4);
+  check(w);
+  w.replace(2, 9);
+  check(w);
+  w.insert(3, 8);
+  check(w);
+  w.insert(1, -1);
+  w.freelyReduce();
+  check(w);
+  w.segment(1, 7);
+  check(w);
+  check(w.inverse());
+  check(w.subword(2, 5));
+
+  auto c = w ^ WordRep({1, 2});
+  const auto conjugator = c.cyclicallyReduce();
+  check(c);
+  check(conjugator);
+}
+
+#ifdef CRAG_COMPACT_WORDS
+TEST(WordRep, CompactLetterRange) {
+  EXPECT_NO_THROW({ WordRep(127); });
+  EXPECT_NO_THROW({ WordRep({-127, 5}); });
+  EXPECT_THROW({ WordRep(100000); }, std::invalid_argument);
+  EXPECT_THROW({ WordRep({1, 2, -100000}); }, std::invalid_argument);
+
+  WordRep w({1, 2});
+  EXPECT_THROW({ w.push_back(100000); }, std::invalid_argument);
+  EXPECT_THROW({ w.insert(1, -100000); }, std::invalid_argument);
+}
+
+TEST(WordRep, CompactLetterRangeIsSymmetric) {
+  const int max = CRAG_COMPACT_WORDS == 16 ? 32767 : 127;
+
+  // the inverse of -max - 1 would not fit
+  EXPECT_THROW({ WordRep(-max - 1); }, std::invalid_argument);
+
+  WordRep w({-max, 1});
+  w.invert();
+  EXPECT_EQ(WordRep({-1, max}), w);
+}
+#endif
 } // namespace
@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+
+#include "WordRope.h"
+
+namespace {
+
+std::vector<int> iota(int from, int to) {
+  std::vector<int> result;
+
+  for (int i = from; i < to; ++i) {
+    result.push_back(i % 10 + 1);
+  }
+
+  return result;
+}
+
+TEST(WordRope, Basics) {
+  const WordRope w(Word({1, 2, 3}));
+
+  EXPECT_EQ(3, w.size());
+  EXPECT_FALSE(w.empty());
+  EXPECT_EQ(1, w.front());
+  EXPECT_EQ(2, w.at(1));
+  EXPECT_EQ(3, w.back());
+  EXPECT_EQ(Word({1, 2, 3}), w.toWord());
+
+  EXPECT_TRUE(WordRope().empty());
+  EXPECT_TRUE(WordRope(std::vector<int>{1, 2, -2, -1}).empty());
+  EXPECT_THROW({ WordRope(std::vector<int>{1, 0}); }, std::invalid_argument);
+  EXPECT_THROW({ w.at(3); }, std::invalid_argument);
+}
+
+TEST(WordRope, Multiplication) {
+  const WordRope u(Word({1, 2, 3}));
+  const WordRope v(Word({-3, -2, 4}));
+
+  EXPECT_EQ(Word({1, 4}), (u * v).toWord());
+  EXPECT_EQ(Word(), (u * u.inverse()).toWord());
+  EXPECT_EQ(Word({1, 2, 3}), u.toWord());
+}
+
+TEST(WordRope, LongWords) {
+  const auto gens = iota(0, 10000);
+  const Word w(gens);
+
+  WordRope r(w);
+  EXPECT_EQ(w, r.toWord());
+  EXPECT_LE(r.height(), 10);
+
+  for (size_t i = 0; i < 100; ++i) {
+    r *= WordRope(Word({1, 2}));
+  }
+
+  EXPECT_EQ(10200, r.size());
+  EXPECT_LE(r.height(), 12);
+
+  EXPECT_EQ(w.subword(1234, 5678), r.subword(1234, 5678).toWord());
+  EXPECT_EQ(w.subword(9000, 10000), r.subword(9000, 10000).toWord());
+  EXPECT_EQ(w * (-w), (r.subword(0, 10000) * r.subword(0, 10000).inverse()).toWord());
+}
+
+TEST(WordRope, Insert) {
+  const auto gens = iota(0, 1000);
+
+  WordRope r(gens);
+  auto copy = r;
+
+  r.insert(500, WordRope(std::vector<int>{5, 7}));
+  r.insert(0, WordRope(Word(3)));
+  r.insert(10000, WordRope(Word(-3)));
+
+  auto expected = gens;
+  expected.insert(expected.begin() + 500, {5, 7});
+  expected.insert(expected.begin(), 3);
+  expected.push_back(-3);
+
+  EXPECT_EQ(expected, r.toVector());
+  EXPECT_EQ(gens, copy.toVector());
+
+  r.erase(1, 501);
+  r.erase(r.size() - 1, r.size());
+  expected.erase(expected.begin() + 1, expected.begin() + 501);
+  expected.pop_back();
+
+  EXPECT_EQ(expected, r.toVector());
+}
+
+TEST(WordRope, FreelyReduce) {
+  WordRope r(Word({1, 2, 3}));
+
+  r.insert(1, WordRope(Word({4, 5})));
+  r.insert(3, WordRope(Word({-5, -4})));
+  EXPECT_EQ(7, r.size());
+
+  r.freelyReduce();
+  EXPECT_EQ(WordRope(Word({1, 2, 3})), r);
+}
+} // namespace
@@ -0,0 +1,424 @@
+#pragma once
+
+#ifndef CRAG_FP_H
+#define CRAG_FP_H
+
+#include <boost/random/uniform_int_distribution.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CRAG_FP_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace crag {
+namespace finitefield {
+
+namespace fp {
+
+//! Returns -p^{-1} mod 2^32 for an odd p.
+constexpr std::uint32_t montgomeryInverse(std::uint32_t p) {
+  // Newton's iteration doubles the number of correct bits, p * p == 1 (mod 8) gives the first 3
+  std::uint32_t inverse = p;
+
+  for (int i = 0; i < 4; ++i) {
+    inverse *= 2 - p * inverse;
+  }
+
+  return 0 - inverse;
+}
+
+//! Returns 2^64 mod p.
+constexpr std::uint32_t montgomeryR2(std::uint32_t p) {
+  const std::uint64_t r = (std::uint64_t(1) << 32) % p;
+  return static_cast<std::uint32_t>(r * r % p);
+}
+
+//! Checks if n is prime by trial division (used at compile time, n < 2^31).
+constexpr bool isPrime(int n) {
+  if (n < 2) {
+    return false;
+  }
+
+  if (n % 2 == 0) {
+    return n == 2;
+  }
+
+  for (int d = 3; d <= n / d; d += 2) {
+    if (n % d == 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+#ifdef CRAG_FP_X86_KERNELS
+// The AVX2 kernels are compiled for AVX2 regardless of the compiler flags and are used
+// only if the CPU supports AVX2 (see hasAVX2). Each of them processes the longest prefix
+// of whole blocks of 8 elements and returns its length, the rest is left to the scalar code.
+
+//! Checks (once) if the CPU supports AVX2.
+inline bool hasAVX2() {
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  return has_avx2;
+}
+
+//! Montgomery reduction of the 64-bit lanes of t, the results are in the high halves of the lanes.
+__attribute__((target("avx2")))
+inline __m256i reduce(__m256i t, __m256i p, __m256i p_inverse) {
+  const auto m = _mm256_mul_epu32(t, p_inverse);
+  return _mm256_add_epi64(t, _mm256_mul_epu32(m, p));
+}
+
+//! Returns min(x, x - p) for each lane, i.e., x mod p for x < 2p.
+__attribute__((target("avx2")))
+inline __m256i subtractIfNotLess(__m256i x, __m256i p) {
+  return _mm256_min_epu32(x, _mm256_sub_epi32(x, p));
+}
+
+//! Returns y + a * x / 2^32 mod p for each lane, where a, x, y < p < 2^30.
+__attribute__((target("avx2")))
+inline __m256i multiplyAdd(__m256i a, __m256i x, __m256i y, __m256i p, __m256i p_inverse) {
+  const auto high = _mm256_set1_epi64x(static_cast<long long>(0xffffffff00000000ULL));
+
+  const auto even = _mm256_add_epi64(_mm256_mul_epu32(a, x), _mm256_slli_epi64(y, 32));
+  const auto odd = _mm256_add_epi64(_mm256_mul_epu32(a, _mm256_srli_epi64(x, 32)), _mm256_and_si256(y, high));
+
+  const auto result = _mm256_blend_epi32(
+      _mm256_srli_epi64(reduce(even, p, p_inverse), 32), reduce(odd, p, p_inverse), 0xaa);
+
+  // the result is less than 3p
+  return subtractIfNotLess(subtractIfNotLess(result, p), p);
+}
+
+//! y[i] = y[i] + x[i] mod p.
+__attribute__((target("avx2")))
+inline size_t addRowAVX2(std::uint32_t* y, const std::uint32_t* x, size_t n, std::uint32_t p) {
+  const auto vp = _mm256_set1_epi32(static_cast<int>(p));
+  size_t i = 0;
+
+  for (; i + 8 <= n; i += 8) {
+    const auto vx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+    const auto vy = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(y + i), subtractIfNotLess(_mm256_add_epi32(vy, vx), vp));
+  }
+
+  return i;
+}
+
+//! y[i] = y[i] - x[i] mod p.
+__attribute__((target("avx2")))
+inline size_t subtractRowAVX2(std::uint32_t* y, const std::uint32_t* x, size_t n, std::uint32_t p) {
+  const auto vp = _mm256_set1_epi32(static_cast<int>(p));
+  size_t i = 0;
+
+  for (; i + 8 <= n; i += 8) {
+    const auto vx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+    const auto vy = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i));
+    const auto d = _mm256_sub_epi32(vy, vx);
+
+    // if y < x then d wraps around and d + p is the result
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(y + i), _mm256_min_epu32(d, _mm256_add_epi32(d, vp)));
+  }
+
+  return i;
+}
+
+//! x[i] = a x[i] / 2^32 mod p.
+__attribute__((target("avx2")))
+inline size_t scaleRowAVX2(
+    std::uint32_t* x, std::uint32_t a, size_t n, std::uint32_t p, std::uint32_t p_inverse) {
+  const auto vp = _mm256_set1_epi32(static_cast<int>(p));
+  const auto vp_inverse = _mm256_set1_epi32(static_cast<int>(p_inverse));
+  const auto va = _mm256_set1_epi32(static_cast<int>(a));
+  const auto zero = _mm256_setzero_si256();
+  size_t i = 0;
+
+  for (; i + 8 <= n; i += 8) {
+    const auto vx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(x + i), multiplyAdd(va, vx, zero, vp, vp_inverse));
+  }
+
+  return i;
+}
+
+//! y[i] = y[i] + a x[i] / 2^32 mod p.
+__attribute__((target("avx2")))
+inline size_t addScaledRowAVX2(
+    std::uint32_t* y, const std::uint32_t* x, std::uint32_t a, size_t n, std::uint32_t p, std::uint32_t p_inverse) {
+  const auto vp = _mm256_set1_epi32(static_cast<int>(p));
+  const auto vp_inverse = _mm256_set1_epi32(static_cast<int>(p_inverse));
+  const auto va = _mm256_set1_epi32(static_cast<int>(a));
+  size_t i = 0;
+
+  for (; i + 8 <= n; i += 8) {
+    const auto vx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+    const auto vy = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(y + i), multiplyAdd(va, vx, vy, vp, vp_inverse));
+  }
+
+  return i;
+}
+#endif
+} // namespace fp
+
+//! Element of the prime field ZZ / pZZ for an odd prime p < 2^30, a lean replacement of ZZ<p>.
+/*!
+  The element is stored in the Montgomery form x 2^32 mod p, so multiplication needs no division.
+  Unlike FieldElement<IdealGeneratedByInteger<p>> it has the size of one 32-bit integer, arrays of elements
+  are processed by the row operations addRow, subtractRow, scaleRow and addScaledRow
+  (the overloads of the generic ones from matrix/row_operations.h, found by ADL),
+  which use AVX2 when the CPU supports it (detected at runtime, the code does not need -mavx2).
+*/
+template <int p>
+class Fp {
+  static_assert(p > 2 && fp::isPrime(p), "The modulus must be an odd prime.");
+  static_assert(p < (1 << 30), "The modulus must be less than 2^30.");
+
+public:
+  using RingElement = int;
+
+  Fp()
+      : x_(0) {}
+
+  Fp(RingElement n)
+      : x_(toMontgomery_(n)) {}
+
+  const Fp& operator+=(const Fp& rhs) {
+    x_ = add_(x_, rhs.x_);
+    return *this;
+  }
+
+  const Fp& operator-=(const Fp& rhs) {
+    x_ = subtract_(x_, rhs.x_);
+    return *this;
+  }
+
+  const Fp& operator*=(const Fp& rhs) {
+    x_ = reduce_(std::uint64_t(x_) * rhs.x_);
+    return *this;
+  }
+
+  const Fp& operator/=(const Fp& rhs) {
+    return *this *= rhs.inverse();
+  }
+
+  Fp inverse() const {
+    if (x_ == 0) {
+      throw std::logic_error("Division by zero");
+    }
+
+    // x^(p - 2) == x^(-1) by Fermat's little theorem
+    Fp result(1);
+    Fp x = *this;
+
+    for (auto n = p - 2; n > 0; n >>= 1) {
+      if (n & 1) {
+        result *= x;
+      }
+
+      x *= x;
+    }
+
+    return result;
+  }
+
+  //! Returns the canonical representative in [0, p).
+  RingElement value() const {
+    return static_cast<RingElement>(reduce_(x_));
+  }
+
+  template <typename URNG>
+  static RingElement random(URNG& g) {
+    static boost::random::uniform_int_distribution<int> dist(0, p - 1);
+
+    return dist(g);
+  }
+
+  friend Fp operator+(Fp lhs, const Fp& rhs) {
+    return lhs += rhs;
+  }
+
+  friend Fp operator-(Fp lhs, const Fp& rhs) {
+    return lhs -= rhs;
+  }
+
+  friend Fp operator-(const Fp& elt) {
+    return Fp() -= elt;
+  }
+
+  friend Fp operator*(Fp lhs, const Fp& rhs) {
+    return lhs *= rhs;
+  }
+
+  friend Fp operator/(Fp lhs, const Fp& rhs) {
+    return lhs /= rhs;
+  }
+
+  //! The Montgomery form is canonical, so the stored values are compared.
+  friend bool operator==(const Fp& lhs, const Fp& rhs) {
+    return lhs.x_ == rhs.x_;
+  }
+
+  friend bool operator!=(const Fp& lhs, const Fp& rhs) {
+    return lhs.x_ != rhs.x_;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, const Fp& elt) {
+    return os << elt.value();
+  }
+
+  //! y[i] += x[i] for i < n.
+  friend void addRow(Fp* y, const Fp* x, size_t n) {
+    size_t i = 0;
+
+#ifdef CRAG_FP_X86_KERNELS
+    if (fp::hasAVX2()) {
+      i = fp::addRowAVX2(data_(y), data_(x), n, kP_);
+    }
+#endif
+
+    for (; i < n; ++i) {
+      y[i].x_ = add_(y[i].x_, x[i].x_);
+    }
+  }
+
+  //! y[i] -= x[i] for i < n.
+  friend void subtractRow(Fp* y, const Fp* x, size_t n) {
+    size_t i = 0;
+
+#ifdef CRAG_FP_X86_KERNELS
+    if (fp::hasAVX2()) {
+      i = fp::subtractRowAVX2(data_(y), data_(x), n, kP_);
+    }
+#endif
+
+    for (; i < n; ++i) {
+      y[i].x_ = subtract_(y[i].x_, x[i].x_);
+    }
+  }
+
+  //! x[i] *= a for i < n.
+  friend void scaleRow(Fp* x, const Fp& a, size_t n) {
+    size_t i = 0;
+
+#ifdef CRAG_FP_X86_KERNELS
+    if (fp::hasAVX2()) {
+      i = fp::scaleRowAVX2(data_(x), a.x_, n, kP_, kInverse_);
+    }
+#endif
+
+    for (; i < n; ++i) {
+      x[i] *= a;
+    }
+  }
+
+  //! y[i] += a * x[i] for i < n, each sum is reduced once.
+  friend void addScaledRow(Fp* y, const Fp* x, const Fp& a, size_t n) {
+    size_t i = 0;
+
+#ifdef CRAG_FP_X86_KERNELS
+    if (fp::hasAVX2()) {
+      i = fp::addScaledRowAVX2(data_(y), data_(x), a.x_, n, kP_, kInverse_);
+    }
+#endif
+
+    for (; i < n; ++i) {
+      y[i].x_ = multiplyAdd_(a.x_, x[i].x_, y[i].x_);
+    }
+  }
+
+private:
+  static constexpr std::uint32_t kP_ = p;
+  static constexpr std::uint32_t kInverse_ = fp::montgomeryInverse(p);
+  static constexpr std::uint32_t kR2_ = fp::montgomeryR2(p);
+
+  //! x 2^32 mod p
+  std::uint32_t x_;
+
+  //! An array of elements is an array of their Montgomery forms.
+  static std::uint32_t* data_(Fp* x) {
+    return reinterpret_cast<std::uint32_t*>(x);
+  }
+
+  static const std::uint32_t* data_(const Fp* x) {
+    return reinterpret_cast<const std::uint32_t*>(x);
+  }
+
+  //! Returns t / 2^32 mod p for t < p 2^32.
+  static std::uint32_t reduce_(std::uint64_t t) {
+    const std::uint32_t m = static_cast<std::uint32_t>(t) * kInverse_;
+    return subtractIfNotLess_(static_cast<std::uint32_t>((t + std::uint64_t(m) * kP_) >> 32));
+  }
+
+  //! Returns y + a x / 2^32 mod p with one reduction, where a, x, y < p.
+  static std::uint32_t multiplyAdd_(std::uint32_t a, std::uint32_t x, std::uint32_t y) {
+    // y is lifted to y 2^32, the sum is less than p^2 + p 2^32, so the reduced value is less than 3p
+    const std::uint64_t t = std::uint64_t(a) * x + (std::uint64_t(y) << 32);
+    const std::uint32_t m = static_cast<std::uint32_t>(t) * kInverse_;
+    return subtractIfNotLess_(subtractIfNotLess_(static_cast<std::uint32_t>((t + std::uint64_t(m) * kP_) >> 32)));
+  }
+
+  //! Returns x mod p for x < 2p without branching (x - p wraps around if x < p), as the AVX2 code does.
+  static std::uint32_t subtractIfNotLess_(std::uint32_t x) {
+    return std::min(x, x - kP_);
+  }
+
+  static std::uint32_t add_(std::uint32_t x, std::uint32_t y) {
+    return subtractIfNotLess_(x + y);
+  }
+
+  static std::uint32_t subtract_(std::uint32_t x, std::uint32_t y) {
+    const auto difference = x - y;
+    return std::min(difference, difference + kP_);
+  }
+
+  static std::uint32_t toMontgomery_(RingElement n) {
+    auto m = n % p;
+
+    if (m < 0) {
+      m += p;
+    }
+
+    return reduce_(std::uint64_t(m) * kR2_);
+  }
+};
+
+template <int p>
+constexpr std::uint32_t Fp<p>::kP_;
+
+template <int p>
+constexpr std::uint32_t Fp<p>::kInverse_;
+
+template <int p>
+constexpr std::uint32_t Fp<p>::kR2_;
+
+template <int p>
+Fp<p> pwr(Fp<p> x, int n) {
+  if (n < 0) {
+    x = x.inverse();
+    n = -n;
+  }
+
+  Fp<p> y(1);
+
+  for (; n > 0; n >>= 1) {
+    if (n & 1) {
+      y *= x;
+    }
+
+    x *= x;
+  }
+
+  return y;
+}
+} // namespace finitefield
+} // namespace crag
+
+#endif // CRAG_FP_H
@@ -0,0 +1,396 @@
+#pragma once
+
+#ifndef CRAG_GF2K_H
+#define CRAG_GF2K_H
+
+#include <boost/random/uniform_int_distribution.hpp>
+
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace crag {
+namespace finitefield {
+
+namespace gf2k {
+
+//! Product of a and b in GF(2)[x] reduced modulo the polynomial of degree k given by its bit mask.
+inline std::uint32_t multiply(std::uint32_t a, std::uint32_t b, int k, std::uint32_t modulus) {
+  std::uint64_t product = 0;
+
+  for (std::uint64_t shifted = a; b != 0; b >>= 1, shifted <<= 1) {
+    if (b & 1) {
+      product ^= shifted;
+    }
+  }
+
+  for (int i = 2 * k - 2; i >= k; --i) {
+    if ((product >> i) & 1) {
+      product ^= static_cast<std::uint64_t>(modulus) << (i - k);
+    }
+  }
+
+  return static_cast<std::uint32_t>(product);
+}
+
+inline std::uint32_t power(std::uint32_t a, std::uint64_t p, int k, std::uint32_t modulus) {
+  std::uint32_t result = 1;
+
+  for (; p != 0; p >>= 1) {
+    if (p & 1) {
+      result = multiply(result, a, k, modulus);
+    }
+
+    a = multiply(a, a, k, modulus);
+  }
+
+  return result;
+}
+
+//! Finds an element of order 2^k - 1, throws if there is none (i.e., if the modulus is reducible).
+inline std::uint32_t findGenerator(int k, std::uint32_t modulus) {
+  const std::uint64_t order = (std::uint64_t(1) << k) - 1;
+
+  std::vector<std::uint64_t> prime_divisors;
+  auto rest = order;
+
+  for (std::uint64_t q = 2; q * q <= rest; ++q) {
+    if (rest % q == 0) {
+      prime_divisors.push_back(q);
+
+      while (rest % q == 0) {
+        rest /= q;
+      }
+    }
+  }
+
+  if (rest > 1) {
+    prime_divisors.push_back(rest);
+  }
+
+  for (std::uint64_t g = 2; g <= order; ++g) {
+    const auto candidate = static_cast<std::uint32_t>(g);
+
+    if (power(candidate, order, k, modulus) != 1) {
+      continue;
+    }
+
+    bool is_generator = true;
+
+    for (const auto q : prime_divisors) {
+      if (power(candidate, order / q, k, modulus) == 1) {
+        is_generator = false;
+        break;
+      }
+    }
+
+    if (is_generator) {
+      return candidate;
+    }
+  }
+
+  // an element of order 2^k - 1 exists iff the quotient ring is a field
+  if (k == 1) {
+    return 1;
+  }
+
+  throw std::invalid_argument("The modulus is not irreducible.");
+}
+
+//! Degree of a polynomial given by its bit mask, -1 for the zero polynomial.
+inline int degree(std::uint64_t a) {
+  int result = -1;
+
+  for (; a != 0; a >>= 1) {
+    ++result;
+  }
+
+  return result;
+}
+
+//! Greatest common divisor of two polynomials in GF(2)[x] given by their bit masks.
+inline std::uint64_t gcd(std::uint64_t a, std::uint64_t b) {
+  while (b != 0) {
+    const auto b_degree = degree(b);
+
+    for (auto shift = degree(a) - b_degree; shift >= 0; shift = degree(a) - b_degree) {
+      a ^= b << shift;
+    }
+
+    std::swap(a, b);
+  }
+
+  return a;
+}
+
+//! Rabin's test: m of degree k is irreducible iff x^(2^k) = x (mod m) and gcd(x^(2^(k/q)) - x, m) = 1
+//! for all prime divisors q of k. Takes O(k) multiplications, so it is used for the fields without tables.
+inline bool isIrreducible(int k, std::uint32_t modulus) {
+  if (k == 1) {
+    return true;
+  }
+
+  // x^(2^i) mod m for i = 0,...,k
+  std::vector<std::uint32_t> powers(1, 2);
+
+  for (int i = 0; i < k; ++i) {
+    powers.push_back(multiply(powers.back(), powers.back(), k, modulus));
+  }
+
+  if (powers[k] != 2) {
+    return false;
+  }
+
+  auto rest = k;
+
+  for (int q = 2; q <= rest; ++q) {
+    if (rest % q != 0) {
+      continue;
+    }
+
+    while (rest % q == 0) {
+      rest /= q;
+    }
+
+    if (gcd(modulus, powers[k / q] ^ 2) != 1) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//! Logarithm and antilogarithm tables of GF(2^k) with respect to a generator.
+struct LogTables {
+  LogTables(int k, std::uint32_t modulus)
+      : order((std::uint32_t(1) << k) - 1)
+      , log(order + 1, 0)
+      , exp(2 * order, 0) {
+    const auto g = findGenerator(k, modulus);
+
+    std::uint32_t x = 1;
+
+    for (std::uint32_t i = 0; i < order; ++i) {
+      exp[i] = exp[i + order] = x;
+      log[x] = i;
+      x = multiply(x, g, k, modulus);
+    }
+  }
+
+  std::uint32_t order;
+  std::vector<std::uint32_t> log;
+
+  //! exp[i] = g^i for 0 <= i < 2 (2^k - 1), so the sum of two logarithms needs no reduction.
+  std::vector<std::uint32_t> exp;
+};
+} // namespace gf2k
+
+//! Element of the field GF(2^k) = GF(2)[x] / (m(x)), where m is an irreducible polynomial of degree k.
+/*!
+  The element is stored as the bit mask of the coefficients of its canonical representative (bit i for x^i),
+  and m is given by its bit mask too, e.g., GF2k<8, 0x11b> is GF(2^8) with m(x) = x^8 + x^4 + x^3 + x + 1.
+  It can be used in place of FieldElement<IdealGeneratedByPolynomial<ZZ<2>, ...>>: integers are converted
+  to elements of the prime subfield (i.e., taken mod 2), the elements are created by bit masks with fromBits.
+
+  For k <= 16 multiplication and inversion use logarithm tables, which are built on the first use;
+  for larger k (up to 31) they use carry-less multiplication with reduction.
+  In both cases the modulus is checked to be irreducible on the first use (std::invalid_argument is thrown otherwise).
+*/
+template <int k, std::uint32_t modulus>
+class GF2k {
+  static_assert(0 < k && k < 32, "Degree of the field must be in [1, 31].");
+  static_assert((modulus >> k) == 1, "Degree of the modulus must be k.");
+
+public:
+  using RingElement = int;
+
+  static const int kDegree = k;
+
+  GF2k()
+      : n_(0) {}
+
+  //! Creates the image of an integer, i.e., n mod 2.
+  GF2k(RingElement n)
+      : n_(n % 2 != 0) {}
+
+  //! Creates an element by the coefficients of a polynomial (the constant term first), as FieldElement does.
+  GF2k(std::initializer_list<int> coefficients)
+      : n_(0) {
+    std::uint32_t bit = 1;
+    std::uint32_t bits = 0;
+
+    for (const auto c : coefficients) {
+      if (c % 2 != 0) {
+        bits ^= bit;
+      }
+
+      bit = multiply_(bit, 2);
+    }
+
+    n_ = bits;
+  }
+
+  //! Creates an element by the bit mask of a polynomial (reduced modulo the modulus).
+  static GF2k fromBits(std::uint32_t bits) {
+    GF2k result;
+    result.n_ = reduce_(bits);
+
+    return result;
+  }
+
+  const GF2k& operator+=(const GF2k& rhs) {
+    n_ ^= rhs.n_;
+    return *this;
+  }
+
+  const GF2k& operator-=(const GF2k& rhs) {
+    n_ ^= rhs.n_;
+    return *this;
+  }
+
+  const GF2k& operator*=(const GF2k& rhs) {
+    n_ = multiply_(n_, rhs.n_);
+    return *this;
+  }
+
+  const GF2k& operator/=(const GF2k& rhs) {
+    return *this *= rhs.inverse();
+  }
+
+  GF2k inverse() const {
+    if (n_ == 0) {
+      throw std::logic_error("Division by zero");
+    }
+
+    GF2k result;
+
+    if (k <= 16) {
+      const auto& tables = tables_();
+      result.n_ = tables.exp[tables.order - tables.log[n_]];
+    } else {
+      checkModulus_();
+      result.n_ = gf2k::power(n_, (std::uint64_t(1) << k) - 2, k, modulus);
+    }
+
+    return result;
+  }
+
+  //! Returns the bit mask of the canonical representative.
+  std::uint32_t value() const {
+    return n_;
+  }
+
+  template <typename URNG>
+  static GF2k random(URNG& g) {
+    static boost::random::uniform_int_distribution<std::uint32_t> dist(0, (std::uint32_t(1) << k) - 1);
+
+    return fromBits(dist(g));
+  }
+
+  friend GF2k operator+(GF2k lhs, const GF2k& rhs) {
+    return lhs += rhs;
+  }
+
+  friend GF2k operator-(GF2k lhs, const GF2k& rhs) {
+    return lhs -= rhs;
+  }
+
+  //! In characteristic 2 every element is its own negative.
+  friend GF2k operator-(const GF2k& elt) {
+    return elt;
+  }
+
+  friend GF2k operator*(GF2k lhs, const GF2k& rhs) {
+    return lhs *= rhs;
+  }
+
+  friend GF2k operator/(GF2k lhs, const GF2k& rhs) {
+    return lhs /= rhs;
+  }
+
+  friend bool operator==(const GF2k& lhs, const GF2k& rhs) {
+    return lhs.n_ == rhs.n_;
+  }
+
+  friend bool operator!=(const GF2k& lhs, const GF2k& rhs) {
+    return lhs.n_ != rhs.n_;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, const GF2k& elt) {
+    return os << elt.n_;
+  }
+
+private:
+  std::uint32_t n_;
+
+  static const gf2k::LogTables& tables_() {
+    static const gf2k::LogTables tables(k, modulus);
+    return tables;
+  }
+
+  //! Throws if the modulus is reducible, the check is done once (the tables do it for k <= 16).
+  static void checkModulus_() {
+    static const bool is_irreducible = gf2k::isIrreducible(k, modulus);
+
+    if (!is_irreducible) {
+      throw std::invalid_argument("The modulus is not irreducible.");
+    }
+  }
+
+  static std::uint32_t reduce_(std::uint32_t n) {
+    for (int i = 31; i >= k; --i) {
+      if ((n >> i) & 1) {
+        n ^= modulus << (i - k);
+      }
+    }
+
+    return n;
+  }
+
+  static std::uint32_t multiply_(std::uint32_t a, std::uint32_t b) {
+    if (k > 16) {
+      checkModulus_();
+      return gf2k::multiply(a, b, k, modulus);
+    }
+
+    if (a == 0 || b == 0) {
+      return 0;
+    }
+
+    const auto& tables = tables_();
+    return tables.exp[tables.log[a] + tables.log[b]];
+  }
+};
+
+template <int k, std::uint32_t modulus>
+GF2k<k, modulus> pwr(GF2k<k, modulus> x, int n) {
+  if (n < 0) {
+    x = x.inverse();
+    n = -n;
+  }
+
+  GF2k<k, modulus> y(1);
+
+  for (; n > 0; n >>= 1) {
+    if (n & 1) {
+      y *= x;
+    }
+
+    x *= x;
+  }
+
+  return y;
+}
+
+//! GF(2^5) with m(x) = x^5 + x^2 + 1.
+using GF32 = GF2k<5, 0x25>;
+
+//! GF(2^8) with m(x) = x^8 + x^4 + x^3 + x + 1.
+using GF256 = GF2k<8, 0x11b>;
+} // namespace finitefield
+} // namespace crag
+
+#endif // CRAG_GF2K_H
@@ -2,6 +2,9 @@
 
 #include "FiniteField.h"
 
+#include "Fp.h"
+#include "GF2k.h"
+
 namespace crag {
 namespace finitefield {
 namespace {
@@ -61,6 +64,226 @@ TEST(FiniteField, RandomTest2) {
 
   EXPECT_EQ(GF256({1, 1, 1, 0, 1, 0, 1, 1, 1}), GF256::random(g));
 }
+TEST(FiniteField, GF2kTest1) {
+  using GF = finitefield::GF256;
+
+  const GF zero(0);
+  const GF one(1);
+  const GF a({1, 1, 0, 0, 1, 0, 1});
+  const GF b({0, 1, 0, 1, 0, 0, 1, 1});
+  const GF c({1, 1});
+  const GF d({1, 0, 1});
+
+  EXPECT_EQ(zero, one + one);
+  EXPECT_EQ(one, -one);
+  EXPECT_EQ(one, a * b);
+  EXPECT_EQ(b, pwr(a, -1));
+  EXPECT_EQ(d, pwr(c, 2));
+  EXPECT_EQ(b, one / a);
+  EXPECT_THROW(a / zero, std::logic_error);
+
+  // integers are taken mod 2, as in FieldElement over ZZ<2>
+  EXPECT_EQ(zero, GF(2));
+  EXPECT_EQ(one, GF(-1));
+  EXPECT_EQ(one, GF(3));
+
+  // bit masks are reduced modulo the modulus
+  EXPECT_EQ(c, GF::fromBits(3));
+  EXPECT_EQ(zero, GF::fromBits(0x11b));
+  EXPECT_EQ(one, GF::fromBits(0x11a));
+}
+
+//! Returns the element of the polynomial field with the coefficients given by a bit mask.
+template <typename Field>
+Field fromBits(std::uint32_t bits) {
+  std::vector<ZZ<2>> coefficients;
+
+  for (; bits != 0; bits >>= 1) {
+    coefficients.push_back(ZZ<2>(static_cast<int>(bits & 1)));
+  }
+
+  return Field(typename Field::RingElement(coefficients.begin(), coefficients.end()));
+}
+
+TEST(FiniteField, GF2kTest2) {
+  // the same field as FieldElement over polynomials
+  using GF = finitefield::GF256;
+  using PolynomialGF256 = FieldElement<IdealGeneratedByPolynomial<ZZ<2>, 1, 1, 0, 1, 1, 0, 0, 0, 1>>;
+
+  std::mt19937 g(0);
+
+  for (std::uint32_t a = 0; a < 256; ++a) {
+    const auto b = GF::random(g);
+
+    EXPECT_EQ(fromBits<PolynomialGF256>(a) * fromBits<PolynomialGF256>(b.value()), fromBits<PolynomialGF256>((GF::fromBits(a) * b).value()));
+    EXPECT_EQ(fromBits<PolynomialGF256>(a) + fromBits<PolynomialGF256>(b.value()), fromBits<PolynomialGF256>((GF::fromBits(a) + b).value()));
+
+    if (a != 0) {
+      EXPECT_EQ(fromBits<PolynomialGF256>(a).inverse(), fromBits<PolynomialGF256>(GF::fromBits(a).inverse().value()));
+    }
+  }
+}
+
+TEST(FiniteField, GF2kTest3) {
+  // x^20 + x^3 + 1, no tables
+  using GF = GF2k<20, 0x100009>;
+  // x^16 + x^5 + x^3 + x^2 + 1
+  using GF16 = GF2k<16, 0x1002d>;
+
+  std::mt19937 g(0);
+
+  for (size_t i = 0; i < 100; ++i) {
+    const GF a = generateNonZeroNonUnit<GF>(g);
+    const GF b = GF::random(g);
+    const GF c = GF::random(g);
+
+    EXPECT_EQ(GF(1), a * a.inverse());
+    EXPECT_EQ(a * (b + c), a * b + a * c);
+    EXPECT_EQ(b, b * a / a);
+
+    const GF16 x = generateNonZeroNonUnit<GF16>(g);
+    EXPECT_EQ(GF16(1), x * x.inverse());
+    EXPECT_EQ(pwr(x, 5), x * x * x * x * x);
+  }
+}
+
+TEST(FiniteField, GF2kReducible) {
+  // x^4 + x^2 + 1 = (x^2 + x + 1)^2
+  using GF = GF2k<4, 0x15>;
+
+  EXPECT_THROW(GF::fromBits(2) * GF::fromBits(3), std::invalid_argument);
+
+  // x^20 + x^6 + 1 = (x^10 + x^3 + 1)^2, no tables
+  using GF20 = GF2k<20, 0x100041>;
+
+  EXPECT_THROW(GF20::fromBits(2) * GF20::fromBits(3), std::invalid_argument);
+  EXPECT_THROW(GF20::fromBits(2).inverse(), std::invalid_argument);
+
+  // x^5 + x^4 + 1 = (x^2 + x + 1)(x^3 + x + 1) has no roots
+  EXPECT_FALSE(gf2k::isIrreducible(5, 0x31));
+  EXPECT_TRUE(gf2k::isIrreducible(5, 0x25));
+  EXPECT_TRUE(gf2k::isIrreducible(20, 0x100009));
+  EXPECT_TRUE(gf2k::isIrreducible(8, 0x11b));
+}
+
+TEST(FiniteField, FpTest1) {
+  using F5 = Fp<5>;
+
+  const F5 zero(0);
+  const F5 one(1);
+  const F5 two(2);
+  const F5 three(3);
+  const F5 four(4);
+
+  EXPECT_NE(zero, one);
+  EXPECT_EQ(one, two * three);
+  EXPECT_EQ(two, three + four);
+  EXPECT_EQ(four, three - four);
+  EXPECT_EQ(one, -four);
+  EXPECT_EQ(four, F5(-6));
+  EXPECT_EQ(two, one / three);
+  EXPECT_EQ(two, pwr(three, -1));
+  EXPECT_EQ(two, pwr(three, 11));
+  EXPECT_EQ(3, three.value());
+  EXPECT_THROW(one / zero, std::logic_error);
+}
+
+template <int p>
+void testFpArithmetic(std::mt19937& g) {
+  const auto mod = [](long long n) { return static_cast<int>((n % p + p) % p); };
+
+  for (size_t i = 0; i < 1000; ++i) {
+    const auto x = Fp<p>::random(g);
+    const auto y = Fp<p>::random(g) - p / 2;
+
+    EXPECT_EQ(mod((long long)x + y), (Fp<p>(x) + Fp<p>(y)).value());
+    EXPECT_EQ(mod((long long)x - y), (Fp<p>(x) - Fp<p>(y)).value());
+    EXPECT_EQ(mod((long long)x * y), (Fp<p>(x) * Fp<p>(y)).value());
+
+    if (y != 0) {
+      EXPECT_EQ(Fp<p>(x), Fp<p>(x) / Fp<p>(y) * Fp<p>(y));
+    }
+  }
+}
+
+TEST(FiniteField, FpIsPrime) {
+  static_assert(fp::isPrime(1237), "");
+  static_assert(fp::isPrime(1073741789), "");
+  static_assert(!fp::isPrime(1), "");
+  static_assert(!fp::isPrime(9), "");
+  static_assert(!fp::isPrime(1073741787), "");
+
+  std::vector<int> primes;
+  for (int n = 0; n < 30; ++n) {
+    if (fp::isPrime(n)) {
+      primes.push_back(n);
+    }
+  }
+  EXPECT_EQ(std::vector<int>({2, 3, 5, 7, 11, 13, 17, 19, 23, 29}), primes);
+}
+
+TEST(FiniteField, FpTest2) {
+  std::mt19937 g(0);
+
+  testFpArithmetic<3>(g);
+  testFpArithmetic<1237>(g);
+  testFpArithmetic<65521>(g);
+  testFpArithmetic<1073741789>(g);
+}
+
+TEST(FiniteField, FpRandom) {
+  std::mt19937 g1(1233);
+  std::mt19937 g2(1233);
+
+  // the same t-values are generated for Fp<p> and ZZ<p>
+  for (size_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(ZZ<1237>::random(g1), Fp<1237>::random(g2));
+  }
+}
+
+template <int p>
+void testFpRows(std::mt19937& g) {
+  using F = Fp<p>;
+
+  // lengths not divisible by the vector width
+  for (const size_t n : {1, 7, 8, 17, 64}) {
+    std::vector<F> x;
+    std::vector<F> y;
+
+    for (size_t i = 0; i < n; ++i) {
+      x.push_back(F::random(g));
+      y.push_back(F::random(g));
+    }
+
+    const F a = F::random(g);
+
+    auto sum = y;
+    auto difference = y;
+    auto scaled = y;
+    auto combination = y;
+
+    addRow(sum.data(), x.data(), n);
+    subtractRow(difference.data(), x.data(), n);
+    scaleRow(scaled.data(), a, n);
+    addScaledRow(combination.data(), x.data(), a, n);
+
+    for (size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(y[i] + x[i], sum[i]);
+      EXPECT_EQ(y[i] - x[i], difference[i]);
+      EXPECT_EQ(y[i] * a, scaled[i]);
+      EXPECT_EQ(y[i] + a * x[i], combination[i]);
+    }
+  }
+}
+
+TEST(FiniteField, FpRows) {
+  std::mt19937 g(0);
+
+  testFpRows<3>(g);
+  testFpRows<1237>(g);
+  testFpRows<1000000007>(g);
+  testFpRows<1073741789>(g);
+}
 } // namespace
 } // namespace finitefield
 } // namespace crag
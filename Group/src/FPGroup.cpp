@@ -9,7 +9,7 @@
 
 #include "RanlibCPP.h"
 #include "FPGroup.h"
-#include "BalancedTree.h"
+#include "WordRope.h"
 #include "errormsgs.h"
 
 #include <set>
@@ -133,11 +133,11 @@ FPGroup FPGroup::triangulatePresentation( ) const
 
 Word FPGroup::randomEqWord_Baltimore( const Word& w , int length , float conj_param ) const
 {
-  BalancedTree< int > BT( w.begin( ), w.end( ) );
+  WordRope R( w );
   
-  while( BT.size( )<length ) {
+  while( R.size( )<length ) {
     
-    int pos = RandLib::ur.irand( 0 , BT.size( ) );
+    int pos = RandLib::ur.irand( 0 , R.size( ) );
 
     int conj_length = 0;
     for( ; RandLib::ur.rand()<conj_param ; ++conj_length );
@@ -148,10 +148,10 @@ Word FPGroup::randomEqWord_Baltimore( const Word& w , int length , float conj_pa
     rel.cyclicallyPermute( RandLib::ur.irand( 0 , rel.length( )-1 ) );
 
     Word to_insert = -conjugator * rel * conjugator;
-    BT.insert( pos , to_insert.begin() , to_insert.end( ) );
+    R.insert( pos , WordRope( to_insert ) );
   }
   
-  return Word( BT.getList( ) );
+  return R.toWord( );
 }
 
 
@@ -8,33 +8,37 @@
 
 #include "kayawood.h"
 
+#include "Fp.h"
+#include "GF2k.h"
 #include "LinkedBraidStructure.h"
 #include "ThLeftNormalForm.h"
+#include "batch_identity_check.h"
 #include "braid_group.h"
-#include "fast_identity_check.h"
 
 namespace crag {
 namespace kayawood {
 
-//! Checks if u \in B_n commutes with each w in words.
-static bool doesCommuteWithTuple(size_t n, const Word& u, const std::vector<Word>& words) {
-  static const crag::braidgroup::FastIdentityChecker<finitefield::ZZ<1237>> checker(n);
-
-  for (const auto& w : words) {
-    const auto commutator = w * u * -w * -u;
+//! Shared checker of commutator triviality (the first n passed to it determines the rank).
+static const crag::braidgroup::BatchIdentityChecker<finitefield::Fp<1237>>& commutatorChecker(size_t n) {
+  static const crag::braidgroup::BatchIdentityChecker<finitefield::Fp<1237>> checker(n);
+  return checker;
+}
 
-    // quick fast check first
-    if (checker.isNonTrivial(commutator)) {
-      return false;
-    }
+//! Returns the commutators [w, u] for all w in words.
+static std::vector<Word> commutators(const Word& u, const std::vector<Word>& words) {
+  std::vector<Word> result;
+  result.reserve(words.size());
 
-    // complete check
-    if (!isTrivialBraid(n, commutator)) {
-      return false;
-    }
+  for (const auto& w : words) {
+    result.push_back(w * u * -w * -u);
   }
 
-  return true;
+  return result;
+}
+
+//! Checks if u \in B_n commutes with each w in words.
+static bool doesCommuteWithTuple(size_t n, const Word& u, const std::vector<Word>& words) {
+  return commutatorChecker(n).areAllTrivial(commutators(u, words));
 }
 
 //! Computes the total length of all words.
@@ -272,8 +276,15 @@ Word reduce(size_t n, size_t a, size_t b, const Word& w, const std::vector<Word>
     // 2. Find all flips
     const auto flips = availableFlips<Stabilizer>(n, a, b, w1);
 
-    const auto tuple_commute = parallel::bmap(
-        flips, [&](const std::pair<size_t, Word>& p) { return doesCommuteWithTuple(n, p.second, betas_conjugates); });
+    // all commutators of all flips are checked as one batch
+    std::vector<std::vector<Word>> flips_commutators;
+    flips_commutators.reserve(flips.size());
+
+    for (const auto& p : flips) {
+      flips_commutators.push_back(commutators(p.second, betas_conjugates));
+    }
+
+    const auto tuple_commute = commutatorChecker(n).areAllTrivial(flips_commutators);
 
     if (!flips.empty()) {
       cout << "Deltas: ";
@@ -483,9 +494,8 @@ bool attack(const ProtocolInstance<T>& instance, URNG& g) {
   return true;
 }
 
-using GF32 = finitefield::FieldElement<finitefield::IdealGeneratedByPolynomial<finitefield::ZZ<2>, 1, 0, 1, 0, 0, 1>>;
-using GF256 =
-    finitefield::FieldElement<finitefield::IdealGeneratedByPolynomial<finitefield::ZZ<2>, 1, 1, 0, 1, 1, 0, 0, 0, 1>>;
+using GF32 = finitefield::GF32;
+using GF256 = finitefield::GF256;
 
 template <typename Stabilizer = StabilizerSquare>
 Protocol<GF32, GarsideDehornoyObfuscator, StochasticRewriteObfuscator, Stabilizer>
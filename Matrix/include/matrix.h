@@ -3,106 +3,128 @@
 #ifndef CRAG_MATRIX_H
 #define CRAG_MATRIX_H
 
+#include <algorithm>
 #include <ostream>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
-#include <algorithm>
+
+#include "parallel.h"
+#include "row_operations.h"
 
 namespace crag {
 namespace matrix {
 
+//! Checks if the arithmetic of T is exact, only then Strassen's algorithm is used for products of matrices over T.
+/*!
+  Specialize it for inexact types other than the standard floating point ones.
+*/
+template <typename T>
+struct IsExactRing : std::integral_constant<bool, !std::is_floating_point<T>::value> {};
+
 //! Plain template matrix over (discrete) ring
+/*!
+  The entries are stored row-major in one contiguous buffer, the row i starts at i * size2().
+
+  Products are computed by rows: the i-th row of A B is the sum of the rows of B scaled by A(i, k),
+  the loops are blocked so that a block of rows of B stays in cache while it is added to a block of rows of A B.
+  Square matrices of even size at least kStrassenThreshold over exact rings are multiplied
+  by Strassen's algorithm (7 products of halves instead of 8). See also multiplyParallel.
+*/
 template <typename T>
 class Matrix {
 public:
+  //! Number of rows (and of the summands of the rows) in a block of the product.
+  static const size_t kBlockSize = 128;
+
+  //! Number of columns in a block of the product.
+  static const size_t kBlockColumns = 1024;
+
+  //! Minimal size of square matrices multiplied by Strassen's algorithm.
+  static const size_t kStrassenThreshold = 128;
+
   Matrix() = delete;
 
   //! Creates (n, n) matrix filled with T(0)
   explicit Matrix(size_t n)
-      : rows_(n, std::vector<T>(n, T(0))) {
-    if (n == 0) {
-      throw std::invalid_argument("Dimensions of the matrix must be non zero.");
-    }
-  }
+      : Matrix(std::make_pair(n, n), T(0)) {}
 
   //! Creates (n, n) matrix filled with value
   Matrix(size_t n, const T& value)
-      : rows_(n, std::vector<T>(n, value)) {
-    if (n == 0) {
-      throw std::invalid_argument("Dimensions of the matrix must be non zero.");
-    }
-  }
+      : Matrix(std::make_pair(n, n), value) {}
 
   //! Creates (n, n) matrix filled with values
   Matrix(size_t n, const std::vector<T>& values)
-      : rows_(toRows_(n, n, values)) {
-    if (n == 0) {
-      throw std::invalid_argument("Dimensions of the matrix must be non zero.");
-    }
-  }
+      : Matrix(std::make_pair(n, n), values) {}
 
   //! Creates (n, m) matrix filled with T(0)
   explicit Matrix(std::pair<size_t, size_t> size)
-      : rows_(size.first, std::vector<T>(size.second, T(0))) {
-    if ((size.first == 0) || (size.second == 0)) {
-      throw std::invalid_argument("Dimensions of the matrix must be non zero.");
-    }
-  }
+      : Matrix(size, T(0)) {}
 
   //! Creates (n, m) matrix filled with value
   Matrix(std::pair<size_t, size_t> size, const T& value)
-      : rows_(size.first, std::vector<T>(size.second, value)) {
+      : rows_(size.first)
+      , columns_(size.second) {
     if ((size.first == 0) || (size.second == 0)) {
       throw std::invalid_argument("Dimensions of the matrix must be non zero.");
     }
+
+    values_.assign(rows_ * columns_, value);
   }
 
   //! Creates (n, m) matrix filled with values
   Matrix(std::pair<size_t, size_t> size, const std::vector<T>& values)
-      : rows_(toRows_(size.first, size.second, values)) {
+      : rows_(size.first)
+      , columns_(size.second)
+      , values_(values) {
     if ((size.first == 0) || (size.second == 0)) {
       throw std::invalid_argument("Dimensions of the matrix must be non zero.");
     }
+
+    if ((rows_ * columns_) != values_.size()) {
+      throw std::invalid_argument("Dimensions of the matrix doesn't match the number of values provided.");
+    }
   }
 
   //! Returns the number of rows
   size_t size1() const {
-    return rows_.size();
+    return rows_;
   }
 
   //! Returns the number of columns
   size_t size2() const {
-    return rows_.front().size();
+    return columns_;
   }
 
   //! Exchanges the content of matrices
   void swap(Matrix& other) {
     std::swap(rows_, other.rows_);
+    std::swap(columns_, other.columns_);
+    std::swap(values_, other.values_);
   }
 
   T& operator()(size_t i, size_t j) {
-    return rows_[i][j];
+    return values_[i * columns_ + j];
   }
 
   const T& operator()(size_t i, size_t j) const {
-    return rows_[i][j];
+    return values_[i * columns_ + j];
   }
 
-  bool operator==(const Matrix& other) const {
-    if ((size1() != other.size1()) || (size2() != other.size2())) {
-      return false;
-    }
+  //! Returns the i-th row, i.e., size2() contiguous entries.
+  T* row(size_t i) {
+    return values_.data() + i * columns_;
+  }
 
-    for (size_t i = 0; i < size1(); ++i) {
-      for (size_t j = 0; j < size2(); ++j) {
-        if (rows_[i][j] != other.rows_[i][j]) {
-          return false;
-        }
-      }
-    }
+  const T* row(size_t i) const {
+    return values_.data() + i * columns_;
+  }
 
-    return true;
+  bool operator==(const Matrix& other) const {
+    return (size1() == other.size1()) && (size2() == other.size2()) && (values_ == other.values_);
   }
 
   bool operator!=(const Matrix& other) const {
@@ -110,7 +132,7 @@ public:
   }
 
   bool operator==(const T& val) const {
-    return (size1() == 1) && (size2() == 1) && (rows_[0][0] == val);
+    return (size1() == 1) && (size2() == 1) && (values_[0] == val);
   }
 
   bool operator!=(const T& val) const {
@@ -118,41 +140,16 @@ public:
   }
 
   Matrix& operator*=(const T& coef) {
-    for (size_t i = 0; i < size1(); ++i) {
-      for (size_t j = 0; j < size2(); ++j) {
-        rows_[i][j] *= coef;
-      }
-    }
+    scaleRow(values_.data(), coef, values_.size());
 
     return *this;
   }
 
   Matrix& operator*=(const Matrix& other) {
-    if ((size1() != other.size1()) || (size2() != other.size2())) {
-      throw std::invalid_argument("Dimensions of matrices don't match.");
-    }
-
-    std::vector<std::vector<T>> new_rows;
-    new_rows.reserve(size1());
-
-    for (size_t i = 0; i < size1(); ++i) {
-      std::vector<T> row;
-      row.reserve(other.size2());
-
-      for (size_t j = 0; j < other.size2(); ++j) {
-        T m_ij = rows_[i][0] * other.rows_[0][j];
-
-        for (size_t k = 1; k < size2(); ++k) {
-          m_ij += rows_[i][k] * other.rows_[k][j];
-        }
-
-        row.push_back(std::move(m_ij));
-      }
-
-      new_rows.push_back(std::move(row));
-    }
+    checkProductDimensions_(other);
 
-    rows_ = std::move(new_rows);
+    auto result = product_(*this, other);
+    swap(result);
 
     return *this;
   }
@@ -162,11 +159,7 @@ public:
       throw std::invalid_argument("Dimensions of matrices don't match.");
     }
 
-    for (size_t i = 0; i < size1(); ++i) {
-      for (size_t j = 0; j < size2(); ++j) {
-        rows_[i][j] += other.rows_[i][j];
-      }
-    }
+    addRow(values_.data(), other.values_.data(), values_.size());
 
     return *this;
   }
@@ -176,39 +169,169 @@ public:
       throw std::invalid_argument("Dimensions of matrices don't match.");
     }
 
-    for (size_t i = 0; i < size1(); ++i) {
-      for (size_t j = 0; j < size2(); ++j) {
-        rows_[i][j] -= other.rows_[i][j];
-      }
-    }
+    subtractRow(values_.data(), other.values_.data(), values_.size());
 
     return *this;
   }
 
   std::string toString() const;
 
+  template <typename U>
+  friend Matrix<U> multiplyParallel(const Matrix<U>& lhs, const Matrix<U>& rhs);
+
 private:
-  std::vector<std::vector<T>> rows_;
+  size_t rows_;
+  size_t columns_;
+  std::vector<T> values_;
 
-  std::vector<std::vector<T>> toRows_(size_t n, size_t m, const std::vector<T>& values) {
-    if ((n * m) != values.size()) {
-      throw std::invalid_argument("Dimensions of the matrix doesn't match the number of values provided.");
+  void checkProductDimensions_(const Matrix& other) const {
+    if (size2() != other.size1()) {
+      throw std::invalid_argument("Dimensions of matrices don't match.");
+    }
+  }
+
+  //! The (lhs.size1(), rhs.size2()) matrix to store the product, the entries are assigned by multiplyRows_
+  //! (they are not T(0) to support rings where T(0) is not a valid zero).
+  static Matrix placeholder_(const Matrix& lhs, const Matrix& rhs) {
+    return Matrix(std::make_pair(lhs.size1(), rhs.size2()), lhs.values_.front());
+  }
+
+  static Matrix product_(const Matrix& lhs, const Matrix& rhs) {
+    const auto n = lhs.size1();
+
+    if (IsExactRing<T>::value && (n >= kStrassenThreshold) && (n % 2 == 0) && isSquare_(lhs) && isSquare_(rhs) &&
+        (rhs.size1() == n)) {
+      return strassen_(lhs, rhs);
     }
 
-    std::vector<std::vector<T>> rows;
-    rows.reserve(n);
+    auto result = placeholder_(lhs, rhs);
+    multiplyRows_(lhs, rhs, 0, n, result);
+    return result;
+  }
+
+  //! Computes the rows [begin, end) of lhs * rhs.
+  static void multiplyRows_(const Matrix& lhs, const Matrix& rhs, size_t begin, size_t end, Matrix& result) {
+    const auto inner = lhs.size2();
+    const auto columns = rhs.size2();
+
+    for (size_t ib = begin; ib < end; ib += kBlockSize) {
+      const auto i_end = std::min(end, ib + kBlockSize);
+
+      for (size_t kb = 0; kb < inner; kb += kBlockSize) {
+        const auto k_end = std::min(inner, kb + kBlockSize);
+
+        for (size_t jb = 0; jb < columns; jb += kBlockColumns) {
+          const auto width = std::min(columns, jb + kBlockColumns) - jb;
 
-    auto it = values.begin();
+          for (auto i = ib; i < i_end; ++i) {
+            const auto lhs_row = lhs.row(i);
+            const auto result_row = result.row(i) + jb;
+            auto k = kb;
 
-    for (size_t i = 0; i < n; ++i) {
-      rows.push_back(std::vector<T>(it, it + m));
-      it += m;
+            // the first summand initializes the row
+            if (k == 0) {
+              const auto rhs_row = rhs.row(0) + jb;
+
+              for (size_t j = 0; j < width; ++j) {
+                result_row[j] = lhs_row[0] * rhs_row[j];
+              }
+
+              ++k;
+            }
+
+            for (; k < k_end; ++k) {
+              // a copy can't alias the result, so the compiler keeps it in a register
+              const T coef = lhs_row[k];
+              addScaledRow(result_row, rhs.row(k) + jb, coef, width);
+            }
+          }
+        }
+      }
     }
+  }
 
-    return rows;
+  static bool isSquare_(const Matrix& m) {
+    return m.size1() == m.size2();
+  }
+
+  //! Returns the (h, h) block of m starting at (i, j).
+  static Matrix block_(const Matrix& m, size_t i, size_t j, size_t h) {
+    std::vector<T> values;
+    values.reserve(h * h);
+
+    for (size_t r = 0; r < h; ++r) {
+      values.insert(values.end(), m.row(i + r) + j, m.row(i + r) + j + h);
+    }
+
+    return Matrix(std::make_pair(h, h), values);
+  }
+
+  static Matrix strassen_(const Matrix& a, const Matrix& b) {
+    const auto h = a.size1() / 2;
+
+    const auto a11 = block_(a, 0, 0, h);
+    const auto a12 = block_(a, 0, h, h);
+    const auto a21 = block_(a, h, 0, h);
+    const auto a22 = block_(a, h, h, h);
+
+    const auto b11 = block_(b, 0, 0, h);
+    const auto b12 = block_(b, 0, h, h);
+    const auto b21 = block_(b, h, 0, h);
+    const auto b22 = block_(b, h, h, h);
+
+    const auto m1 = product_(a11 + a22, b11 + b22);
+    const auto m2 = product_(a21 + a22, b11);
+    const auto m3 = product_(a11, b12 - b22);
+    const auto m4 = product_(a22, b21 - b11);
+    const auto m5 = product_(a11 + a12, b22);
+    const auto m6 = product_(a21 - a11, b11 + b12);
+    const auto m7 = product_(a12 - a22, b21 + b22);
+
+    const auto c11 = m1 + m4 - m5 + m7;
+    const auto c12 = m3 + m5;
+    const auto c21 = m2 + m4;
+    const auto c22 = m1 - m2 + m3 + m6;
+
+    std::vector<T> values;
+    values.reserve(4 * h * h);
+
+    for (const auto& halves : {std::make_pair(&c11, &c12), std::make_pair(&c21, &c22)}) {
+      for (size_t r = 0; r < h; ++r) {
+        values.insert(values.end(), halves.first->row(r), halves.first->row(r) + h);
+        values.insert(values.end(), halves.second->row(r), halves.second->row(r) + h);
+      }
+    }
+
+    return Matrix(std::make_pair(2 * h, 2 * h), values);
   }
 };
 
+template <typename T>
+const size_t Matrix<T>::kBlockSize;
+
+template <typename T>
+const size_t Matrix<T>::kBlockColumns;
+
+template <typename T>
+const size_t Matrix<T>::kStrassenThreshold;
+
+//! Computes lhs * rhs, the blocks of rows of the result are computed in parallel (see crag::parallel).
+template <typename T>
+Matrix<T> multiplyParallel(const Matrix<T>& lhs, const Matrix<T>& rhs) {
+  lhs.checkProductDimensions_(rhs);
+
+  auto result = Matrix<T>::placeholder_(lhs, rhs);
+  const auto block_size = Matrix<T>::kBlockSize;
+  const auto blocks_count = (lhs.size1() + block_size - 1) / block_size;
+
+  parallel::forEach(blocks_count, [&](size_t block) {
+    const auto begin = block * block_size;
+    Matrix<T>::multiplyRows_(lhs, rhs, begin, std::min(lhs.size1(), begin + block_size), result);
+  });
+
+  return result;
+}
+
 template <typename T>
 bool operator==(const T& val, const Matrix<T>& m) {
   return m == val;
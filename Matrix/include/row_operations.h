@@ -0,0 +1,51 @@
+#pragma once
+
+#ifndef CRAG_ROW_OPERATIONS_H
+#define CRAG_ROW_OPERATIONS_H
+
+#include <cstddef>
+
+namespace crag {
+namespace matrix {
+
+/*!
+  Operations on contiguous arrays of ring elements (rows of Matrix, columns of packed colored Burau matrices).
+  A ring type can provide faster overloads in its own namespace, e.g., finitefield::Fp does,
+  so these functions should be called unqualified after a using-declaration, as std::swap is.
+*/
+
+//! y[i] += x[i] for i < n.
+template <typename T>
+void addRow(T* y, const T* x, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    y[i] += x[i];
+  }
+}
+
+//! y[i] -= x[i] for i < n.
+template <typename T>
+void subtractRow(T* y, const T* x, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    y[i] -= x[i];
+  }
+}
+
+//! x[i] *= a for i < n.
+template <typename T>
+void scaleRow(T* x, const T& a, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    x[i] *= a;
+  }
+}
+
+//! y[i] += a * x[i] for i < n.
+template <typename T>
+void addScaledRow(T* y, const T* x, const T& a, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    y[i] += a * x[i];
+  }
+}
+} // namespace matrix
+} // namespace crag
+
+#endif // CRAG_ROW_OPERATIONS_H
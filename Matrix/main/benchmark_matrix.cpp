@@ -2,32 +2,75 @@
 
 #include <benchmark/benchmark.h>
 
+#include "FiniteField.h"
+#include "Fp.h"
+#include "GF2k.h"
 #include "matrix.h"
 
-static void BM_MatrixMultiplication(benchmark::State& state) {
-  std::mt19937 g(1233);
+template <typename T>
+static T randomEntry(std::mt19937& g) {
+  return T(T::random(g));
+}
+
+template <>
+int randomEntry<int>(std::mt19937& g) {
   std::uniform_int_distribution<> d(-10, 10);
+  return d(g);
+}
+
+template <typename T>
+static crag::matrix::Matrix<T> randomMatrix(size_t n, std::mt19937& g) {
+  crag::matrix::Matrix<T> result(n);
 
-  size_t n = state.range(0);
-  
-  while (state.KeepRunning()) { 
-    crag::matrix::Matrix<int> a(state.range(0));
-    crag::matrix::Matrix<int> b(state.range(0));
-
-    for (size_t i = 0; i < n; ++i) {
-      for (size_t j = 0; j < n; ++j) {
-        a(i, j) = d(g);
-        b(i, j) = d(g);
-      }
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      result(i, j) = randomEntry<T>(g);
     }
+  }
+
+  return result;
+}
+
+template <typename T>
+static void BM_MatrixMultiplication(benchmark::State& state) {
+  std::mt19937 g(1233);
+
+  const size_t n = state.range(0);
+  const auto a = randomMatrix<T>(n, g);
+  const auto b = randomMatrix<T>(n, g);
 
+  while (state.KeepRunning()) {
     benchmark::DoNotOptimize(a * b);
   }
 
   state.SetComplexityN(state.range(0));
 }
 
+template <typename T>
+static void BM_MatrixMultiplicationParallel(benchmark::State& state) {
+  std::mt19937 g(1233);
+
+  const size_t n = state.range(0);
+  const auto a = randomMatrix<T>(n, g);
+  const auto b = randomMatrix<T>(n, g);
+
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(multiplyParallel(a, b));
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+using ZZ1237 = crag::finitefield::ZZ<1237>;
+using Fp1237 = crag::finitefield::Fp<1237>;
+using GF256 = crag::finitefield::GF256;
+
+BENCHMARK_TEMPLATE(BM_MatrixMultiplication, int)->RangeMultiplier(2)->Range(1, 512)->Complexity();
+BENCHMARK_TEMPLATE(BM_MatrixMultiplication, ZZ1237)->RangeMultiplier(2)->Range(1, 512)->Complexity();
+BENCHMARK_TEMPLATE(BM_MatrixMultiplication, Fp1237)->RangeMultiplier(2)->Range(1, 512)->Complexity();
+BENCHMARK_TEMPLATE(BM_MatrixMultiplication, GF256)->RangeMultiplier(2)->Range(1, 512)->Complexity();
 
-BENCHMARK(BM_MatrixMultiplication)->RangeMultiplier(2)->Range(1, 512)->Complexity();
+BENCHMARK_TEMPLATE(BM_MatrixMultiplicationParallel, int)->RangeMultiplier(2)->Range(64, 512)->UseRealTime()->Complexity();
+BENCHMARK_TEMPLATE(BM_MatrixMultiplicationParallel, Fp1237)->RangeMultiplier(2)->Range(64, 512)->UseRealTime()->Complexity();
 
 BENCHMARK_MAIN();
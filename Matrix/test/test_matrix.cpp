@@ -2,6 +2,9 @@
 
 #include "matrix.h"
 
+#include <random>
+#include <tuple>
+
 namespace crag {
 namespace matrix {
 namespace {
@@ -70,6 +73,65 @@ TEST(Matrix, Test_CharPoly_1) {
   EXPECT_EQ(std::vector<double>({16, -32, 24, -8, 1}),  charPoly(Matrix<double>(4, {1, 1, 0, 0, -1, 3, 0, 0, -6, 8, -1, 1, -16, 22, -9, 5})));
 }
 
+Matrix<int> randomMatrix(size_t n, size_t m, std::mt19937& g) {
+  std::uniform_int_distribution<> d(-10, 10);
+  Matrix<int> result(std::make_pair(n, m));
+
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < m; ++j) {
+      result(i, j) = d(g);
+    }
+  }
+
+  return result;
+}
+
+Matrix<int> naiveProduct(const Matrix<int>& a, const Matrix<int>& b) {
+  Matrix<int> result(std::make_pair(a.size1(), b.size2()));
+
+  for (size_t i = 0; i < a.size1(); ++i) {
+    for (size_t j = 0; j < b.size2(); ++j) {
+      for (size_t k = 0; k < a.size2(); ++k) {
+        result(i, j) += a(i, k) * b(k, j);
+      }
+    }
+  }
+
+  return result;
+}
+
+TEST(Matrix, Test_Product_1) {
+  std::mt19937 g(0);
+
+  // sizes which are not multiples of the block sizes
+  for (const auto& size : {std::make_tuple(1, 1, 1), std::make_tuple(3, 5, 2), std::make_tuple(65, 130, 7),
+                          std::make_tuple(70, 65, 300)}) {
+    const auto a = randomMatrix(std::get<0>(size), std::get<1>(size), g);
+    const auto b = randomMatrix(std::get<1>(size), std::get<2>(size), g);
+
+    const auto expected = naiveProduct(a, b);
+
+    EXPECT_EQ(expected, a * b);
+    EXPECT_EQ(expected, multiplyParallel(a, b));
+  }
+
+  EXPECT_THROW(randomMatrix(2, 3, g) * randomMatrix(2, 3, g), std::invalid_argument);
+  EXPECT_THROW(multiplyParallel(randomMatrix(2, 3, g), randomMatrix(2, 3, g)), std::invalid_argument);
+}
+
+TEST(Matrix, Test_Product_Strassen) {
+  std::mt19937 g(0);
+
+  const size_t n = 2 * Matrix<int>::kStrassenThreshold + 4;
+  const auto a = randomMatrix(n, n, g);
+  const auto b = randomMatrix(n, n, g);
+
+  const auto expected = naiveProduct(a, b);
+
+  EXPECT_EQ(expected, a * b);
+  EXPECT_EQ(expected, multiplyParallel(a, b));
+}
+
 } // namespace
 } // namespace matrix
 } // namespace crag
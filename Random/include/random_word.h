@@ -19,7 +19,8 @@ Word randomWord(size_t n, size_t len, URNG& g) {
     return Word();
   }
 
-  std::list<int> result;
+  std::vector<int> result;
+  result.reserve(len);
 
   const auto dist_first = boost::random::uniform_int_distribution<int>(-n, n - 1);
   const auto dist_rest = boost::random::uniform_int_distribution<int>(-n, n - 2);
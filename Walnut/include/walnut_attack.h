@@ -7,7 +7,10 @@
 #include <fstream>
 #include <future>
 
+#include "Fp.h"
+#include "GF2k.h"
 #include "LinkedBraidStructure.h"
+#include "WordBatch.h"
 #include "fast_conjugacy_check.h"
 #include "fast_identity_check.h"
 #include "parallel.h"
@@ -16,7 +19,7 @@
 namespace crag {
 namespace walnut {
 
-using FF = finitefield::ZZ<199>;
+using FF = finitefield::Fp<199>;
 typedef crag::braidgroup::BraidHasher<FF>::braid_hash_t braid_hash_t;
 
 
@@ -82,6 +85,9 @@ std::vector<std::pair<size_t, Word>> availableFlips(size_t n, size_t a, size_t b
   Permutation perm1(n), perm2(n);
   std::set<braid_hash_t> flip_hash;
 
+  // flips are hashed without rebuilding the whole word
+  const auto tree = hasher.tree(w);
+
   for (const auto l : w) {
     const auto ind = std::abs(l);
 
@@ -97,14 +103,16 @@ std::vector<std::pair<size_t, Word>> availableFlips(size_t n, size_t a, size_t b
 
     // available flip
     if (strand1 == a && strand2 == b) {
-      auto w1 = w.subword(0, pos);
-      w1 *= getReplacement<Stabilizer>(l);
-      w1 *= w.subword(pos + 1, w.size());
-
-      const auto h = hasher(w1);
+      const auto replacement = getReplacement<Stabilizer>(l);
+      const auto h = hasher(tree, pos, 1, replacement);
 
       if (flip_hash.find(h) == flip_hash.end()) {
         flip_hash.insert(h);
+
+        auto w1 = w.subword(0, pos);
+        w1 *= replacement;
+        w1 *= w.subword(pos + 1, w.size());
+
         result.push_back(std::make_pair(pos, w1));
       }
     }
@@ -573,6 +581,21 @@ std::vector<std::vector<Word>> shortenTuplesParallel(size_t n, const std::vector
   return result;
 }
 
+std::vector<std::vector<Word>> shortenTuplesParallel(size_t n, const WordBatch& tuples) {
+  const auto tuple_size = tuples.tupleSize();
+
+  std::vector<std::vector<Word>> result(tuples.size(), std::vector<Word>(tuple_size));
+
+  parallel::forEach(tuples.size() * tuple_size, [&](size_t i) {
+    const auto tuple_idx = i / tuple_size;
+    const auto word_idx = i % tuple_size;
+
+    result[tuple_idx][word_idx] = shortenBraid2(n, tuples[tuple_idx][word_idx].toWord());
+  });
+
+  return result;
+}
+
 boost::optional<braid_hash_t> generateNewElts(
     size_t n,
     map<braid_hash_t, vector<Word>>& hash_values,
@@ -631,14 +654,8 @@ boost::optional<braid_hash_t> generateNewElts(
   //  const auto conjugated_words =
   //      parallel::map<Word, std::vector<Word>>(generators, [&](const Word& c) { return conjugate(n, cur_vec, c); });
 
-  std::vector<std::vector<Word>> conjugated_words;
-  conjugated_words.reserve(generators.size());
-
-  for (const auto& c : generators) {
-    conjugated_words.push_back(conjugateWithoutShortening(cur_vec, c));
-  }
-
-  conjugated_words = shortenTuplesParallel(n, conjugated_words);
+  // all conjugates go into one buffer, conjugated_words[i] is cur_vec conjugated by generators[i]
+  const auto conjugated_words = shortenTuplesParallel(n, WordBatch::fromTuple(cur_vec).conjugate(generators));
 
   for (size_t i = 0; i < conjugated_words.size(); ++i) {
     const auto& conj = generators[i];
@@ -934,9 +951,8 @@ bool checkFakePrivateKey(
   });
 }
 
-using GF32 = finitefield::FieldElement<finitefield::IdealGeneratedByPolynomial<finitefield::ZZ<2>, 1, 0, 1, 0, 0, 1>>;
-using GF256 =
-    finitefield::FieldElement<finitefield::IdealGeneratedByPolynomial<finitefield::ZZ<2>, 1, 1, 0, 1, 1, 0, 0, 0, 1>>;
+using GF32 = finitefield::GF32;
+using GF256 = finitefield::GF256;
 
 template <typename Stabilizer = StabilizerSquare>
 auto getProtocolFor128BitsSecurity(size_t seed) {
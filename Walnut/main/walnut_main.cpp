@@ -3,9 +3,8 @@
 using namespace crag;
 
 using ZZ5 = finitefield::ZZ<5>;
-using GF32 = finitefield::FieldElement<finitefield::IdealGeneratedByPolynomial<finitefield::ZZ<2>, 1, 0, 1, 0, 0, 1>>;
-using GF256 =
-    finitefield::FieldElement<finitefield::IdealGeneratedByPolynomial<finitefield::ZZ<2>, 1, 1, 0, 1, 1, 0, 0, 0, 1>>;
+using GF32 = finitefield::GF32;
+using GF256 = finitefield::GF256;
 
 
 static void printTotalxNumbersSeq3(int N, const Word& w, size_t strand_a, size_t strand_b) {
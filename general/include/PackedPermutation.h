@@ -0,0 +1,141 @@
+#pragma once
+
+#ifndef CRAG_PACKED_PERMUTATION_H
+#define CRAG_PACKED_PERMUTATION_H
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Permutation.h"
+
+namespace crag {
+
+//! Permutation on at most 32 symbols packed into 32 bytes, it never allocates memory.
+/*!
+  Has the same semantics as Permutation (including multiplication p * q = q[p[i]]), so it can replace Permutation
+  as a factor type of Garside normal forms of braids of rank at most 32 (see garside_normal_form.h).
+  Points size() ... 31 are kept fixed, so composition is a pair of byte shuffles (pshufb) on SSSE3 CPUs.
+*/
+class PackedPermutation {
+public:
+  //! Maximal size of a permutation.
+  static const size_t kCapacity = 32;
+
+  //! Creates the trivial permutation of size 0.
+  PackedPermutation()
+    : PackedPermutation(0) {}
+
+  //! Creates the trivial permutation of the specified size. Throws if size > kCapacity.
+  explicit PackedPermutation(size_t size);
+
+  //! Construct a permutation by a vector of numbers.
+  explicit PackedPermutation(const std::vector<int>& values);
+
+  explicit PackedPermutation(std::initializer_list<int> values)
+    : PackedPermutation(std::vector<int>(values)) {}
+
+  explicit PackedPermutation(const Permutation& p)
+    : PackedPermutation(p.getVector()) {}
+
+  Permutation toPermutation() const;
+
+  std::vector<int> getVector() const;
+
+  size_t size() const {
+    return size_;
+  }
+
+  int operator[](size_t i) const {
+    return values_[i];
+  }
+
+  bool operator==(const PackedPermutation& p) const {
+    return size_ == p.size_ && std::memcmp(values_, p.values_, kCapacity) == 0;
+  }
+
+  bool operator!=(const PackedPermutation& p) const {
+    return !(*this == p);
+  }
+
+  //! Compares sizes first, then values lexicographically (as Permutation does).
+  bool operator<(const PackedPermutation& p) const {
+    if (size_ != p.size_) {
+      return size_ < p.size_;
+    }
+
+    return std::memcmp(values_, p.values_, size_) < 0;
+  }
+
+  //! Multiple 2 permutations, (p * q)[i] = q[p[i]].
+  PackedPermutation operator*(const PackedPermutation& p) const {
+    PackedPermutation result(*this);
+    result *= p;
+    return result;
+  }
+
+  PackedPermutation& operator*=(const PackedPermutation& other);
+
+  PackedPermutation operator-() const {
+    return inverse();
+  }
+
+  PackedPermutation inverse() const;
+
+  //! Swap the values at ith and jth position.
+  void change(size_t i, size_t j) {
+    std::swap(values_[i], values_[j]);
+  }
+
+  bool isTrivial() const;
+
+  //! Conjugate by the half twist.
+  PackedPermutation flip() const;
+
+  //! Length of a geodesic (the number of inversions), takes O(n) time.
+  size_t length() const;
+
+  //! Find a geodesic word representing the permutation (indices start with 0).
+  std::vector<int> geodesic() const;
+
+  //! Find a geodesic word representing the permutation (indices start with 1).
+  std::vector<int> geodesicWord() const;
+
+  //! See Permutation::startingSet.
+  std::uint64_t startingSet() const;
+
+  //! See Permutation::finishingSet.
+  std::uint64_t finishingSet() const;
+
+  //! See Permutation::RightGCD.
+  PackedPermutation RightGCD(const PackedPermutation& p) const;
+
+  //! See Permutation::RightLCM.
+  PackedPermutation RightLCM(const PackedPermutation& p) const;
+
+  //! See Permutation::LeftGCD.
+  PackedPermutation LeftGCD(const PackedPermutation& p) const;
+
+  //! See Permutation::LeftLCM.
+  PackedPermutation LeftLCM(const PackedPermutation& p) const;
+
+  size_t hash() const;
+
+  static PackedPermutation getHalfTwistPermutation(size_t n);
+
+private:
+  void validate_() const;
+
+  alignas(16) std::uint8_t values_[kCapacity];
+  std::uint8_t size_;
+};
+
+std::ostream& operator<<(std::ostream& os, const PackedPermutation& p);
+
+} // namespace crag
+
+#endif // CRAG_PACKED_PERMUTATION_H
@@ -9,6 +9,7 @@
 #ifndef CRAG_PERMUTATION_H
 #define CRAG_PERMUTATION_H
 
+#include <cstdint>
 #include <map>
 #include <ostream>
 #include <vector>
@@ -101,7 +102,7 @@ public:
   //! Does nothing if n <= size()
   Permutation increaseSize(size_t n) const;
 
-  //! Compute the length of a permutation (length of a geodesic). Current version is slow, need to update.
+  //! Compute the length of a permutation (length of a geodesic, i.e., the number of inversions) in O(n log n) time.
   size_t length() const;
 
   //! Compute the number of positions with different elements.
@@ -150,12 +151,33 @@ public:
   //! makes no sense)
   std::vector<int> getWordPresentation() const;
 
+  //! Starting set of the permutation braid as a bitmask (defined for size() <= 64).
+  /*!
+    Bit i is set iff the permutation starts with the transposition \f$x_i = (i, i+1)\f$,
+    i.e., \f$p = x_i \circ p'\f$ for some permutation \f$p'\f$. Takes O(n) time and does not allocate memory.
+  */
+  std::uint64_t startingSet() const;
+
+  //! Finishing set of the permutation braid as a bitmask (defined for size() <= 64).
+  /*!
+    Bit i is set iff the permutation ends with the transposition \f$x_i = (i, i+1)\f$,
+    i.e., \f$p = p' \circ x_i\f$ for some permutation \f$p'\f$.
+  */
+  std::uint64_t finishingSet() const;
+
+  //! Hash of the permutation, equal permutations have equal hashes.
+  size_t hash() const;
+
   //! Compute RightGCD of 2 permutations
   /*!
     Let \f$p_1\f$ and \f$p_2\f$ be two permutations. The maximal permutation \f$P\f$
     which ends \f$p_1\f$ and \f$p_2\f$ is called the
     right greatest common divisor of \f$p_1\f$ and \f$p_2\f$, i.e., \f$P\f$ is maximal such that
     \f$p_1 = d_1 \circ P \f$ and \f$p_2 = d_2 \circ P \f$ for some permutations \f$d_1\f$ and \f$d_2\f$.
+
+    For permutations of size at most 6 the result is taken from a precomputed table of all meets
+    (built on the first use). Permutations of size at most 64 are processed by the bit-parallel meet
+    (disjoint finishing sets are detected in O(n) time first), larger ones by merging in O(n log n) time.
   */
   Permutation RightGCD(const Permutation& p) const;
 
@@ -197,6 +219,12 @@ private:
 
   void validate_() const;
 
+  //! (Aux) RightGCD computed by merging (without lookup tables).
+  Permutation mergeMeet_(const Permutation& p) const;
+
+  //! (Aux) RightGCD of permutations of size at most 64 computed on bitmasks of the values.
+  Permutation bitMeet_(const Permutation& p) const;
+
   //! (Aux) The main operation to compute RightGCD and all other lattice functions
   void _sub_meet(
       const Permutation& p,
@@ -207,6 +235,7 @@ private:
       int* left_indeces_b,
       int* right_indeces_a,
       int* right_indeces_b,
+      int* buffer,
       int beg,
       int end) const;
 
@@ -218,4 +247,14 @@ std::ostream& operator<<(std::ostream& os, const Permutation& p);
 //! Decomposes a permutation into product of independent cycles.
 std::vector<std::vector<int>> toCycles(const Permutation& p);
 
+namespace std {
+
+template <>
+struct hash<Permutation> {
+  size_t operator()(const Permutation& p) const {
+    return p.hash();
+  }
+};
+} // namespace std
+
 #endif // CRAG_PERMUTATION_H
@@ -0,0 +1,335 @@
+#include "PackedPermutation.h"
+
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CRAG_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace crag {
+
+namespace {
+
+const size_t kCapacity = PackedPermutation::kCapacity;
+
+//! result[i] = b[a[i]] for all 32 points.
+void composeScalar(const std::uint8_t* a, const std::uint8_t* b, std::uint8_t* result) {
+  for (size_t i = 0; i < kCapacity; ++i) {
+    result[i] = b[a[i]];
+  }
+}
+
+#ifdef CRAG_X86_KERNELS
+
+__attribute__((target("ssse3")))
+void composeSSSE3(const std::uint8_t* a, const std::uint8_t* b, std::uint8_t* result) {
+  const auto b_lo = _mm_load_si128(reinterpret_cast<const __m128i*>(b));
+  const auto b_hi = _mm_load_si128(reinterpret_cast<const __m128i*>(b + 16));
+  const auto fifteen = _mm_set1_epi8(15);
+
+  for (size_t half = 0; half < kCapacity; half += 16) {
+    const auto index = _mm_load_si128(reinterpret_cast<const __m128i*>(a + half));
+
+    // pshufb uses the low 4 bits of an index, the points 16..31 are taken from the upper half of b
+    const auto from_lo = _mm_shuffle_epi8(b_lo, index);
+    const auto from_hi = _mm_shuffle_epi8(b_hi, index);
+    const auto is_hi = _mm_cmpgt_epi8(index, fifteen);
+
+    const auto value = _mm_or_si128(_mm_and_si128(is_hi, from_hi), _mm_andnot_si128(is_hi, from_lo));
+    _mm_store_si128(reinterpret_cast<__m128i*>(result + half), value);
+  }
+}
+
+#endif
+
+void compose(const std::uint8_t* a, const std::uint8_t* b, std::uint8_t* result) {
+#ifdef CRAG_X86_KERNELS
+  static const bool has_ssse3 = __builtin_cpu_supports("ssse3");
+
+  if (has_ssse3) {
+    composeSSSE3(a, b, result);
+    return;
+  }
+#endif
+
+  composeScalar(a, b, result);
+}
+
+//! See Permutation::_sub_meet.
+void subMeet(
+    const std::uint8_t* ip1,
+    const std::uint8_t* ip2,
+    std::uint8_t* cur,
+    int* l_ind_a,
+    int* l_ind_b,
+    int* r_ind_a,
+    int* r_ind_b,
+    int beg,
+    int end) {
+  if (end - beg <= 1) {
+    return;
+  }
+
+  const int middle = beg + (end - beg) / 2;
+
+  subMeet(ip1, ip2, cur, l_ind_a, l_ind_b, r_ind_a, r_ind_b, beg, middle);
+  subMeet(ip1, ip2, cur, l_ind_a, l_ind_b, r_ind_a, r_ind_b, middle, end);
+
+  for (int i = middle - 1; i >= beg; --i) {
+    const int a = ip1[cur[i]];
+    const int b = ip2[cur[i]];
+
+    l_ind_a[i] = (i == middle - 1) ? a : std::min(a, l_ind_a[i + 1]);
+    l_ind_b[i] = (i == middle - 1) ? b : std::min(b, l_ind_b[i + 1]);
+  }
+
+  for (int i = middle; i < end; ++i) {
+    const int a = ip1[cur[i]];
+    const int b = ip2[cur[i]];
+
+    r_ind_a[i] = (i == middle) ? a : std::max(a, r_ind_a[i - 1]);
+    r_ind_b[i] = (i == middle) ? b : std::max(b, r_ind_b[i - 1]);
+  }
+
+  std::uint8_t merged[kCapacity];
+  int i1 = beg;
+  int i2 = middle;
+
+  for (int i = 0; i < end - beg; ++i) {
+    if (i1 == middle) {
+      merged[i] = cur[i2++];
+    } else if (i2 == end) {
+      merged[i] = cur[i1++];
+    } else if (l_ind_a[i1] > r_ind_a[i2] && l_ind_b[i1] > r_ind_b[i2]) {
+      merged[i] = cur[i2++];
+    } else {
+      merged[i] = cur[i1++];
+    }
+  }
+
+  std::copy(merged, merged + (end - beg), cur + beg);
+}
+} // namespace
+
+PackedPermutation::PackedPermutation(size_t size) {
+  if (size > kCapacity) {
+    throw std::invalid_argument("Packed permutation is too long.");
+  }
+
+  size_ = size;
+
+  for (size_t i = 0; i < kCapacity; ++i) {
+    values_[i] = i;
+  }
+}
+
+PackedPermutation::PackedPermutation(const std::vector<int>& values)
+  : PackedPermutation(values.size()) {
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (values[i] < 0 || values[i] >= static_cast<int>(size_)) {
+      throw std::invalid_argument("Permutation must be indexed from 0 to n-1.");
+    }
+
+    values_[i] = values[i];
+  }
+
+  validate_();
+}
+
+Permutation PackedPermutation::toPermutation() const {
+  return Permutation(getVector());
+}
+
+std::vector<int> PackedPermutation::getVector() const {
+  return std::vector<int>(values_, values_ + size_);
+}
+
+PackedPermutation& PackedPermutation::operator*=(const PackedPermutation& other) {
+  alignas(16) std::uint8_t result[kCapacity];
+
+  compose(values_, other.values_, result);
+
+  std::memcpy(values_, result, kCapacity);
+  size_ = std::max(size_, other.size_);
+
+  return *this;
+}
+
+PackedPermutation PackedPermutation::inverse() const {
+  PackedPermutation result(size_);
+
+  for (size_t i = 0; i < size_; ++i) {
+    result.values_[values_[i]] = i;
+  }
+
+  return result;
+}
+
+bool PackedPermutation::isTrivial() const {
+  return *this == PackedPermutation(size_);
+}
+
+PackedPermutation PackedPermutation::flip() const {
+  PackedPermutation result(size_);
+
+  for (size_t i = 0; i < size_; ++i) {
+    result.values_[size_ - i - 1] = size_ - values_[i] - 1;
+  }
+
+  return result;
+}
+
+size_t PackedPermutation::length() const {
+  // count pairs i < j with p[i] > p[j], the set of seen values is a bitmask
+  std::uint64_t seen = 0;
+  size_t result = 0;
+
+  for (size_t i = 0; i < size_; ++i) {
+    result += __builtin_popcountll(seen >> (values_[i] + 1));
+    seen |= std::uint64_t(1) << values_[i];
+  }
+
+  return result;
+}
+
+std::vector<int> PackedPermutation::geodesic() const {
+  std::vector<int> result;
+  result.reserve(length());
+
+  PackedPermutation cur(size_);
+  PackedPermutation inv(size_);
+
+  for (size_t i = 0; i < size_; ++i) {
+    const int pos = inv.values_[values_[i]];
+
+    for (int j = pos - 1; j >= static_cast<int>(i); --j) {
+      result.push_back(j);
+      inv.change(cur.values_[j], cur.values_[j + 1]);
+      cur.change(j, j + 1);
+    }
+  }
+
+  std::reverse(result.begin(), result.end());
+
+  return result;
+}
+
+std::vector<int> PackedPermutation::geodesicWord() const {
+  auto result = geodesic();
+
+  for (auto& g : result) {
+    ++g;
+  }
+
+  return result;
+}
+
+std::uint64_t PackedPermutation::startingSet() const {
+  std::uint64_t result = 0;
+
+  for (size_t i = 0; i + 1 < size_; ++i) {
+    result |= std::uint64_t(values_[i] > values_[i + 1]) << i;
+  }
+
+  return result;
+}
+
+std::uint64_t PackedPermutation::finishingSet() const {
+  std::uint64_t result = 0;
+  std::uint64_t seen = 0;
+
+  // i is in the set iff i + 1 goes before i
+  for (size_t i = 0; i < size_; ++i) {
+    const auto v = values_[i];
+
+    if (v > 0 && !((seen >> (v - 1)) & 1)) {
+      result |= std::uint64_t(1) << (v - 1);
+    }
+
+    seen |= std::uint64_t(1) << v;
+  }
+
+  return result;
+}
+
+PackedPermutation PackedPermutation::RightGCD(const PackedPermutation& p) const {
+  if (size_ != p.size_) {
+    throw std::invalid_argument("Cannot compute RightGCD of permutation of different sizes.");
+  }
+
+  if ((finishingSet() & p.finishingSet()) == 0) {
+    return PackedPermutation(size_);
+  }
+
+  const auto ip1 = inverse();
+  const auto ip2 = p.inverse();
+
+  int l_ind_a[kCapacity];
+  int l_ind_b[kCapacity];
+  int r_ind_a[kCapacity];
+  int r_ind_b[kCapacity];
+
+  PackedPermutation result(size_);
+  subMeet(ip1.values_, ip2.values_, result.values_, l_ind_a, l_ind_b, r_ind_a, r_ind_b, 0, size_);
+
+  return result;
+}
+
+PackedPermutation PackedPermutation::RightLCM(const PackedPermutation& p) const {
+  const auto delta = getHalfTwistPermutation(size_);
+  return (*this * delta).RightGCD(p * delta) * delta;
+}
+
+PackedPermutation PackedPermutation::LeftGCD(const PackedPermutation& p) const {
+  return -((-*this).RightGCD(-p));
+}
+
+PackedPermutation PackedPermutation::LeftLCM(const PackedPermutation& p) const {
+  const auto delta = getHalfTwistPermutation(size_);
+  const auto p3 = delta * inverse();
+  const auto p4 = delta * p.inverse();
+  return (delta * p3.RightGCD(p4)).inverse();
+}
+
+size_t PackedPermutation::hash() const {
+  std::uint64_t words[kCapacity / 8];
+  std::memcpy(words, values_, kCapacity);
+
+  std::uint64_t result = size_;
+
+  for (const auto w : words) {
+    result = (result ^ w) * 0x9E3779B97F4A7C15ull;
+    result ^= result >> 29;
+  }
+
+  return static_cast<size_t>(result);
+}
+
+PackedPermutation PackedPermutation::getHalfTwistPermutation(size_t n) {
+  PackedPermutation result(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    result.values_[i] = n - i - 1;
+  }
+
+  return result;
+}
+
+void PackedPermutation::validate_() const {
+  std::uint64_t seen = 0;
+
+  for (size_t i = 0; i < size_; ++i) {
+    seen |= std::uint64_t(1) << values_[i];
+  }
+
+  if (seen != (std::uint64_t(1) << size_) - 1) {
+    throw std::invalid_argument("Permutation contains duplicates.");
+  }
+}
+
+std::ostream& operator<<(std::ostream& os, const PackedPermutation& p) {
+  return os << p.toPermutation();
+}
+
+} // namespace crag
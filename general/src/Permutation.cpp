@@ -6,7 +6,9 @@
 
 #include "Permutation.h"
 
+#include <algorithm>
 #include <cassert>
+#include <functional>
 #include <limits>
 #include <list>
 #include <set>
@@ -363,6 +365,17 @@ bool Permutation::operator==(const Permutation& p) const {
   return values_ == p.values_;
 }
 
+size_t Permutation::hash() const {
+  std::uint64_t result = values_.size();
+
+  for (const auto v : values_) {
+    result = (result ^ static_cast<std::uint64_t>(v)) * 0x9E3779B97F4A7C15ull;
+    result ^= result >> 29;
+  }
+
+  return static_cast<size_t>(result);
+}
+
 bool Permutation::operator!=(const Permutation& p) const {
   return values_ != p.values_;
 }
@@ -406,13 +419,13 @@ Permutation& Permutation::operator*=(const Permutation& other) {
 }
 
 Permutation Permutation::inverse() const {
-  std::vector<int> result(size());
+  Permutation result(size());
 
   for (size_t t = 0; t < size(); ++t) {
-    result[values_[t]] = t;
+    result.values_[values_[t]] = t;
   }
 
-  return Permutation(std::move(result));
+  return result;
 }
 
 size_t Permutation::difference(const Permutation& p) const {
@@ -631,14 +644,122 @@ void Permutation::preparePairs_(int N, Permutation& P, std::vector<std::pair<int
 }
 
 Permutation Permutation::getHalfTwistPermutation(size_t n) {
-  std::vector<int> result(n);
+  Permutation result(n);
 
   for (size_t i = 0; i < n; ++i) {
-    result[i] = n - i - 1;
+    result.values_[i] = n - i - 1;
   }
 
-  return Permutation(result);
+  return result;
+}
+
+std::uint64_t Permutation::startingSet() const {
+  std::uint64_t result = 0;
+
+  for (size_t i = 0; i + 1 < size(); ++i) {
+    result |= std::uint64_t(values_[i] > values_[i + 1]) << i;
+  }
+
+  return result;
+}
+
+std::uint64_t Permutation::finishingSet() const {
+  std::uint64_t result = 0;
+  std::uint64_t seen = 0;
+
+  // i is in the set iff i + 1 goes before i
+  for (const auto v : values_) {
+    if (v > 0 && !((seen >> (v - 1)) & 1)) {
+      result |= std::uint64_t(1) << (v - 1);
+    }
+
+    seen |= std::uint64_t(1) << v;
+  }
+
+  return result;
+}
+
+namespace {
+//! Permutations of size n are indexed by their ranks in the lexicographic order (Lehmer codes).
+size_t lexicographicIndex(const Permutation& p) {
+  const auto n = p.size();
+  size_t result = 0;
+
+  for (size_t i = 0; i < n; ++i) {
+    size_t smaller = 0;
+
+    for (size_t j = i + 1; j < n; ++j) {
+      smaller += p[j] < p[i];
+    }
+
+    result = result * (n - i) + smaller;
+  }
+
+  return result;
+}
+
+//! RightGCD of all pairs of permutations of a fixed small size.
+class MeetTable {
+public:
+  typedef std::function<Permutation(const Permutation&, const Permutation&)> Meet;
+
+  MeetTable(size_t n, const Meet& meet) {
+    std::vector<int> values(n);
+
+    for (size_t i = 0; i < n; ++i) {
+      values[i] = i;
+    }
+
+    do {
+      permutations_.emplace_back(values);
+    } while (std::next_permutation(values.begin(), values.end()));
+
+    const auto count = permutations_.size();
+    meets_.resize(count * count);
+
+    for (size_t i = 0; i < count; ++i) {
+      for (size_t j = 0; j < count; ++j) {
+        meets_[i * count + j] = lexicographicIndex(meet(permutations_[i], permutations_[j]));
+      }
+    }
+  }
+
+  const Permutation& operator()(const Permutation& p1, const Permutation& p2) const {
+    return permutations_[meets_[lexicographicIndex(p1) * permutations_.size() + lexicographicIndex(p2)]];
+  }
+
+private:
+  std::vector<Permutation> permutations_;
+  std::vector<std::uint16_t> meets_;
+};
+
+const size_t kMeetTableSize = 6;
+
+template <size_t N>
+const MeetTable& meetTable(const MeetTable::Meet& meet) {
+  static const MeetTable table(N, meet);
+  return table;
+}
+
+const MeetTable& meetTable(size_t n, const MeetTable::Meet& meet) {
+  switch (n) {
+    case 0:
+      return meetTable<0>(meet);
+    case 1:
+      return meetTable<1>(meet);
+    case 2:
+      return meetTable<2>(meet);
+    case 3:
+      return meetTable<3>(meet);
+    case 4:
+      return meetTable<4>(meet);
+    case 5:
+      return meetTable<5>(meet);
+    default:
+      return meetTable<6>(meet);
+  }
 }
+} // namespace
 
 Permutation Permutation::RightGCD(const Permutation& p) const {
   const auto this_size = size();
@@ -647,18 +768,104 @@ Permutation Permutation::RightGCD(const Permutation& p) const {
     throw std::invalid_argument("Cannot compute RightGCD of permutation of different sizes.");
   }
 
-  int* l_ind_a = new int[this_size];
-  int* l_ind_b = new int[this_size];
-  int* r_ind_a = new int[this_size];
-  int* r_ind_b = new int[this_size];
+  if (this_size <= kMeetTableSize) {
+    const auto meet = [](const Permutation& p1, const Permutation& p2) { return p1.mergeMeet_(p2); };
+    return meetTable(this_size, meet)(*this, p);
+  }
+
+  if (this_size <= 64) {
+    if ((finishingSet() & p.finishingSet()) == 0) {
+      return Permutation(this_size);
+    }
+
+    return bitMeet_(p);
+  }
+
+  return mergeMeet_(p);
+}
+
+Permutation Permutation::bitMeet_(const Permutation& p) const {
+  const auto this_size = size();
+  const auto all = this_size == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << this_size) - 1;
+
+  // The meet is the permutation in which x goes before y iff it is forced by transitivity
+  // to go before y in one of the arguments, i.e., its relation "x < y and x goes before y"
+  // is the transitive closure of the union of these relations for the arguments.
+  // follows[x] is the set of y > x which go after x.
+  std::uint64_t follows[64];
+  std::uint64_t seen = 0;
+
+  for (const auto x : values_) {
+    seen |= std::uint64_t(1) << x;
+    follows[x] = ~seen;
+  }
+
+  seen = 0;
+
+  for (const auto x : p.values_) {
+    seen |= std::uint64_t(1) << x;
+    follows[x] |= ~seen;
+  }
 
+  // the relation only goes upwards, so the closures of larger values are ready
+  for (size_t x = this_size; x-- > 0;) {
+    const auto above = all & (~std::uint64_t(0) << x << 1);
+    std::uint64_t closure = 0;
+
+    // the values reachable through a taken one are skipped
+    for (auto rest = follows[x] & above; rest != 0; rest &= ~closure) {
+      const auto y = __builtin_ctzll(rest);
+      closure |= follows[y] | (std::uint64_t(1) << y);
+    }
+
+    follows[x] = closure;
+  }
+
+  // bit-sliced counters of the number of y < x followed by x
+  std::uint64_t counters[7] = {};
+
+  for (size_t y = 0; y < this_size; ++y) {
+    auto carry = follows[y];
+
+    for (size_t k = 0; carry != 0; ++k) {
+      const auto next_carry = counters[k] & carry;
+      counters[k] ^= carry;
+      carry = next_carry;
+    }
+  }
+
+  // x goes after the smaller values it follows and after the larger values it does not precede
   Permutation result(this_size);
-  _sub_meet(p, inverse(), p.inverse(), result, l_ind_a, l_ind_b, r_ind_a, r_ind_b, 0, this_size);
 
-  delete[] l_ind_a;
-  delete[] l_ind_b;
-  delete[] r_ind_a;
-  delete[] r_ind_b;
+  for (size_t x = 0; x < this_size; ++x) {
+    size_t position = 0;
+
+    for (size_t k = 0; k < 7; ++k) {
+      position |= ((counters[k] >> x) & 1) << k;
+    }
+
+    const auto above = all & (~std::uint64_t(0) << x << 1);
+    position += __builtin_popcountll(above & ~follows[x]);
+
+    result.values_[position] = x;
+  }
+
+  return result;
+}
+
+Permutation Permutation::mergeMeet_(const Permutation& p) const {
+  const auto this_size = size();
+
+  // all scratch arrays in one allocation
+  std::vector<int> buffer(5 * this_size);
+  const auto l_ind_a = buffer.data();
+  const auto l_ind_b = l_ind_a + this_size;
+  const auto r_ind_a = l_ind_b + this_size;
+  const auto r_ind_b = r_ind_a + this_size;
+  const auto sublist = r_ind_b + this_size;
+
+  Permutation result(this_size);
+  _sub_meet(p, inverse(), p.inverse(), result, l_ind_a, l_ind_b, r_ind_a, r_ind_b, sublist, 0, this_size);
 
   return result;
 }
@@ -704,17 +911,18 @@ void Permutation::_sub_meet(
     int* l_ind_b,
     int* r_ind_a,
     int* r_ind_b,
+    int* new_sublist,
     int beg,
     int end) const {
-  if (end - beg == 1) {
+  if (end - beg <= 1) {
     return;
   }
 
   const int middle = beg + (end - beg) / 2;
 
   // I. reorder left and right parts of permutation according to meet operation
-  _sub_meet(p, ip1, ip2, cur, l_ind_a, l_ind_b, r_ind_a, r_ind_b, beg, middle);
-  _sub_meet(p, ip1, ip2, cur, l_ind_a, l_ind_b, r_ind_a, r_ind_b, middle, end);
+  _sub_meet(p, ip1, ip2, cur, l_ind_a, l_ind_b, r_ind_a, r_ind_b, new_sublist, beg, middle);
+  _sub_meet(p, ip1, ip2, cur, l_ind_a, l_ind_b, r_ind_a, r_ind_b, new_sublist, middle, end);
 
 
   // II. merge left and right parts
@@ -750,7 +958,6 @@ void Permutation::_sub_meet(
   // 3. merge lists
   int i1 = beg;
   int i2 = middle;
-  int* new_sublist = new int[end - beg];
 
   for (int i = 0; i < end - beg; ++i) {
     if (i1 == middle) {
@@ -773,8 +980,6 @@ void Permutation::_sub_meet(
   for (int i = 0; i < end - beg; ++i) {
     cur.values_[beg + i] = new_sublist[i];
   }
-
-  delete[] new_sublist;
 }
 
 Permutation Permutation::tinyFlip(int sh) const {
@@ -816,8 +1021,47 @@ Permutation Permutation::flip() const {
   return result;
 }
 
+namespace {
+
+//! Sorts [begin, end) and returns the number of inversions in it, buffer must have the same size.
+size_t countInversions(int* begin, int* end, int* buffer) {
+  const auto size = end - begin;
+
+  if (size < 2) {
+    return 0;
+  }
+
+  const auto middle = begin + size / 2;
+  auto result = countInversions(begin, middle, buffer) + countInversions(middle, end, buffer);
+
+  auto left = begin;
+  auto right = middle;
+  auto out = buffer;
+
+  while (left != middle && right != end) {
+    if (*right < *left) {
+      // *right forms inversions with all the remaining elements of the left part
+      result += middle - left;
+      *out++ = *right++;
+    } else {
+      *out++ = *left++;
+    }
+  }
+
+  out = std::copy(left, middle, out);
+  std::copy(right, end, out);
+  std::copy(buffer, buffer + size, begin);
+
+  return result;
+}
+} // namespace
+
 size_t Permutation::length() const {
-  return geodesic().size();
+  // the length of a geodesic is the number of inversions
+  auto values = values_;
+  std::vector<int> buffer(values.size());
+
+  return countInversions(values.data(), values.data() + values.size(), buffer.data());
 }
 
 Permutation Permutation::increaseSize(size_t n) const {
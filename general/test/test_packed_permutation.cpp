@@ -0,0 +1,78 @@
+#include "gtest/gtest.h"
+
+#include "PackedPermutation.h"
+
+namespace crag {
+namespace {
+
+TEST(PackedPermutation, Constructor) {
+  EXPECT_EQ(0, PackedPermutation().size());
+  EXPECT_EQ(PackedPermutation({0, 1, 2}), PackedPermutation(3));
+  EXPECT_EQ(PackedPermutation({2, 0, 1}), PackedPermutation(Permutation({2, 0, 1})));
+  EXPECT_EQ(Permutation({2, 0, 1}), PackedPermutation({2, 0, 1}).toPermutation());
+
+  EXPECT_THROW({ PackedPermutation(33); }, std::invalid_argument);
+  EXPECT_THROW({ PackedPermutation({0, 0, 1}); }, std::invalid_argument);
+  EXPECT_THROW({ PackedPermutation({0, 1, 3}); }, std::invalid_argument);
+}
+
+TEST(PackedPermutation, Multiplication) {
+  EXPECT_EQ(PackedPermutation(5), PackedPermutation() * PackedPermutation(5));
+  EXPECT_EQ(PackedPermutation({0, 1, 3, 2}), PackedPermutation({1, 0, 3, 2}) * PackedPermutation({1, 0}));
+  EXPECT_EQ(PackedPermutation({0, 1, 4, 3, 2}), PackedPermutation({1, 0}) * PackedPermutation({1, 0, 4, 3, 2}));
+
+  for (const auto n : {5, 16, 17, 31, 32}) {
+    for (int i = 0; i < 20; ++i) {
+      const auto p = Permutation::random(n);
+      const auto q = Permutation::random(n);
+
+      EXPECT_EQ(p * q, (PackedPermutation(p) * PackedPermutation(q)).toPermutation());
+      EXPECT_EQ(-p, PackedPermutation(p).inverse().toPermutation());
+      EXPECT_EQ(p.flip(), PackedPermutation(p).flip().toPermutation());
+    }
+  }
+}
+
+TEST(PackedPermutation, Geodesic) {
+  EXPECT_EQ(0, PackedPermutation(32).length());
+  EXPECT_EQ(32 * 31 / 2, PackedPermutation::getHalfTwistPermutation(32).length());
+
+  for (int i = 0; i < 50; ++i) {
+    const auto p = Permutation::random(32);
+
+    EXPECT_EQ(p.length(), PackedPermutation(p).length());
+    EXPECT_EQ(p.geodesic(), PackedPermutation(p).geodesic());
+    EXPECT_EQ(p.geodesicWord(), PackedPermutation(p).geodesicWord());
+  }
+}
+
+TEST(PackedPermutation, Lattice) {
+  for (const auto n : {1, 4, 11, 32}) {
+    for (int i = 0; i < 20; ++i) {
+      const auto p = Permutation::random(n);
+      const auto q = Permutation::random(n);
+      const PackedPermutation pp(p);
+      const PackedPermutation pq(q);
+
+      EXPECT_EQ(p.RightGCD(q), pp.RightGCD(pq).toPermutation());
+      EXPECT_EQ(p.LeftGCD(q), pp.LeftGCD(pq).toPermutation());
+      EXPECT_EQ(p.RightLCM(q), pp.RightLCM(pq).toPermutation());
+      EXPECT_EQ(p.LeftLCM(q), pp.LeftLCM(pq).toPermutation());
+    }
+  }
+}
+
+TEST(PackedPermutation, Comparison) {
+  const PackedPermutation p({1, 2, 0});
+
+  EXPECT_TRUE(PackedPermutation(3).isTrivial());
+  EXPECT_FALSE(p.isTrivial());
+  EXPECT_LT(PackedPermutation(2), p);
+  EXPECT_LT(PackedPermutation(3), p);
+  EXPECT_NE(PackedPermutation(2), PackedPermutation(3));
+  EXPECT_EQ(p.hash(), PackedPermutation({1, 2, 0}).hash());
+  EXPECT_NE(p.hash(), PackedPermutation({2, 0, 1}).hash());
+}
+
+} // namespace
+} // namespace crag
@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
 
+#include <unordered_set>
+
 #include "Permutation.h"
 
 namespace {
@@ -92,6 +94,77 @@ TEST(Permutation, Geodesic) {
   EXPECT_EQ(std::vector<int>({2, 1, 0, 1, 2}), Permutation({3, 1, 2, 0}).geodesic());
 }
 
+TEST(Permutation, Length) {
+  EXPECT_EQ(0, Permutation().length());
+  EXPECT_EQ(0, Permutation(5).length());
+  EXPECT_EQ(5, Permutation({3, 1, 2, 0}).length());
+  EXPECT_EQ(45, Permutation::getHalfTwistPermutation(10).length());
+
+  for (int i = 0; i < 100; ++i) {
+    const auto p = Permutation::random(40);
+    EXPECT_EQ(p.geodesic().size(), p.length());
+  }
+}
+
+TEST(Permutation, StartingAndFinishingSets) {
+  for (const size_t n : {1, 2, 5, 9, 40, 64}) {
+    for (int attempt = 0; attempt < 20; ++attempt) {
+      const auto p = Permutation::random(n);
+      const auto starting = p.startingSet();
+      const auto finishing = p.finishingSet();
+
+      for (size_t i = 0; i + 1 < n; ++i) {
+        Permutation x(n);
+        x.change(i, i + 1);
+
+        EXPECT_EQ(p.LeftGCD(x) == x, ((starting >> i) & 1) != 0);
+        EXPECT_EQ(p.RightGCD(x) == x, ((finishing >> i) & 1) != 0);
+      }
+
+      EXPECT_EQ(0, starting >> (n > 0 ? n - 1 : 0));
+      EXPECT_EQ(0, finishing >> (n > 0 ? n - 1 : 0));
+    }
+  }
+}
+
+TEST(Permutation, RightGCD) {
+  // permutations of size at most 6 use the table of meets, the ones of size at most 64 use bitmasks,
+  // the larger ones are merged (so the last check compares the bitmask meet of size 64 to the merged one)
+  for (const size_t n : {2, 4, 6, 7, 20, 63, 64}) {
+    const auto delta = Permutation::getHalfTwistPermutation(n);
+
+    for (int attempt = 0; attempt < 50; ++attempt) {
+      const auto p1 = Permutation::random(n);
+      const auto p2 = Permutation::random(n);
+      const auto meet = p1.RightGCD(p2);
+
+      EXPECT_EQ(meet, p2.RightGCD(p1));
+      EXPECT_EQ(p1, p1.RightGCD(p1));
+      EXPECT_EQ(p1, p1.RightGCD(delta));
+      EXPECT_TRUE(p1.RightGCD(Permutation(n)).isTrivial());
+      EXPECT_EQ(meet.increaseSize(n + 3), p1.increaseSize(n + 3).RightGCD(p2.increaseSize(n + 3)));
+    }
+  }
+}
+
+TEST(Permutation, Hash) {
+  std::unordered_set<size_t> hashes;
+
+  for (const size_t n : {1, 20, 30}) {
+    for (int i = 0; i < 100; ++i) {
+      const auto p = Permutation::random(n);
+
+      EXPECT_EQ(p.hash(), Permutation(p.getVector()).hash());
+      EXPECT_EQ(p.hash(), std::hash<Permutation>()(p));
+      hashes.insert(p.hash());
+    }
+  }
+
+  // 1 + 100 + 100 different permutations (up to unlikely coincidences in the random ones)
+  EXPECT_LE(195, hashes.size());
+  EXPECT_NE(Permutation(2).hash(), Permutation(3).hash());
+}
+
 TEST(Permutation, Difference) {
   EXPECT_EQ(std::numeric_limits<size_t>::max(), Permutation(2).difference(Permutation(3)));
   EXPECT_EQ(0, Permutation(3).difference(Permutation(3)));